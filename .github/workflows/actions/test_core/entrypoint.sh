@@ -4,7 +4,8 @@ runTest() {
 
     cd src/core
 
-    LUA_VERSION=$1 cmake -DCMAKE_BUILD_TYPE=Debug .
+    # The optional second argument is passed through to cmake
+    LUA_VERSION=$1 cmake -DCMAKE_BUILD_TYPE=Debug $2 .
 
     if [ 0 -ne $? ]; then
         exit 1
@@ -48,3 +49,4 @@ runTest() {
 runTest 5.1
 runTest 5.2
 runTest 5.3
+runTest jit -DENABLE_LUAJIT_FFI=ON
@@ -192,7 +192,7 @@ namespace trogdor {
 
                // TODO: this check should be made inside Being (we'd have an
                // exception to catch)
-               if (!weapon->isTagSet(entity::Object::WeaponTag)) {
+               if (!weapon->isTagSet(entity::TAG_SLOT_WEAPON)) {
                   player->out("display") << "The " << command.getIndirectObject() << " isn't a weapon!" << std::endl;
                   return;
                }
@@ -26,7 +26,7 @@ namespace trogdor {
    ) {
 
       std::queue<std::string> invLines;
-      int playerInvMaxWeight = player->getProperty<int>(entity::Being::InvMaxWeightProperty);
+      int playerInvMaxWeight = player->getProperty<int>(entity::PROPERTY_SLOT_INV_MAX_WEIGHT);
 
       // percentage of available space used
       double totalPercent = 0.0;
@@ -43,8 +43,8 @@ namespace trogdor {
 
          if (const auto &obj = objPtr.second.lock()) {
 
-            std::string line = obj->getProperty<std::string>(entity::Entity::TitleProperty);
-            int objectWeight = obj->getProperty<int>(entity::Object::WeightProperty);
+            std::string line = obj->getPropertyRef<std::string>(entity::PROPERTY_SLOT_TITLE);
+            int objectWeight = obj->getProperty<int>(entity::PROPERTY_SLOT_WEIGHT);
 
             if (playerInvMaxWeight > 0) {
 
@@ -104,7 +104,7 @@ namespace trogdor {
 
             else if (items.size() > 1) {
 
-               entity::Entity::clarifyEntity<entity::ThingList>(items, player);
+               entity::Entity::clarifyEntity<std::list<entity::Thing *>>(items, player);
                lookupThingByName[player] = playerShared;
 
                player->setInputInterceptor(std::make_unique<std::function<bool(std::string)>>(
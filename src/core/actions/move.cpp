@@ -35,19 +35,16 @@ namespace trogdor {
    ) {
 
       auto &vocab = command.getVocabulary();
-      std::string direction = "";
 
       if (auto location = player->getLocation().lock()) {
 
          // direction is implied in the verb
-         if (vocab.isDirection(command.getVerb()) || vocab.isDirectionSynonym(command.getVerb())) {
-            direction = vocab.getDirection(command.getVerb());
-         }
+         std::optional<size_t> directionId = vocab.getDirectionId(command.getVerb());
 
          // direction was supplied as the direct or indirect object of another
          // verb like "move" or "go"
-         if (0 == direction.length()) {
-            direction = vocab.getDirection(command.getDirectObject().length() > 0 ?
+         if (!directionId) {
+            directionId = vocab.getDirectionId(command.getDirectObject().length() > 0 ?
                command.getDirectObject() : command.getIndirectObject());
          }
 
@@ -58,7 +55,8 @@ namespace trogdor {
             return;
          }
 
-         auto next = (std::static_pointer_cast<entity::Room>(location))->getConnection(direction);
+         auto next = directionId ?
+            (std::static_pointer_cast<entity::Room>(location))->getConnection(*directionId) : nullptr;
 
          if (nullptr == next) {
             player->out("display") << "You can't go that way." << std::endl;
@@ -66,8 +64,10 @@ namespace trogdor {
             return;
          }
 
-         std::string enterMessage = next->getMessage("enter" + direction);
-         std::string goMessage = location->getMessage("go" + direction);
+         const std::string &direction = vocab.getDirectionName(*directionId);
+
+         std::string_view enterMessage = next->getMessage("enter" + direction);
+         std::string_view goMessage = location->getMessage("go" + direction);
 
          if (goMessage.length() > 0) {
             player->out("display") << goMessage << std::endl << std::endl;
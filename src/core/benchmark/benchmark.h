@@ -0,0 +1,86 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace trogdor::benchmark {
+
+
+   // A single benchmark. The function prints its own measurements and returns
+   // false if any of the benchmark's sanity checks (for example, that a fast
+   // path gives the same answers as the slow one it replaces) fail.
+   struct Benchmark {
+      std::string name;
+      std::function<bool()> run;
+   };
+
+   /*
+      Returns every registered benchmark.
+
+      Input:
+         (none)
+
+      Output:
+         std::vector<Benchmark> &
+   */
+   inline std::vector<Benchmark> &getBenchmarks() {
+
+      static std::vector<Benchmark> benchmarks;
+      return benchmarks;
+   }
+
+   // Declaring a static instance of this registers a benchmark, in the same
+   // spirit as doctest's TEST_CASE.
+   struct Registration {
+
+      inline Registration(std::string name, std::function<bool()> run) {
+
+         getBenchmarks().push_back({name, run});
+      }
+   };
+
+   /*
+      Calls f the given number of times and returns the average time per call
+      in nanoseconds.
+
+      Template arguments:
+         Callable type (deduced)
+
+      Input:
+         Number of iterations (size_t)
+         Function to time (void())
+
+      Output:
+         Nanoseconds per call (double)
+   */
+   template <typename F> inline double measure(size_t iterations, F &&f) {
+
+      auto start = std::chrono::steady_clock::now();
+
+      for (size_t i = 0; i < iterations; i++) {
+         f();
+      }
+
+      std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+      return elapsed.count() / static_cast<double>(iterations ? iterations : 1);
+   }
+
+   /*
+      Prints a single measurement.
+
+      Input:
+         Label (const std::string &)
+         Nanoseconds per operation (double)
+
+      Output:
+         (none)
+   */
+   void report(const std::string &label, double nsPerOp);
+}
+
+
+#endif
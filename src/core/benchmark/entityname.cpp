@@ -0,0 +1,102 @@
+#include <regex>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <trogdor/entities/entity.h>
+
+#include "benchmark.h"
+
+using namespace trogdor;
+
+
+// The regex-based check that Entity::isNameValid() used to do, kept here as the
+// reference the hand-written version is compared against
+static bool isNameValidRegex(const std::string &name) {
+
+   for (const char **reserved = entity::reservedNames; *reserved != nullptr; reserved++) {
+      if (0 == name.compare(*reserved)) {
+         return false;
+      }
+   }
+
+   return std::regex_match(name, std::regex(entity::validEntityNameRegex));
+}
+
+/******************************************************************************/
+
+// Builds a mix of valid, invalid and reserved names of various lengths
+static std::vector<std::string> makeCorpus() {
+
+   std::vector<std::string> corpus;
+
+   // Every single byte, including the ones that are never valid
+   for (int c = 0; c < 256; c++) {
+      corpus.push_back(std::string(1, static_cast<char>(c)));
+   }
+
+   for (const char **reserved = entity::reservedNames; *reserved != nullptr; reserved++) {
+      corpus.push_back(*reserved);
+   }
+
+   corpus.push_back("");
+   corpus.push_back(" ");
+   corpus.push_back("-_-");
+   corpus.push_back("rusty sword");
+   corpus.push_back("rusty  sword");
+   corpus.push_back("Trogdor-the_Burninator 2");
+   corpus.push_back("sword!");
+   corpus.push_back("caf\xc3\xa9");
+   corpus.push_back(std::string("nul\0byte", 8));
+
+   // Typical generated names (what spawning or deserializing lots of
+   // Entities looks like), some of them with an invalid character tacked on
+   for (size_t i = 0; i < 1000; i++) {
+
+      std::string name = "goblin_" + std::to_string(i);
+
+      if (i % 7 == 0) {
+         name += ".";
+      }
+
+      corpus.push_back(name);
+   }
+
+   return corpus;
+}
+
+/******************************************************************************/
+
+static benchmark::Registration entityName("Entity::isNameValid()", [] {
+
+   std::vector<std::string> corpus = makeCorpus();
+   size_t mismatches = 0;
+
+   // Both versions have to agree on every name before timing means anything
+   for (const auto &name: corpus) {
+      if (entity::Entity::isNameValid(name) != isNameValidRegex(name)) {
+         std::cout << "   mismatch: \"" << name << '"' << std::endl;
+         mismatches++;
+      }
+   }
+
+   std::cout << "   " << corpus.size() << " names compared, " << mismatches << " mismatches" << std::endl;
+
+   size_t nValid = 0;
+
+   double regexTime = benchmark::measure(corpus.size() * 10, [&, i = size_t(0)] () mutable {
+      nValid += isNameValidRegex(corpus[i++ % corpus.size()]);
+   });
+
+   double tableTime = benchmark::measure(corpus.size() * 10, [&, i = size_t(0)] () mutable {
+      nValid += entity::Entity::isNameValid(corpus[i++ % corpus.size()]);
+   });
+
+   benchmark::report("std::regex, compiled per call", regexTime);
+   benchmark::report("character table", tableTime);
+
+   // Keeps the compiler from discarding the calls
+   std::cout << "   (" << nValid << " valid)" << std::endl;
+
+   return 0 == mismatches;
+});
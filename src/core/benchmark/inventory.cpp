@@ -0,0 +1,126 @@
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <trogdor/game.h>
+#include <trogdor/entities/object.h>
+#include <trogdor/entities/player.h>
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+#include "benchmark.h"
+
+using namespace trogdor;
+
+
+static constexpr size_t NUM_ITEMS = 500;
+
+/******************************************************************************/
+
+// What the inventory's weight used to cost: a walk over every item
+static int sumWeights(const entity::Being &being) {
+
+   int weight = 0;
+
+   for (const auto &item: being.getInventoryObjects()) {
+      if (const auto &object = item.second.lock()) {
+         weight += object->getProperty<int>(entity::PROPERTY_SLOT_WEIGHT);
+      }
+   }
+
+   return weight;
+}
+
+/******************************************************************************/
+
+static benchmark::Registration inventory("Being::insertIntoInventory() (full pockets)", [] {
+
+   Game game(std::make_unique<NullErr>());
+
+   auto player = std::make_shared<entity::Player>(
+      &game, "player", std::make_unique<NullOut>(), std::make_unique<NullErr>()
+   );
+
+   auto makeObject = [&](std::string name, int weight) {
+
+      auto object = std::make_shared<entity::Object>(
+         &game, name, std::make_unique<NullOut>(), std::make_unique<NullErr>()
+      );
+
+      object->setProperty(entity::PROPERTY_SLOT_WEIGHT, weight);
+      object->addAlias("junk");
+
+      return object;
+   };
+
+   std::vector<std::shared_ptr<entity::Object>> items;
+
+   player->setProperty(entity::PROPERTY_SLOT_INV_MAX_WEIGHT, static_cast<int>(NUM_ITEMS * 10));
+
+   for (size_t i = 0; i < NUM_ITEMS; i++) {
+      items.push_back(makeObject("item_" + std::to_string(i), 1 + i % 7));
+      player->insertIntoInventory(items.back());
+   }
+
+   size_t mismatches = 0;
+   auto check = [&] {
+      if (sumWeights(*player) != player->getInventoryCurWeight()) {
+         mismatches++;
+      }
+   };
+
+   check();
+
+   // Items change weight while they're being carried
+   for (size_t i = 0; i < NUM_ITEMS; i += 3) {
+      items[i]->setProperty(entity::PROPERTY_SLOT_WEIGHT, static_cast<int>(i % 11));
+   }
+
+   check();
+
+   for (size_t i = 0; i < NUM_ITEMS; i += 5) {
+      player->removeFromInventory(items[i]);
+   }
+
+   check();
+
+   for (size_t i = 0; i < NUM_ITEMS; i += 5) {
+      player->insertIntoInventory(items[i]);
+   }
+
+   check();
+
+   if (NUM_ITEMS != player->getInventoryObjects().size() ||
+   NUM_ITEMS != player->getInventoryObjectsByName("junk").size()) {
+      mismatches++;
+   }
+
+   std::cout << "   " << player->getInventoryObjects().size() << " items carried, "
+      << mismatches << " mismatches" << std::endl;
+
+   auto extra = makeObject("extra", 1);
+   int total = 0;
+
+   double sumTime = benchmark::measure(10000, [&] {
+      total += sumWeights(*player);
+   });
+
+   double cachedTime = benchmark::measure(10000, [&] {
+      total += player->getInventoryCurWeight();
+   });
+
+   double pickupTime = benchmark::measure(10000, [&] {
+      player->insertIntoInventory(extra);
+      player->removeFromInventory(extra);
+   });
+
+   benchmark::report("weight by walking the inventory", sumTime);
+   benchmark::report("cached weight", cachedTime);
+   benchmark::report("pick up and drop one more item", pickupTime);
+
+   // Keeps the compiler from discarding the calls
+   std::cout << "   (" << total << " total weight)" << std::endl;
+
+   return 0 == mismatches;
+});
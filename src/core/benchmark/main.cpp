@@ -0,0 +1,45 @@
+#include <cstdio>
+#include <iostream>
+
+#include "benchmark.h"
+
+namespace trogdor::benchmark {
+
+
+   void report(const std::string &label, double nsPerOp) {
+
+      std::printf("   %-48s %12.1f ns/op\n", label.c_str(), nsPerOp);
+   }
+}
+
+/******************************************************************************/
+
+// Runs every benchmark whose name contains one of the arguments, or all of them
+// if no arguments are given. Exits with a non-zero status if any of them fail
+// their sanity checks.
+int main(int argc, char **argv) {
+
+   int status = 0;
+
+   for (const auto &benchmark: trogdor::benchmark::getBenchmarks()) {
+
+      bool selected = argc < 2;
+
+      for (int i = 1; i < argc && !selected; i++) {
+         selected = std::string::npos != benchmark.name.find(argv[i]);
+      }
+
+      if (!selected) {
+         continue;
+      }
+
+      std::cout << benchmark.name << ':' << std::endl;
+
+      if (!benchmark.run()) {
+         std::cout << "   FAILED" << std::endl;
+         status = 1;
+      }
+   }
+
+   return status;
+}
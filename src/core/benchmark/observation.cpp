@@ -0,0 +1,250 @@
+#include <set>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <unordered_map>
+
+#include <trogdor/game.h>
+#include <trogdor/entities/room.h>
+#include <trogdor/entities/object.h>
+#include <trogdor/entities/player.h>
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+#include "benchmark.h"
+
+using namespace trogdor;
+
+
+static constexpr size_t NUM_ROOMS = 100;
+static constexpr size_t OBJECTS_PER_ROOM = 3;
+static constexpr size_t NUM_SESSIONS = 40;
+static constexpr size_t PLAYERS_PER_SESSION = 50;
+static constexpr size_t ROOMS_PER_VISIT = 10;
+
+// Bytes currently allocated by the old representation's sets
+static size_t legacyBytes = 0;
+
+template <typename T> struct CountingAllocator {
+
+   typedef T value_type;
+
+   CountingAllocator() = default;
+   template <typename U> CountingAllocator(const CountingAllocator<U> &) {}
+
+   T *allocate(size_t n) {
+
+      legacyBytes += n * sizeof(T);
+      return std::allocator<T>().allocate(n);
+   }
+
+   void deallocate(T *p, size_t n) {
+
+      legacyBytes -= n * sizeof(T);
+      std::allocator<T>().deallocate(p, n);
+   }
+
+   template <typename U> bool operator==(const CountingAllocator<U> &) const {return true;}
+   template <typename U> bool operator!=(const CountingAllocator<U> &) const {return false;}
+};
+
+// What Tangible used to keep: two sets of weak_ptrs that only ever grew
+typedef std::set<
+   std::weak_ptr<entity::Being>,
+   std::owner_less<std::weak_ptr<entity::Being>>,
+   CountingAllocator<std::weak_ptr<entity::Being>>
+> LegacySet;
+
+struct LegacyObservations {
+   LegacySet glancedBy;
+   LegacySet observedBy;
+};
+
+/******************************************************************************/
+
+static benchmark::Registration observation("Tangible::observedBy() (soak)", [] {
+
+   std::mt19937 generator(48);
+   Game game(std::make_unique<NullErr>());
+
+   std::vector<std::shared_ptr<entity::Room>> rooms;
+   std::vector<std::shared_ptr<entity::Tangible>> tangibles;
+   std::unordered_map<entity::Tangible *, LegacyObservations> legacy;
+
+   for (size_t i = 0; i < NUM_ROOMS; i++) {
+
+      std::string name = i ? "room_" + std::to_string(i) : "start";
+      auto room = std::make_shared<entity::Room>(
+         &game, name, std::make_unique<NullOut>(), std::make_unique<NullErr>()
+      );
+
+      game.insertEntity(name, room);
+      rooms.push_back(room);
+      tangibles.push_back(room);
+
+      for (size_t j = 0; j < OBJECTS_PER_ROOM; j++) {
+
+         std::string objectName = "object_" + std::to_string(i) + "_" + std::to_string(j);
+         auto object = std::make_shared<entity::Object>(
+            &game, objectName, std::make_unique<NullOut>(), std::make_unique<NullErr>()
+         );
+
+         game.insertEntity(objectName, object);
+         room->insertThing(object);
+         tangibles.push_back(object);
+      }
+   }
+
+   // Looked up once so that timing the old version doesn't include hashing
+   std::vector<LegacyObservations *> legacyByTangible;
+
+   for (const auto &tangible: tangibles) {
+      legacyByTangible.push_back(&legacy[tangible.get()]);
+   }
+
+   std::uniform_int_distribution<size_t> roomDist(0, rooms.size() - 1);
+
+   // Mirrors what Room::observe() records: the Room is observed and every
+   // Object in it is glanced at
+   auto recordLegacyVisit = [&](const std::shared_ptr<entity::Player> &player, entity::Room *room) {
+
+      legacy[room].observedBy.insert(player);
+
+      for (const auto &thing: room->getThings()) {
+         if (thing->isType(entity::ENTITY_OBJECT)) {
+            legacy[thing.get()].glancedBy.insert(player);
+         }
+      }
+   };
+
+   size_t mismatches = 0;
+   size_t peakBytes = 0;
+   size_t peakLegacyBytes = 0;
+   double compactTime = 0;
+   double legacyTime = 0;
+   size_t nObserved = 0;
+
+   for (size_t session = 0; session < NUM_SESSIONS; session++) {
+
+      std::vector<std::shared_ptr<entity::Player>> players;
+
+      for (size_t i = 0; i < PLAYERS_PER_SESSION; i++) {
+
+         auto player = std::make_shared<entity::Player>(
+            &game,
+            "player_" + std::to_string(session) + "_" + std::to_string(i),
+            std::make_unique<NullOut>(),
+            std::make_unique<NullErr>()
+         );
+
+         game.insertPlayer(player);
+         recordLegacyVisit(player, rooms[0].get());
+         players.push_back(player);
+      }
+
+      // Each Player wanders through a few Rooms, looking around and picking
+      // up on whatever catches their eye
+      for (const auto &player: players) {
+         for (size_t i = 0; i < ROOMS_PER_VISIT; i++) {
+
+            auto &room = rooms[roomDist(generator)];
+
+            player->getLocation().lock()->removeThing(player);
+            room->insertThing(player);
+            room->observe(player, false);
+            recordLegacyVisit(player, room.get());
+
+            auto object = room->getThings()[0];
+
+            if (object->isType(entity::ENTITY_OBJECT)) {
+               object->observe(player, false);
+               legacy[object.get()].observedBy.insert(player);
+            }
+         }
+      }
+
+      // While everyone's still here, both versions have to agree on who has
+      // seen what
+      for (const auto &player: players) {
+         for (size_t i = 0; i < tangibles.size(); i++) {
+
+            const std::shared_ptr<entity::Tangible> &tangible = tangibles[i];
+            const LegacyObservations &old = *legacyByTangible[i];
+
+            bool observed = old.observedBy.count(player) > 0;
+            bool glanced = observed || old.glancedBy.count(player) > 0;
+
+            if (observed != tangible->observedBy(player) || glanced != tangible->glancedBy(player)) {
+               mismatches++;
+            }
+         }
+      }
+
+      size_t bytes = 0;
+
+      for (const auto &tangible: tangibles) {
+         bytes += tangible->getObserverMemoryUsage();
+      }
+
+      peakBytes = std::max(peakBytes, bytes);
+      peakLegacyBytes = std::max(peakLegacyBytes, legacyBytes);
+
+      if (NUM_SESSIONS - 1 == session) {
+
+         size_t nLookups = players.size() * tangibles.size();
+
+         compactTime = benchmark::measure(nLookups, [&, i = size_t(0)] () mutable {
+            nObserved += tangibles[i % tangibles.size()]->observedBy(players[(i / tangibles.size()) % players.size()]);
+            i++;
+         });
+
+         legacyTime = benchmark::measure(nLookups, [&, i = size_t(0)] () mutable {
+            nObserved += legacyByTangible[i % tangibles.size()]->observedBy.count(
+               players[(i / tangibles.size()) % players.size()]
+            );
+            i++;
+         });
+      }
+
+      for (const auto &player: players) {
+         game.removePlayer(player->getName());
+      }
+   }
+
+   size_t nObservers = 0;
+   size_t bytes = 0;
+   size_t legacyEntries = 0;
+
+   for (const auto &tangible: tangibles) {
+      nObservers += tangible->getNumObservers();
+      bytes += tangible->getObserverMemoryUsage();
+   }
+
+   for (const auto &entry: legacy) {
+      legacyEntries += entry.second.glancedBy.size() + entry.second.observedBy.size();
+   }
+
+   std::cout << "   " << NUM_SESSIONS << " sessions of " << PLAYERS_PER_SESSION << " players, "
+      << tangibles.size() << " tangibles, " << mismatches << " mismatches" << std::endl;
+
+   std::cout << "   std::set<weak_ptr>: " << legacyEntries << " entries, " << legacyBytes
+      << " bytes after everyone left (peak " << peakLegacyBytes << "), plus "
+      << 2 * sizeof(LegacySet) << " bytes per Tangible" << std::endl;
+
+   std::cout << "   sorted handles:     " << nObservers << " entries, " << bytes
+      << " bytes after everyone left (peak " << peakBytes << "), plus "
+      << sizeof(std::vector<int>) + sizeof(std::mutex) << " bytes per Tangible" << std::endl;
+
+   benchmark::report("std::set<weak_ptr>::count()", legacyTime);
+   benchmark::report("sorted handles", compactTime);
+
+   // Keeps the compiler from discarding the calls
+   std::cout << "   (" << nObserved << " observed)" << std::endl;
+
+   // Departed Players must not leave anything behind
+   return 0 == mismatches && 0 == nObservers;
+});
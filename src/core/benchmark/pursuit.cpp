@@ -0,0 +1,242 @@
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <unordered_map>
+
+#include <trogdor/game.h>
+#include <trogdor/entities/room.h>
+#include <trogdor/entities/player.h>
+#include <trogdor/entities/creature.h>
+#include <trogdor/entities/roomgraph.h>
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+#include "benchmark.h"
+
+using namespace trogdor;
+
+
+static constexpr size_t GRID_WIDTH = 40;
+static constexpr size_t GRID_HEIGHT = 40;
+static constexpr size_t NUM_PLAYERS = 100;
+static constexpr size_t NUM_CREATURES = 1000;
+
+// Result of a search done the old-fashioned way, by walking each Room's
+// connections
+struct NaiveResult {
+   size_t distance = entity::RoomGraph::UNREACHABLE;
+   std::shared_ptr<entity::Room> firstStep;
+};
+
+/******************************************************************************/
+
+// Breadth-first search from a single Room until one that satisfies isGoal is
+// found. This is what each Creature would have to do on its own without flow
+// fields.
+template <typename Goal>
+static NaiveResult naiveSearch(const std::shared_ptr<entity::Room> &from, const Goal &isGoal) {
+
+   NaiveResult result;
+
+   std::unordered_map<entity::Room *, std::shared_ptr<entity::Room>> firstSteps;
+   std::unordered_map<entity::Room *, size_t> distances;
+   std::deque<std::shared_ptr<entity::Room>> queue;
+
+   distances[from.get()] = 0;
+   queue.push_back(from);
+
+   while (!queue.empty()) {
+
+      std::shared_ptr<entity::Room> current = queue.front();
+      queue.pop_front();
+
+      if (isGoal(current.get())) {
+         result.distance = distances[current.get()];
+         result.firstStep = firstSteps[current.get()];
+         break;
+      }
+
+      for (const auto &direction: current->getConnectedDirections()) {
+
+         std::shared_ptr<entity::Room> next = current->getConnection(direction);
+
+         if (next && distances.end() == distances.find(next.get())) {
+            distances[next.get()] = distances[current.get()] + 1;
+            firstSteps[next.get()] = current == from ? next : firstSteps[current.get()];
+            queue.push_back(next);
+         }
+      }
+   }
+
+   return result;
+}
+
+/******************************************************************************/
+
+static benchmark::Registration pursuit("Creature::selectWanderDestination() (pursuit)", [] {
+
+   std::mt19937 generator(47);
+   Game game(std::make_unique<NullErr>());
+
+   // A grid of Rooms connected to their neighbors in every direction
+   std::vector<std::shared_ptr<entity::Room>> rooms;
+
+   for (size_t y = 0; y < GRID_HEIGHT; y++) {
+      for (size_t x = 0; x < GRID_WIDTH; x++) {
+
+         std::string name = x || y ? "room_" + std::to_string(x) + "_" + std::to_string(y) : "start";
+         auto room = std::make_shared<entity::Room>(
+            &game, name, std::make_unique<NullOut>(), std::make_unique<NullErr>()
+         );
+
+         game.insertEntity(name, room);
+         rooms.push_back(room);
+      }
+   }
+
+   for (size_t y = 0; y < GRID_HEIGHT; y++) {
+      for (size_t x = 0; x < GRID_WIDTH; x++) {
+
+         auto &room = rooms[y * GRID_WIDTH + x];
+
+         if (x > 0) {
+            room->setConnection("west", rooms[y * GRID_WIDTH + x - 1]);
+         }
+
+         if (x + 1 < GRID_WIDTH) {
+            room->setConnection("east", rooms[y * GRID_WIDTH + x + 1]);
+         }
+
+         if (y > 0) {
+            room->setConnection("north", rooms[(y - 1) * GRID_WIDTH + x]);
+         }
+
+         if (y + 1 < GRID_HEIGHT) {
+            room->setConnection("south", rooms[(y + 1) * GRID_WIDTH + x]);
+         }
+      }
+   }
+
+   std::uniform_int_distribution<size_t> roomDist(0, rooms.size() - 1);
+
+   auto move = [](const std::shared_ptr<entity::Thing> &thing, const std::shared_ptr<entity::Room> &room) {
+      thing->getLocation().lock()->removeThing(thing);
+      room->insertThing(thing);
+   };
+
+   std::vector<std::shared_ptr<entity::Player>> players;
+   std::vector<std::shared_ptr<entity::Creature>> creatures;
+
+   for (size_t i = 0; i < NUM_PLAYERS; i++) {
+
+      auto player = std::make_shared<entity::Player>(
+         &game, "player_" + std::to_string(i), std::make_unique<NullOut>(), std::make_unique<NullErr>()
+      );
+
+      game.insertPlayer(player);
+      move(player, rooms[roomDist(generator)]);
+      players.push_back(player);
+   }
+
+   for (size_t i = 0; i < NUM_CREATURES; i++) {
+
+      std::string name = "creature_" + std::to_string(i);
+      auto creature = std::make_shared<entity::Creature>(
+         &game, name, std::make_unique<NullOut>(), std::make_unique<NullErr>()
+      );
+
+      creature->setProperty(entity::PROPERTY_SLOT_WANDER_MODE, static_cast<int>(entity::Creature::WANDER_PURSUE));
+      game.insertEntity(name, creature);
+      rooms[roomDist(generator)]->insertThing(creature);
+      creatures.push_back(creature);
+   }
+
+   std::cout << "   " << rooms.size() << " rooms, " << players.size() << " players, "
+      << creatures.size() << " creatures" << std::endl;
+
+   // Every Creature's first step has to lead one step closer to the nearest
+   // Player, as measured by searching the Rooms directly
+   size_t mismatches = 0;
+
+   for (const auto &creature: creatures) {
+
+      auto location = std::static_pointer_cast<entity::Room>(creature->getLocation().lock());
+      std::shared_ptr<entity::Room> destination = creature->selectWanderDestination();
+      std::shared_ptr<entity::Thing> target = creature->getWanderTarget();
+
+      NaiveResult nearest = naiveSearch(location, [](entity::Room *room) {
+         return !room->getPlayers().empty();
+      });
+
+      bool ok = target && nearest.distance == naiveSearch(location, [&](entity::Room *room) {
+         return room == target->getLocation().lock().get();
+      }).distance;
+
+      if (ok && destination) {
+         ok = nearest.distance - 1 == naiveSearch(destination, [&](entity::Room *room) {
+            return room == target->getLocation().lock().get();
+         }).distance;
+      }
+
+      else if (ok) {
+         ok = 0 == nearest.distance;
+      }
+
+      if (!ok) {
+         std::cout << "   mismatch: " << creature->getName() << std::endl;
+         mismatches++;
+      }
+   }
+
+   std::cout << "   " << creatures.size() << " creatures checked, " << mismatches << " mismatches" << std::endl;
+
+   size_t nMoving = 0;
+   entity::RoomGraph &graph = game.getRoomGraph();
+
+   double naiveTime = benchmark::measure(creatures.size(), [&, i = size_t(0)] () mutable {
+
+      auto location = std::static_pointer_cast<entity::Room>(creatures[i++ % creatures.size()]->getLocation().lock());
+
+      nMoving += nullptr != naiveSearch(location, [](entity::Room *room) {
+         return !room->getPlayers().empty();
+      }).firstStep;
+   });
+
+   double cachedTime = benchmark::measure(creatures.size() * 10, [&, i = size_t(0)] () mutable {
+      nMoving += nullptr != creatures[i++ % creatures.size()]->selectWanderDestination();
+   });
+
+   // Every Player moves once per round, so every target's flow field has to be
+   // computed again before the Creatures chasing it can decide where to go
+   size_t rounds = 10;
+   size_t searches = graph.getNumSearches();
+
+   double roundTime = benchmark::measure(rounds, [&] {
+
+      for (const auto &player: players) {
+
+         auto location = std::static_pointer_cast<entity::Room>(player->getLocation().lock());
+         std::uniform_int_distribution<size_t> exitDist(0, location->getNumConnections() - 1);
+
+         move(player, location->getConnectionByIndex(exitDist(generator)));
+      }
+
+      for (const auto &creature: creatures) {
+         nMoving += nullptr != creature->selectWanderDestination();
+      }
+   });
+
+   benchmark::report("naive BFS per creature", naiveTime);
+   benchmark::report("flow field, players standing still", cachedTime);
+   benchmark::report("flow field, every player moves each round", roundTime / creatures.size());
+
+   std::cout << "   " << (graph.getNumSearches() - searches) / rounds << " searches per round" << std::endl;
+
+   // Keeps the compiler from discarding the calls
+   std::cout << "   (" << nMoving << " moves chosen)" << std::endl;
+
+   return 0 == mismatches;
+});
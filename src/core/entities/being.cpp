@@ -14,20 +14,20 @@ namespace trogdor::entity {
 
    // getInventoryObjectsByName() returns a reference to this empty list
    // whenever a name turns up zero results.
-   std::list<std::weak_ptr<Object>> Being::emptyObjectList;
+   std::vector<std::weak_ptr<Object>> Being::emptyObjectList;
 
    /***************************************************************************/
 
    void Being::setPropertyValiators() {
 
-      setPropertyValidator(HealthProperty, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
-      setPropertyValidator(MaxHealthProperty, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
-      setPropertyValidator(WoundRateProperty, [&](PropertyValue v) -> int {return isPropertyValueDouble(v);});
-      setPropertyValidator(DamageBareHandsProperty, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
-      setPropertyValidator(RespawnEnabledProperty, [&](PropertyValue v) -> int {return isPropertyValueBool(v);});
-      setPropertyValidator(RespawnIntervalProperty, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
-      setPropertyValidator(RespawnLivesProperty, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
-      setPropertyValidator(InvMaxWeightProperty, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
+      setPropertyValidator(PROPERTY_SLOT_HEALTH, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
+      setPropertyValidator(PROPERTY_SLOT_MAX_HEALTH, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
+      setPropertyValidator(PROPERTY_SLOT_WOUND_RATE, [&](PropertyValue v) -> int {return isPropertyValueDouble(v);});
+      setPropertyValidator(PROPERTY_SLOT_DAMAGE_BARE_HANDS, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
+      setPropertyValidator(PROPERTY_SLOT_RESPAWN_ENABLED, [&](PropertyValue v) -> int {return isPropertyValueBool(v);});
+      setPropertyValidator(PROPERTY_SLOT_RESPAWN_INTERVAL, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
+      setPropertyValidator(PROPERTY_SLOT_RESPAWN_LIVES, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
+      setPropertyValidator(PROPERTY_SLOT_INV_MAX_WEIGHT, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
    }
 
    /***************************************************************************/
@@ -46,12 +46,31 @@ namespace trogdor::entity {
          }
 
          else if (0 == std::get<1>(args).compare(MaxHealthProperty)) {
-            dynamic_cast<Being *>(std::get<0>(args))->setProperty(HealthProperty, std::get<2>(args));
+            dynamic_cast<Being *>(std::get<0>(args))->setProperty(PROPERTY_SLOT_HEALTH, std::get<2>(args));
             return true;
          }
 
          return false;
       }));
+
+      // Keeps the inventory's total weight up to date when an Object that's
+      // being carried is given a new weight. The owner is looked up through
+      // the Object rather than captured, since the Object can outlive it.
+      updateObjectWeight = std::make_shared<EntityCallback>([](std::any data) -> bool {
+
+         auto &args = std::any_cast<std::tuple<Entity *, std::string, PropertyValue> &>(data);
+
+         if (0 == std::get<1>(args).compare(Object::WeightProperty)) {
+
+            Object *object = static_cast<Object *>(std::get<0>(args));
+
+            if (std::shared_ptr<Being> owner = object->getOwner().lock()) {
+               owner->updateInventoryWeight(object);
+            }
+         }
+
+         return false;
+      });
    }
 
    /**************************************************************************/
@@ -61,26 +80,26 @@ namespace trogdor::entity {
       std::string n,
       std::unique_ptr<Trogout> o,
       std::unique_ptr<Trogerr> e
-   ): Thing(g, n, std::move(o), std::move(e)), inventory({{}, {{}}}) {
+   ): Thing(g, n, std::move(o), std::move(e)), inventory() {
 
       setAttribute("strength", DEFAULT_ATTRIBUTE_STRENGTH);
       setAttribute("dexterity", DEFAULT_ATTRIBUTE_DEXTERITY);
       setAttribute("intelligence", DEFAULT_ATTRIBUTE_INTELLIGENCE);
       setAttributesInitialTotal();
 
-      setProperty(HealthProperty, static_cast<int>(0));
-      setProperty(MaxHealthProperty, DEFAULT_MAX_HEALTH);
-      setProperty(WoundRateProperty, DEFAULT_WOUND_RATE);
-      setProperty(DamageBareHandsProperty, DEFAULT_DAMAGE_BARE_HANDS);
-      setProperty(RespawnEnabledProperty, DEFAULT_RESPAWN_ENABLED);
-      setProperty(RespawnIntervalProperty, DEFAULT_RESPAWN_INTERVAL);
-      setProperty(RespawnLivesProperty, DEFAULT_RESPAWN_LIVES);
-      setProperty(InvMaxWeightProperty, DEFAULT_INVENTORY_WEIGHT);
+      setProperty(PROPERTY_SLOT_HEALTH, static_cast<int>(0));
+      setProperty(PROPERTY_SLOT_MAX_HEALTH, DEFAULT_MAX_HEALTH);
+      setProperty(PROPERTY_SLOT_WOUND_RATE, DEFAULT_WOUND_RATE);
+      setProperty(PROPERTY_SLOT_DAMAGE_BARE_HANDS, DEFAULT_DAMAGE_BARE_HANDS);
+      setProperty(PROPERTY_SLOT_RESPAWN_ENABLED, DEFAULT_RESPAWN_ENABLED);
+      setProperty(PROPERTY_SLOT_RESPAWN_INTERVAL, DEFAULT_RESPAWN_INTERVAL);
+      setProperty(PROPERTY_SLOT_RESPAWN_LIVES, DEFAULT_RESPAWN_LIVES);
+      setProperty(PROPERTY_SLOT_INV_MAX_WEIGHT, DEFAULT_INVENTORY_WEIGHT);
 
       setPropertyValiators();
       setPropertyCallbacks();
 
-      types.push_back(ENTITY_BEING);
+      setType(ENTITY_BEING);
 
       if (DEFAULT_ATTACKABLE) {
          setTag(AttackableTag);
@@ -90,7 +109,7 @@ namespace trogdor::entity {
    /***************************************************************************/
 
    Being::Being(const Being &b, std::string n): Thing(b, n),
-   inventory({{}, {{}}}) {
+   inventory() {
 
       attributes.values = b.attributes.values;
       attributes.initialTotal = b.attributes.initialTotal;
@@ -105,7 +124,7 @@ namespace trogdor::entity {
       const serial::Serializable &data,
       std::unique_ptr<Trogout> o,
       std::unique_ptr<Trogerr> e
-   ): Thing(g, data, std::move(o), std::move(e)), inventory({{}, {{}}}) {
+   ): Thing(g, data, std::move(o), std::move(e)), inventory() {
 
       std::shared_ptr<serial::Serializable> serializedAttributes =
             std::get<std::shared_ptr<serial::Serializable>>(*data.get("attributes"));
@@ -162,7 +181,7 @@ namespace trogdor::entity {
       setPropertyValiators();
       setPropertyCallbacks();
 
-      types.push_back(ENTITY_BEING);
+      setType(ENTITY_BEING);
    }
 
    /***************************************************************************/
@@ -205,7 +224,7 @@ namespace trogdor::entity {
 
          if (!isAlive()) {
 
-            std::string descDead = getMessage("description_dead");
+            std::string_view descDead = getMessage("description_dead");
 
             if (descDead.length() > 0) {
                observer->out("display") << descDead << std::endl;
@@ -231,9 +250,9 @@ namespace trogdor::entity {
          if (!isAlive()) {
 
             observer->out("display") << "You see the corpse of " <<
-               getProperty<std::string>(TitleProperty) << '.';
+               getPropertyRef<std::string>(PROPERTY_SLOT_TITLE) << '.';
 
-            std::string descDead = getMessage("descshort_dead");
+            std::string_view descDead = getMessage("descshort_dead");
 
             if (descDead.length() > 0) {
                observer->out("display") << ' ' << descDead;
@@ -250,35 +269,105 @@ namespace trogdor::entity {
 
    /***************************************************************************/
 
+   void Being::addObservedTangible(EntityHandle tangible) {
+
+      if (!tangible) {
+         return;
+      }
+
+      std::lock_guard<std::mutex> lock(observedTangiblesMutex);
+
+      auto i = std::lower_bound(
+         observedTangibles.begin(),
+         observedTangibles.end(),
+         tangible.index,
+         [](const EntityHandle &handle, uint32_t index) {
+            return handle.index < index;
+         }
+      );
+
+      if (observedTangibles.end() == i || i->index != tangible.index) {
+         observedTangibles.insert(i, tangible);
+      }
+
+      // Whatever used to be in this slot has left the game, so we just
+      // replace it
+      else {
+         *i = tangible;
+      }
+   }
+
+   /***************************************************************************/
+
+   std::vector<EntityHandle> Being::takeObservedTangibles() {
+
+      std::vector<EntityHandle> tangibles;
+      std::lock_guard<std::mutex> lock(observedTangiblesMutex);
+
+      tangibles.swap(observedTangibles);
+      return tangibles;
+   }
+
+   /***************************************************************************/
+
+   size_t Being::getNumObservedTangibles() {
+
+      std::lock_guard<std::mutex> lock(observedTangiblesMutex);
+      return observedTangibles.size();
+   }
+
+   /***************************************************************************/
+
    bool Being::insertIntoInventory(
       const std::shared_ptr<Object> &object,
       bool considerWeight
    ) {
 
-      int invMaxWeight = getProperty<int>(InvMaxWeightProperty);
-      int objectWeight = object->getProperty<int>(Object::WeightProperty);
+      int invMaxWeight = getProperty<int>(PROPERTY_SLOT_INV_MAX_WEIGHT);
+      int objectWeight = object->getProperty<int>(PROPERTY_SLOT_WEIGHT);
+
+      mutex.lock();
 
       // make sure the Object will fit
-      if (considerWeight && invMaxWeight > 0 &&
-      getInventoryCurWeight() + objectWeight > invMaxWeight) {
+      if (considerWeight && invMaxWeight > 0 && inventory.weight + objectWeight > invMaxWeight) {
+         mutex.unlock();
          return false;
       }
 
+      auto item = findInventoryObject(object->getName());
+      size_t index = item - inventory.objects.begin();
+
+      if (inventory.objects.end() != item && item->first == object->getName()) {
+
+         // The Object's already in the inventory
+         if (item->second.lock() == object) {
+            mutex.unlock();
+            return true;
+         }
+
+         // Replace whatever was left behind under the same name
+         item->second = object;
+         inventory.weight += objectWeight - inventory.weights[index];
+         inventory.weights[index] = objectWeight;
+      }
+
       // insert the object into the Being's inventory
-      mutex.lock();
-      inventory.objects[object->getName()] = object;
-      mutex.unlock();
+      else {
+         inventory.objects.insert(item, {object->getName(), object});
+         inventory.weights.insert(inventory.weights.begin() + index, objectWeight);
+         inventory.weight += objectWeight;
+      }
 
       // allow referencing of inventory Objects by name and aliases
-      std::vector<std::string> objAliases = object->getAliases();
-      for (int i = objAliases.size() - 1; i >= 0; i--) {
-         indexInventoryItemName(objAliases[i], object.get());
+      for (const auto &alias: object->getAliases()) {
+         inventory.objectsByName[alias].push_back(object);
       }
 
-      mutex.lock();
       object->setOwner(getShared());
       mutex.unlock();
 
+      object->addCallback("setProperty", updateObjectWeight);
+
       return true;
    }
 
@@ -288,27 +377,67 @@ namespace trogdor::entity {
 
       mutex.lock();
 
-      std::vector<std::string> objAliases = object->getAliases();
+      auto item = findInventoryObject(object->getName());
 
-      for (int i = objAliases.size() - 1; i >= 0; i--) {
+      if (inventory.objects.end() == item || item->second.lock() != object) {
+         mutex.unlock();
+         return;
+      }
 
-         inventory.objectsByName.find(objAliases[i])->second.remove_if([object] (std::weak_ptr<Object> i) {
+      size_t index = item - inventory.objects.begin();
 
-            std::shared_ptr<Object> curObj = i.lock();
+      inventory.weight -= inventory.weights[index];
+      inventory.weights.erase(inventory.weights.begin() + index);
+      inventory.objects.erase(item);
 
-            // Remove any stale pointers as well as the matching item
-            if (!curObj || object == curObj) {
-               return true;
-            }
+      for (const auto &alias: object->getAliases()) {
+
+         auto indexed = inventory.objectsByName.find(alias);
+
+         if (inventory.objectsByName.end() == indexed) {
+            continue;
+         }
+
+         auto &objects = indexed->second;
 
-            return false;
-         });
+         // Remove any stale pointers as well as the matching item
+         objects.erase(std::remove_if(objects.begin(), objects.end(), [&object] (const std::weak_ptr<Object> &i) {
+
+            std::shared_ptr<Object> curObj = i.lock();
+            return !curObj || object == curObj;
+         }), objects.end());
+
+         if (objects.empty()) {
+            inventory.objectsByName.erase(indexed);
+         }
       }
 
-      inventory.objects.erase(object->getName());
       object->setOwner(std::weak_ptr<Being>());
 
       mutex.unlock();
+
+      object->removeCallback("setProperty", updateObjectWeight);
+   }
+
+   /***************************************************************************/
+
+   void Being::updateInventoryWeight(Object *object) {
+
+      int weight = object->getProperty<int>(PROPERTY_SLOT_WEIGHT);
+
+      mutex.lock();
+
+      auto item = findInventoryObject(object->getName());
+
+      if (inventory.objects.end() != item && item->second.lock().get() == object) {
+
+         size_t index = item - inventory.objects.begin();
+
+         inventory.weight += weight - inventory.weights[index];
+         inventory.weights[index] = weight;
+      }
+
+      mutex.unlock();
    }
 
    /***************************************************************************/
@@ -338,13 +467,13 @@ namespace trogdor::entity {
 
       // I do this first, and the other message second so that the Being that's
       // leaving won't see messages about its own departure and arrival ;)
-      l->out("notifications") << getProperty<std::string>(TitleProperty)
+      l->out("notifications") << getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)
          << " arrives." << std::endl;
 
       l->insertThing(getShared());
       l->observe(getShared());
 
-      oldLoc->out("notifications") << getProperty<std::string>(TitleProperty)
+      oldLoc->out("notifications") << getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)
          << " leaves." << std::endl;
 
       game->event({
@@ -372,7 +501,7 @@ namespace trogdor::entity {
             return;
          }
 
-         if (checkUntakeable && object->isTagSet(Object::UntakeableTag)) {
+         if (checkUntakeable && object->isTagSet(TAG_SLOT_UNTAKEABLE)) {
 
             if (doEvents) {
                game->event({
@@ -410,13 +539,13 @@ namespace trogdor::entity {
             for (auto const &thing: location->getThings()) {
                if (thing.get() != this) {
                   thing->out("notifications") <<
-                     getProperty<std::string>(TitleProperty) << " takes "
-                     << object->getProperty<std::string>(TitleProperty)
+                     getPropertyRef<std::string>(PROPERTY_SLOT_TITLE) << " takes "
+                     << object->getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)
                      << "." << std::endl;
                }
             };
 
-            std::string message = object->getMessage("take");
+            std::string_view message = object->getMessage("take");
 
             if (message.length() > 0) {
                out("display") << message << std::endl;
@@ -458,10 +587,12 @@ namespace trogdor::entity {
          // remove the allocation before we've had the chance to read its value.
          mutex.lock();
 
-         if (location->getResources().end() != location->getResources().find(resource)) {
+         std::optional<double> allocation = location->getResourceAllocation(resource);
+
+         if (allocation) {
 
             entity::Resource::AllocationStatus status;
-            double allocatedToPlace = location->getResources().find(resource)->second;
+            double allocatedToPlace = *allocation;
 
             mutex.unlock();
 
@@ -470,14 +601,14 @@ namespace trogdor::entity {
             // we should allocate extra (as long as it's less than or
             // equal to the amount already in the room.)
             if (
-               resource->isTagSet(Resource::StickyTag) &&
-               !resource->isPropertySet(Resource::AmtAvailProperty)
+               resource->isTagSet(TAG_SLOT_STICKY) &&
+               !resource->isPropertySet(PROPERTY_SLOT_AMT_AVAIL)
             ) {
 
                if (amount > allocatedToPlace) {
                   out("display") << "You can only take "
                      << resource->amountToString(allocatedToPlace)
-                     << ' ' << resource->getProperty<std::string>(Resource::PluralTitleProperty)
+                     << ' ' << resource->getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_TITLE)
                      << '.' << std::endl;
                   return;
                }
@@ -489,7 +620,7 @@ namespace trogdor::entity {
                status = resource->transfer(location, getShared(), amount);
             }
 
-            std::string message = resource->getMessage("take");
+            std::string message(resource->getMessage("take"));
 
             switch (status) {
 
@@ -502,7 +633,7 @@ namespace trogdor::entity {
                         << std::endl;
                   } else {
                      out("display") << "Please specify a whole number of "
-                        << resource->getProperty<std::string>(Resource::PluralTitleProperty)
+                        << resource->getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_TITLE)
                         << '.' << std::endl;
                   }
 
@@ -517,10 +648,10 @@ namespace trogdor::entity {
                         << std::endl;
                   } else {
                      out("display") << "That would give you "
-                        << resource->amountToString(getResources().find(resource)->second + amount)
-                        << ' ' << resource->getProperty<std::string>(Resource::PluralTitleProperty)
+                        << resource->amountToString(getResourceAllocation(resource).value_or(0) + amount)
+                        << ' ' << resource->getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_TITLE)
                         << " and you're only allowed to possess "
-                        << resource->amountToString(resource->getProperty<double>(Resource::MaxAmtPerDepositorProperty))
+                        << resource->amountToString(resource->getProperty<double>(PROPERTY_SLOT_MAX_AMT_PER_DEPOSITOR))
                         << '.' << std::endl;
                   }
 
@@ -550,7 +681,7 @@ namespace trogdor::entity {
                   } else {
                      out("display") << "You can only take "
                         << resource->amountToString(allocatedToPlace)
-                        << ' ' << resource->getProperty<std::string>(Resource::PluralTitleProperty)
+                        << ' ' << resource->getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_TITLE)
                         << '.' << std::endl;
                   }
 
@@ -563,7 +694,7 @@ namespace trogdor::entity {
 
                   out("display") << "You can only take "
                      << resource->amountToString(allocatedToPlace)
-                     << ' ' << resource->getProperty<std::string>(Resource::PluralTitleProperty)
+                     << ' ' << resource->getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_TITLE)
                      << '.' << std::endl;
 
                   break;
@@ -576,7 +707,7 @@ namespace trogdor::entity {
                   for (auto const &thing: location->getThings()) {
                      if (thing.get() != this) {
                         thing->out("notifications")
-                           << getProperty<std::string>(TitleProperty)
+                           << getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)
                            << " takes " << resource->amountToString(amount) << ' '
                            << resource->titleToString(amount) << '.' << std::endl;
                      }
@@ -629,7 +760,7 @@ namespace trogdor::entity {
             return;
          }
 
-         if (checkUndroppable && object->isTagSet(Object::UndroppableTag)) {
+         if (checkUndroppable && object->isTagSet(TAG_SLOT_UNDROPPABLE)) {
 
             if (doEvents) {
                game->event({
@@ -651,13 +782,13 @@ namespace trogdor::entity {
          for (auto const &thing: location->getThings()) {
             if (thing.get() != this) {
                thing->out("notifications")
-                  << getProperty<std::string>(TitleProperty) << " drops "
-                  << object->getProperty<std::string>(TitleProperty) << "."
+                  << getPropertyRef<std::string>(PROPERTY_SLOT_TITLE) << " drops "
+                  << object->getPropertyRef<std::string>(PROPERTY_SLOT_TITLE) << "."
                   << std::endl;
             }
          };
 
-         std::string message = object->getMessage("drop");
+         std::string_view message = object->getMessage("drop");
 
          if (message.length() > 0) {
             out("display") << message << std::endl;
@@ -685,7 +816,7 @@ namespace trogdor::entity {
       bool doEvents
    ) {
 
-      if (resource->isTagSet(entity::Resource::EphemeralTag)) {
+      if (resource->isTagSet(entity::TAG_SLOT_EPHEMERAL)) {
          freeResource(resource.get(), amount, doEvents);
       } else {
          transferResourceToPlace(resource.get(), amount, doEvents);
@@ -698,13 +829,13 @@ namespace trogdor::entity {
 
       int damage;
 
-      damage = round(getProperty<int>(DamageBareHandsProperty) * getAttributeFactor("strength"));
+      damage = round(getProperty<int>(PROPERTY_SLOT_DAMAGE_BARE_HANDS) * getAttributeFactor("strength"));
 
       // make sure we always do at least 1 point damage
       damage = damage > 0 ? damage : 1;
 
-      if (0 != weapon && weapon->isTagSet(Object::WeaponTag)) {
-         damage += weapon->getProperty<int>(Object::DamageProperty);
+      if (0 != weapon && weapon->isTagSet(TAG_SLOT_WEAPON)) {
+         damage += weapon->getProperty<int>(PROPERTY_SLOT_DAMAGE);
       }
 
       damage *= defender->getDamageRatio();
@@ -727,7 +858,7 @@ namespace trogdor::entity {
       static std::mt19937 generator(rd());
       static std::uniform_real_distribution<double> distribution(0, 1);
 
-      double defenderWoundRate = defender->getProperty<double>(WoundRateProperty);
+      double defenderWoundRate = defender->getProperty<double>(PROPERTY_SLOT_WOUND_RATE);
 
       // probability that the attack will be successful
       double p = CLAMP(getAttributeFactor("strength") * (defenderWoundRate / 2) +
@@ -774,7 +905,7 @@ namespace trogdor::entity {
             return;
          }
 
-         out("combat") << defender->getProperty<std::string>(TitleProperty)
+         out("combat") << defender->getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)
             << " is already dead." << std::endl;
          return;
       }
@@ -786,41 +917,41 @@ namespace trogdor::entity {
             return;
          }
 
-         out("combat") << defender->getProperty<std::string>(TitleProperty)
+         out("combat") << defender->getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)
             << " is immortal and cannot die." << std::endl;
          return;
       }
 
       // Defender isn't attackable
-      else if (!defender->isTagSet(Being::AttackableTag)) {
+      else if (!defender->isTagSet(TAG_SLOT_ATTACKABLE)) {
 
          if (!game->event({"attackDefenderNotAttackable", listeners, args})) {
             return;
          }
 
-         out("combat") << defender->getProperty<std::string>(TitleProperty)
+         out("combat") << defender->getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)
             << " cannot be attacked." << std::endl;
          return;
       }
 
       // send notification to the aggressor
       out("combat") << "You attack "
-         << defender->getProperty<std::string>(TitleProperty);
+         << defender->getPropertyRef<std::string>(PROPERTY_SLOT_TITLE);
 
       if (0 != weapon) {
          out("combat") << " with "
-            << weapon->getProperty<std::string>(TitleProperty);
+            << weapon->getPropertyRef<std::string>(PROPERTY_SLOT_TITLE);
       }
 
       out("combat") << '.' << std::endl;
 
       // send notification to the defender
       defender->out("combat") << "You're attacked by "
-         << getProperty<std::string>(TitleProperty);
+         << getPropertyRef<std::string>(PROPERTY_SLOT_TITLE);
 
       if (0 != weapon) {
          defender->out("combat") << " with "
-            << weapon->getProperty<std::string>(TitleProperty);
+            << weapon->getPropertyRef<std::string>(PROPERTY_SLOT_TITLE);
       }
 
       defender->out("combat") << '!' << std::endl;
@@ -836,11 +967,11 @@ namespace trogdor::entity {
          defender->removeHealth(damage);
 
          out("combat") << "You dealt a blow to "
-            << defender->getProperty<std::string>(TitleProperty) << "!"
+            << defender->getPropertyRef<std::string>(PROPERTY_SLOT_TITLE) << "!"
                << std::endl;
-         defender->out("combat") << getProperty<std::string>(TitleProperty)
+         defender->out("combat") << getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)
             << " dealt you a blow!" << std::endl;
-         out("combat") << defender->getProperty<std::string>(TitleProperty)
+         out("combat") << defender->getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)
             << " loses " << damage << " health points." << std::endl;
          defender->out("combat") << "You lose " << damage << " health points."
             << std::endl;
@@ -857,14 +988,14 @@ namespace trogdor::entity {
          }
 
          out("combat") << "Your attack failed." << std::endl;
-         defender->out("combat") << getProperty<std::string>(TitleProperty)
+         defender->out("combat") << getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)
             << "'s attack failed." << std::endl;
       }
 
       if (
          ENTITY_CREATURE == defender->getType() &&
-         Creature::FRIEND != static_cast<Creature *>(defender)->getProperty<int>(Creature::AllegianceProperty) &&
-         static_cast<Creature *>(defender)->getProperty<bool>(Creature::CounterAttackProperty) &&
+         Creature::FRIEND != static_cast<Creature *>(defender)->getProperty<int>(PROPERTY_SLOT_ALLEGIANCE) &&
+         static_cast<Creature *>(defender)->getProperty<bool>(PROPERTY_SLOT_COUNTER_ATTACK) &&
          allowCounterAttack
       ) {
          defender->attack(this, static_cast<Creature *>(defender)->selectWeapon(), false);
@@ -877,28 +1008,28 @@ namespace trogdor::entity {
 
    void Being::addHealth(int up, bool allowOverflow) {
 
-      int maxHealth = getProperty<int>(MaxHealthProperty);
+      int maxHealth = getProperty<int>(PROPERTY_SLOT_MAX_HEALTH);
 
-      if (!game->event({"beforeAddHealth", {triggers.get()}, {this, getProperty<int>(HealthProperty), up}})) {
+      if (!game->event({"beforeAddHealth", {triggers.get()}, {this, getProperty<int>(PROPERTY_SLOT_HEALTH), up}})) {
          return;
       }
 
-      int tmpHealth = getProperty<int>(HealthProperty);
+      int tmpHealth = getProperty<int>(PROPERTY_SLOT_HEALTH);
       tmpHealth += up;
 
-      setProperty(HealthProperty, !allowOverflow && tmpHealth > maxHealth ? maxHealth : tmpHealth);
-      game->event({"afterAddHealth", {triggers.get()}, {this, getProperty<int>(HealthProperty), up}});
+      setProperty(PROPERTY_SLOT_HEALTH, !allowOverflow && tmpHealth > maxHealth ? maxHealth : tmpHealth);
+      game->event({"afterAddHealth", {triggers.get()}, {this, getProperty<int>(PROPERTY_SLOT_HEALTH), up}});
    }
 
    /***************************************************************************/
 
    void Being::removeHealth(int down, bool allowDeath) {
 
-      if (!game->event({"beforeRemoveHealth", {triggers.get()}, {this, getProperty<int>(HealthProperty), down}})) {
+      if (!game->event({"beforeRemoveHealth", {triggers.get()}, {this, getProperty<int>(PROPERTY_SLOT_HEALTH), down}})) {
          return;
       }
 
-      int tmpHealth = getProperty<int>(HealthProperty);
+      int tmpHealth = getProperty<int>(PROPERTY_SLOT_HEALTH);
       tmpHealth -= down;
 
       if (tmpHealth <= 0) {
@@ -909,10 +1040,10 @@ namespace trogdor::entity {
       }
 
       else {
-         setProperty(HealthProperty, tmpHealth);
+         setProperty(PROPERTY_SLOT_HEALTH, tmpHealth);
       }
 
-      game->event({"afterRemoveHealth", {triggers.get()}, {this, getProperty<int>(HealthProperty), down}});
+      game->event({"afterRemoveHealth", {triggers.get()}, {this, getProperty<int>(PROPERTY_SLOT_HEALTH), down}});
    }
 
    /***************************************************************************/
@@ -925,12 +1056,12 @@ namespace trogdor::entity {
 
       // TODO: I need a way to support programmatically killing an immortal
       // player.
-      setProperty(HealthProperty, static_cast<int>(0));
+      setProperty(PROPERTY_SLOT_HEALTH, static_cast<int>(0));
 
       auto location = getLocation().lock();
 
       if (showMessage && location) {
-         location->out("notifications") << getProperty<std::string>(TitleProperty)
+         location->out("notifications") << getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)
             << " dies." << std::endl;
       }
 
@@ -949,7 +1080,7 @@ namespace trogdor::entity {
          // back to life, so make sure it did before we send out the message
          if (isAlive()) {
 
-            std::string msg = getMessage("respawn");
+            std::string msg(getMessage("respawn"));
 
             if (0 == msg.length()) {
                msg = name + " comes back to life.";
@@ -970,7 +1101,7 @@ namespace trogdor::entity {
          return;
       }
 
-      setProperty(HealthProperty, getProperty<int>(MaxHealthProperty));
+      setProperty(PROPERTY_SLOT_HEALTH, getProperty<int>(PROPERTY_SLOT_MAX_HEALTH));
       game->event({"afterRespawn", {triggers.get()}, {game, this}});
    }
 }
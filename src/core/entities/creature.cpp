@@ -1,6 +1,7 @@
 #include <random>
 
 #include <trogdor/game.h>
+#include <trogdor/entities/player.h>
 #include <trogdor/entities/creature.h>
 #include <trogdor/entities/room.h>
 
@@ -10,14 +11,14 @@ namespace trogdor::entity {
 
    void Creature::setPropertyValidators() {
 
-      setPropertyValidator(AutoAttackEnabledProperty, [&](PropertyValue v) -> int {return isPropertyValueBool(v);});
-      setPropertyValidator(AutoAttackRepeatProperty, [&](PropertyValue v) -> int {return isPropertyValueBool(v);});
-      setPropertyValidator(AutoAttackIntervalProperty, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
+      setPropertyValidator(PROPERTY_SLOT_AUTOATTACK_ENABLED, [&](PropertyValue v) -> int {return isPropertyValueBool(v);});
+      setPropertyValidator(PROPERTY_SLOT_AUTOATTACK_REPEAT, [&](PropertyValue v) -> int {return isPropertyValueBool(v);});
+      setPropertyValidator(PROPERTY_SLOT_AUTOATTACK_INTERVAL, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
 
-      setPropertyValidator(CounterAttackProperty, [&](PropertyValue v) -> int {return isPropertyValueBool(v);});
-      setPropertyValidator(WanderEnabledProperty, [&](PropertyValue v) -> int {return isPropertyValueBool(v);});
+      setPropertyValidator(PROPERTY_SLOT_COUNTER_ATTACK, [&](PropertyValue v) -> int {return isPropertyValueBool(v);});
+      setPropertyValidator(PROPERTY_SLOT_WANDER_ENABLED, [&](PropertyValue v) -> int {return isPropertyValueBool(v);});
 
-      setPropertyValidator(WanderIntervalProperty, [&](PropertyValue v) -> int {
+      setPropertyValidator(PROPERTY_SLOT_WANDER_INTERVAL, [&](PropertyValue v) -> int {
 
          if (PROPERTY_VALID != isPropertyValueInt(v)) {
             return PROPERTY_INVALID_TYPE;
@@ -30,7 +31,7 @@ namespace trogdor::entity {
          return PROPERTY_VALID;
       });
 
-      setPropertyValidator(WanderLustProperty, [&](PropertyValue v) -> int {
+      setPropertyValidator(PROPERTY_SLOT_WANDER_LUST, [&](PropertyValue v) -> int {
 
          if (PROPERTY_VALID != isPropertyValueDouble(v)) {
             return PROPERTY_INVALID_TYPE;
@@ -43,7 +44,7 @@ namespace trogdor::entity {
          return PROPERTY_VALID;
       });
 
-      setPropertyValidator(AllegianceProperty, [&](PropertyValue v) -> int {
+      setPropertyValidator(PROPERTY_SLOT_ALLEGIANCE, [&](PropertyValue v) -> int {
 
          if (PROPERTY_VALID != isPropertyValueInt(v)) {
             return PROPERTY_INVALID_TYPE;
@@ -60,6 +61,24 @@ namespace trogdor::entity {
                return PROPERTY_INVALID_TYPE;
          }
       });
+
+      setPropertyValidator(PROPERTY_SLOT_WANDER_MODE, [&](PropertyValue v) -> int {
+
+         if (PROPERTY_VALID != isPropertyValueInt(v)) {
+            return PROPERTY_INVALID_TYPE;
+         }
+
+         switch (std::get<int>(v)) {
+
+            case WANDER_RANDOM:
+            case WANDER_PURSUE:
+            case WANDER_FLEE:
+               return PROPERTY_VALID;
+
+            default:
+               return PROPERTY_INVALID_TYPE;
+         }
+      });
    }
 
    /**************************************************************************/
@@ -71,19 +90,20 @@ namespace trogdor::entity {
       std::unique_ptr<Trogerr> e
    ): Being(g, n, std::move(o), std::move(e)) {
 
-      types.push_back(ENTITY_CREATURE);
+      setType(ENTITY_CREATURE);
       setClass("creature");
 
-      setProperty(CounterAttackProperty, DEFAULT_COUNTER_ATTACK);
-      setProperty(AllegianceProperty, DEFAULT_ALLEGIANCE);
+      setProperty(PROPERTY_SLOT_COUNTER_ATTACK, DEFAULT_COUNTER_ATTACK);
+      setProperty(PROPERTY_SLOT_ALLEGIANCE, DEFAULT_ALLEGIANCE);
 
-      setProperty(AutoAttackEnabledProperty, DEFAULT_AUTO_ATTACK_ENABLED);
-      setProperty(AutoAttackRepeatProperty, DEFAULT_AUTO_ATTACK_REPEAT);
-      setProperty(AutoAttackIntervalProperty, DEFAULT_AUTO_ATTACK_INTERVAL);
+      setProperty(PROPERTY_SLOT_AUTOATTACK_ENABLED, DEFAULT_AUTO_ATTACK_ENABLED);
+      setProperty(PROPERTY_SLOT_AUTOATTACK_REPEAT, DEFAULT_AUTO_ATTACK_REPEAT);
+      setProperty(PROPERTY_SLOT_AUTOATTACK_INTERVAL, DEFAULT_AUTO_ATTACK_INTERVAL);
 
-      setProperty(WanderEnabledProperty, DEFAULT_WANDER_ENABLED);
-      setProperty(WanderIntervalProperty, DEFAULT_WANDER_INTERVAL);
-      setProperty(WanderLustProperty, DEFAULT_WANDER_LUST);
+      setProperty(PROPERTY_SLOT_WANDER_ENABLED, DEFAULT_WANDER_ENABLED);
+      setProperty(PROPERTY_SLOT_WANDER_INTERVAL, DEFAULT_WANDER_INTERVAL);
+      setProperty(PROPERTY_SLOT_WANDER_LUST, DEFAULT_WANDER_LUST);
+      setProperty(PROPERTY_SLOT_WANDER_MODE, static_cast<int>(DEFAULT_WANDER_MODE));
 
       setPropertyValidators();
    }
@@ -101,7 +121,7 @@ namespace trogdor::entity {
    ): Being(g, data, std::move(o), std::move(e)) {
 
       setPropertyValidators();
-      types.push_back(ENTITY_CREATURE);
+      setType(ENTITY_CREATURE);
    }
 
    /***************************************************************************/
@@ -136,7 +156,7 @@ namespace trogdor::entity {
                if (0 == tag.compare(Object::WeaponTag)) {
 
                   // The weapon tag was added
-                  if (object->isTagSet(Object::WeaponTag)) {
+                  if (object->isTagSet(TAG_SLOT_WEAPON)) {
                      mutex.lock();
                      weaponCache.insert(object);
                      mutex.unlock();
@@ -154,7 +174,7 @@ namespace trogdor::entity {
             });
          }
 
-         if (object->isTagSet(Object::WeaponTag)) {
+         if (object->isTagSet(TAG_SLOT_WEAPON)) {
 
             mutex.lock();
             weaponCache.insert(object.get());
@@ -179,7 +199,7 @@ namespace trogdor::entity {
          object->removeCallback("removeTag", updateObjectTag);
       }
 
-      if (object->isTagSet(Object::WeaponTag)) {
+      if (object->isTagSet(TAG_SLOT_WEAPON)) {
          mutex.lock();
          weaponCache.erase(object.get());
          mutex.unlock();
@@ -229,6 +249,111 @@ namespace trogdor::entity {
 
    /***************************************************************************/
 
+   std::shared_ptr<Thing> Creature::getWanderTarget() {
+
+      std::lock_guard<std::mutex> lock(mutex);
+      return wanderTarget.lock();
+   }
+
+   /***************************************************************************/
+
+   void Creature::setWanderTarget(const std::shared_ptr<Thing> &target) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+      wanderTarget = target;
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<Thing> Creature::acquireWanderTarget(const Room *location) {
+
+      RoomGraph &graph = game->getRoomGraph();
+      std::shared_ptr<Thing> target = getWanderTarget();
+
+      auto isValid = [&](Thing *thing) -> bool {
+
+         if (game != thing->getGame() || !graph.getDistanceTo(location, thing)) {
+            return false;
+         }
+
+         return !thing->isType(ENTITY_BEING) || static_cast<Being *>(thing)->isAlive();
+      };
+
+      if (target && isValid(target.get())) {
+         return target;
+      }
+
+      target = nullptr;
+      size_t targetDistance = RoomGraph::UNREACHABLE;
+
+      // This runs on the timer thread, which doesn't hold the game's lock, so
+      // Players can join or leave while we're looking for one
+      for (const auto &player: game->getPlayerSnapshot()) {
+
+         if (!player->isAlive()) {
+            continue;
+         }
+
+         std::optional<size_t> distance = graph.getDistanceTo(location, player.get());
+
+         if (distance && *distance < targetDistance) {
+            target = player;
+            targetDistance = *distance;
+         }
+      }
+
+      setWanderTarget(target);
+      return target;
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<Room> Creature::selectWanderDestination() {
+
+      static std::random_device rd;
+      static std::mt19937 generator(rd());
+
+      std::shared_ptr<Place> location = getLocation().lock();
+
+      // Creatures in some special non-Room Place don't have any connections
+      if (!location || ENTITY_ROOM != location->getType()) {
+         return nullptr;
+      }
+
+      auto curLoc = std::static_pointer_cast<Room>(location);
+      int mode = getProperty<int>(PROPERTY_SLOT_WANDER_MODE);
+
+      if (WANDER_RANDOM != mode && game) {
+
+         if (std::shared_ptr<Thing> target = acquireWanderTarget(curLoc.get())) {
+
+            RoomGraph &graph = game->getRoomGraph();
+            std::optional<RoomGraph::Step> step = WANDER_PURSUE == mode ?
+               graph.getStepToward(curLoc.get(), target.get()) :
+               graph.getStepAwayFrom(curLoc.get(), target.get());
+
+            // If there's no step, we've either caught up with our target or
+            // have nowhere farther to run, so we should stay where we are
+            return step ? step->room : nullptr;
+         }
+      }
+
+      size_t nConnections = curLoc->getNumConnections();
+
+      // don't do anything if Creature is stuck in a room with no exits
+      if (!nConnections) {
+         return nullptr;
+      }
+
+      std::uniform_int_distribution<size_t> connectionsDist(0, nConnections - 1);
+
+      // This will be null if the connection was to a Room that no longer
+      // exists
+      return curLoc->getConnectionByIndex(connectionsDist(generator));
+   }
+
+   /***************************************************************************/
+
    void Creature::wander(bool overrideEnable) {
 
       static std::random_device rd;
@@ -241,7 +366,7 @@ namespace trogdor::entity {
       }
 
       // make sure wandering isn't turned off
-      else if (!overrideEnable && !getProperty<bool>(WanderEnabledProperty)) {
+      else if (!overrideEnable && !getProperty<bool>(PROPERTY_SLOT_WANDER_ENABLED)) {
          return;
       }
 
@@ -254,30 +379,12 @@ namespace trogdor::entity {
          }
 
          // creature considers moving or staying; which will he pick?
-         else if (probabilityDist(generator) > getProperty<double>(WanderLustProperty)) {
+         else if (probabilityDist(generator) > getProperty<double>(PROPERTY_SLOT_WANDER_LUST)) {
             return;
          }
 
-         auto curLoc = std::static_pointer_cast<Room>(location);
-         size_t nConnections = curLoc->getNumConnections();
-
-         // don't do anything if Creature is stuck in a room with no exits
-         if (!nConnections) {
-            return;
-         }
-
-         // TODO: use AI to select destination more intelligently; currently random
-         // The whole rest of this function will change when we do...
-         std::uniform_int_distribution<int> connectionsDist(0, nConnections - 1);
-
-         std::shared_ptr<Room> connection = curLoc->getConnectionByIndex(
-            connectionsDist(generator)
-         )->getShared();
-
-         // Only proceed if the connection is to a Room that still exists (valid
-         // pointer)
-         if (connection) {
-            gotoLocation(connection);
+         if (std::shared_ptr<Room> destination = selectWanderDestination()) {
+            gotoLocation(destination);
          }
       }
    }
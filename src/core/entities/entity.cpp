@@ -24,9 +24,9 @@ namespace trogdor::entity {
 
    void Entity::setPropertyValidators() {
 
-      setPropertyValidator(TitleProperty, [&](PropertyValue v) -> int {return isPropertyValueString(v);});
-      setPropertyValidator(LongDescProperty, [&](PropertyValue v) -> int {return isPropertyValueString(v);});
-      setPropertyValidator(ShortDescProperty, [&](PropertyValue v) -> int {return isPropertyValueString(v);});
+      setPropertyValidator(PROPERTY_SLOT_TITLE, [&](PropertyValue v) -> int {return isPropertyValueString(v);});
+      setPropertyValidator(PROPERTY_SLOT_LONG_DESC, [&](PropertyValue v) -> int {return isPropertyValueString(v);});
+      setPropertyValidator(PROPERTY_SLOT_SHORT_DESC, [&](PropertyValue v) -> int {return isPropertyValueString(v);});
    }
 
    /***************************************************************************/
@@ -42,7 +42,7 @@ namespace trogdor::entity {
             + "dashes, and single spaces.)");
       }
 
-      types.push_back(ENTITY_ENTITY);
+      setType(ENTITY_ENTITY);
 
       // this should always be overridden by a top-level Entity type
       className = "entity";
@@ -56,9 +56,11 @@ namespace trogdor::entity {
 
    /***************************************************************************/
 
-   Entity::Entity(const Entity &e, std::string n): msgs(e.msgs), tags(e.tags),
+   // Messages, custom tags, properties and validators are shared with the
+   // prototype until either one modifies them (see copyonwrite.h)
+   Entity::Entity(const Entity &e, std::string n): msgs(e.msgs), slotTags(e.slotTags), customTags(e.customTags),
    properties(e.properties), propertyValidators(e.propertyValidators),
-   types(e.types), game(nullptr), name(n), className(e.className) {
+   type(e.type), typeMask(e.typeMask), game(nullptr), name(n), className(e.className) {
 
       if (!isNameValid(n)) {
          throw ValidationException(std::string("name '") + n
@@ -101,14 +103,28 @@ namespace trogdor::entity {
    ): game(g), name(std::get<std::string>(*data.get("name"))),
    outStream(std::move(o)), errStream(std::move(e)) {
 
-      types.push_back(ENTITY_ENTITY);
+      setType(ENTITY_ENTITY);
       className = std::get<std::string>(*data.get("class"));
 
+      // Restored when the Entity is reinserted into the deserialized Game, so
+      // that any handles stored elsewhere continue to refer to it
+      if (auto serializedHandle = data.get("handle")) {
+
+         const auto &handleData = std::get<std::shared_ptr<serial::Serializable>>(*serializedHandle);
+
+         handle.index = static_cast<uint32_t>(std::get<size_t>(*handleData->get("index")));
+         handle.generation = static_cast<uint32_t>(std::get<size_t>(*handleData->get("generation")));
+      }
+
       std::vector<std::string> serializedTags =
          std::get<std::vector<std::string>>(*data.get("tags"));
 
       for (const auto &tag: serializedTags) {
-         tags.insert(tag);
+         if (auto slot = strToTagSlot(tag)) {
+            slotTags.set(*slot);
+         } else {
+            customTags.write().insert(tag);
+         }
       }
 
       std::shared_ptr<serial::Serializable> serializedMeta =
@@ -122,7 +138,7 @@ namespace trogdor::entity {
          std::get<std::shared_ptr<serial::Serializable>>(*data.get("messages"));
 
       for (const auto &msg: serializedMsgs->getAll()) {
-         msgs.set(msg.first, std::get<std::string>(msg.second));
+         msgs.write().set(msg.first, std::get<std::string>(msg.second));
       }
 
       std::shared_ptr<serial::Serializable> serializedProperties =
@@ -141,7 +157,12 @@ namespace trogdor::entity {
 					std::is_same_v<T, bool> ||
 					std::is_same_v<T, std::string>
 				) {
-               properties[property.first] = value;
+               if (auto slot = strToPropertySlot(property.first)) {
+                  properties.write().slots[*slot] = storePropertyValue(value);
+                  properties.write().slotsSet.set(*slot);
+               } else {
+                  properties.write().custom[property.first] = storePropertyValue(value);
+               }
             }
 
             else {
@@ -151,7 +172,7 @@ namespace trogdor::entity {
       }
 
       triggers = std::make_unique<event::EventListener>(
-         *std::get<std::shared_ptr<serial::Serializable>>(*data.get("eventListener")), g->getLuaState()
+         *std::get<std::shared_ptr<serial::Serializable>>(*data.get("eventListener")), g
       );
 
       setPropertyValidators();
@@ -170,27 +191,45 @@ namespace trogdor::entity {
       data->set("name", name);
       data->set("class", className);
 
-      std::vector<std::string> typeStrs;
+      std::shared_ptr<serial::Serializable> serializedHandle = std::make_shared<serial::Serializable>();
+
+      serializedHandle->set("index", static_cast<size_t>(handle.index));
+      serializedHandle->set("generation", static_cast<size_t>(handle.generation));
+      data->set("handle", serializedHandle);
 
-      for (const auto &type: types) {
-         typeStrs.push_back(typeToStr(type));
+      // Serialized from the root of the hierarchy down to the most specific
+      // type. Every type's mask has exactly one more bit set than its
+      // parent's, so the number of bits set is its depth in the hierarchy.
+      auto depth = [](EntityTypeMask mask) -> size_t {
+         return std::bitset<sizeof(EntityTypeMask) * 8>(mask).count();
+      };
+
+      std::vector<std::string> typeStrs(depth(typeMask));
+
+      for (int i = ENTITY_ENTITY; i < NUM_ENTITY_TYPES; i++) {
+
+         auto ancestor = static_cast<enum EntityType>(i);
+
+         if (isType(ancestor)) {
+            typeStrs[depth(entityTypeMask(ancestor)) - 1] = typeToStr(ancestor);
+         }
       }
 
       data->set("types", typeStrs);
 
       std::shared_ptr<serial::Serializable> serializedMsgs = std::make_shared<serial::Serializable>();
 
-      for (auto it = msgs.cbegin(); it != msgs.cend(); it++) {
-         serializedMsgs->set(it->first, it->second);
+      for (auto it = msgs->cbegin(); it != msgs->cend(); it++) {
+         serializedMsgs->set(it->first, it->second.str());
       }
 
       std::vector<std::string> tagsArray;
 
       data->set("messages", serializedMsgs);
 
-      for (const auto &tag: tags) {
+      forEachTag([&](const std::string &tag) {
          tagsArray.push_back(tag);
-      }
+      });
 
       std::shared_ptr<serial::Serializable> serializedMeta = std::make_shared<serial::Serializable>();
 
@@ -204,11 +243,11 @@ namespace trogdor::entity {
 
       std::shared_ptr<serial::Serializable> serializedProperties = std::make_shared<serial::Serializable>();
 
-      for (const auto &property: properties) {
+      forEachProperty([&](const std::string &key, const PropertyValue &property) {
          std::visit([&](auto &&value) {
-            serializedProperties->set(property.first, value);
-         }, property.second);
-      }
+            serializedProperties->set(key, value);
+         }, property);
+      });
 
       data->set("properties", serializedProperties);
       data->set("eventListener", triggers->serialize());
@@ -292,14 +331,29 @@ namespace trogdor::entity {
 
    void Entity::setTag(std::string tag) {
 
+      bool changed = false;
+
       mutex.lock();
 
+      if (auto slot = strToTagSlot(tag)) {
+         changed = !slotTags.test(*slot);
+         slotTags.set(*slot);
+      }
+
       // Make sure the tag only gets inserted once
-      if (tags.end() == tags.find(tag)) {
-         tags.insert(tag);
+      else if (customTags->end() == customTags->find(tag)) {
+         customTags.write().insert(tag);
+         changed = true;
+      }
+
+      // The index is updated before letting go of the lock, so that a
+      // concurrent removeTag() can't leave it out of step with the tag
+      if (changed && game) {
+         game->indexTag(this, tag);
       }
 
       mutex.unlock();
+
       executeCallback("setTag", std::tuple<std::string, Entity *>({tag, this}));
    }
 
@@ -307,13 +361,26 @@ namespace trogdor::entity {
 
    void Entity::removeTag(std::string tag) {
 
+      bool changed = false;
+
       mutex.lock();
 
-      if (tags.end() != tags.find(tag)) {
-         tags.erase(tag);
+      if (auto slot = strToTagSlot(tag)) {
+         changed = slotTags.test(*slot);
+         slotTags.reset(*slot);
+      }
+
+      else if (customTags->end() != customTags->find(tag)) {
+         customTags.write().erase(tag);
+         changed = true;
+      }
+
+      if (changed && game) {
+         game->unindexTag(this, tag);
       }
 
       mutex.unlock();
+
       executeCallback("removeTag", std::tuple<std::string, Entity *>({tag, this}));
    }
 
@@ -332,10 +399,10 @@ namespace trogdor::entity {
 
       if (
          ENTITY_PLAYER == observer->getType() &&
-         isPropertySet(ShortDescProperty) &&
-         getProperty<std::string>(ShortDescProperty).length() > 0
+         isPropertySet(PROPERTY_SLOT_SHORT_DESC) &&
+         getProperty<std::string>(PROPERTY_SLOT_SHORT_DESC).length() > 0
       ) {
-         observer->out("display") << getProperty<std::string>(ShortDescProperty) << std::endl;
+         observer->out("display") << getProperty<std::string>(PROPERTY_SLOT_SHORT_DESC) << std::endl;
       }
    }
 }
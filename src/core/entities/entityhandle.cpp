@@ -0,0 +1,97 @@
+#include <trogdor/entities/entityhandle.h>
+
+namespace trogdor::entity {
+
+
+   void EntityHandleTable::pushFreeSlot(uint32_t index) {
+
+      slots[index].freePos = static_cast<uint32_t>(freeSlots.size());
+      freeSlots.push_back(index);
+   }
+
+   /***************************************************************************/
+
+   void EntityHandleTable::eraseFreeSlot(uint32_t index) {
+
+      uint32_t pos = slots[index].freePos;
+
+      freeSlots[pos] = freeSlots.back();
+      slots[freeSlots[pos]].freePos = pos;
+      freeSlots.pop_back();
+   }
+
+   /***************************************************************************/
+
+   EntityHandle EntityHandleTable::insert(Entity *entity) {
+
+      uint32_t index;
+
+      if (freeSlots.size()) {
+         index = freeSlots.back();
+         freeSlots.pop_back();
+      }
+
+      else {
+         index = static_cast<uint32_t>(slots.size());
+         slots.push_back({});
+      }
+
+      slots[index].entity = entity;
+      return {index, slots[index].generation};
+   }
+
+   /***************************************************************************/
+
+   bool EntityHandleTable::insert(EntityHandle handle, Entity *entity) {
+
+      if (handle.isNull()) {
+         return false;
+      }
+
+      // Any slots we have to skip over to get to the requested index are
+      // free for later use
+      while (slots.size() <= handle.index) {
+         slots.push_back({});
+         pushFreeSlot(static_cast<uint32_t>(slots.size() - 1));
+      }
+
+      if (slots[handle.index].entity) {
+         return false;
+      }
+
+      eraseFreeSlot(handle.index);
+
+      slots[handle.index].entity = entity;
+      slots[handle.index].generation = handle.generation;
+
+      return true;
+   }
+
+   /***************************************************************************/
+
+   void EntityHandleTable::remove(EntityHandle handle) {
+
+      if (!resolve(handle)) {
+         return;
+      }
+
+      Slot &slot = slots[handle.index];
+
+      slot.entity = nullptr;
+
+      // Generation 0 is reserved for null handles
+      if (!++slot.generation) {
+         slot.generation = 1;
+      }
+
+      pushFreeSlot(handle.index);
+   }
+
+   /***************************************************************************/
+
+   void EntityHandleTable::clear() {
+
+      slots.clear();
+      freeSlots.clear();
+   }
+}
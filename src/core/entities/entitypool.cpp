@@ -0,0 +1,178 @@
+#include <trogdor/entities/entitypool.h>
+#include <trogdor/entities/room.h>
+#include <trogdor/entities/object.h>
+#include <trogdor/entities/creature.h>
+#include <trogdor/entities/resource.h>
+
+#include <trogdor/exception/undefinedexception.h>
+
+namespace trogdor::entity {
+
+
+   void EntityPool::grow(Bucket &bucket, size_t n) {
+
+      std::unique_ptr<std::byte[]> chunk(new std::byte[bucket.blockSize * n]);
+
+      bucket.freeBlocks.reserve(bucket.freeBlocks.size() + n);
+
+      // Push in reverse order so blocks get handed out front to back
+      for (size_t i = n; i > 0; i--) {
+         bucket.freeBlocks.push_back(chunk.get() + (i - 1) * bucket.blockSize);
+      }
+
+      bucket.chunks.push_back(std::move(chunk));
+   }
+
+   /***************************************************************************/
+
+   void *EntityPool::allocate(EntityType type, size_t size) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+      Bucket &bucket = buckets[type];
+
+      if (!bucket.blockSize) {
+         bucket.blockSize = toBlockSize(size);
+      }
+
+      if (bucket.freeBlocks.empty()) {
+         grow(bucket, blocksPerChunk);
+      }
+
+      void *block = bucket.freeBlocks.back();
+
+      bucket.freeBlocks.pop_back();
+      bucket.inUse++;
+
+      return block;
+   }
+
+   /***************************************************************************/
+
+   void EntityPool::deallocate(EntityType type, void *block) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+      Bucket &bucket = buckets[type];
+
+      bucket.freeBlocks.push_back(block);
+      bucket.inUse--;
+   }
+
+   /***************************************************************************/
+
+   void EntityPool::destroy(Entity *e) {
+
+      // Grab the type before the destructor tears down the Entity
+      EntityType type = e->getType();
+
+      e->~Entity();
+      deallocate(type, e);
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<Entity> EntityPool::share(
+      const std::shared_ptr<EntityPool> &pool,
+      Entity *e
+   ) {
+
+      return std::shared_ptr<Entity>(e, [pool](Entity *e) {
+         pool->destroy(e);
+      });
+   }
+
+   /***************************************************************************/
+
+   void EntityPool::reserve(EntityType type, size_t n) {
+
+      size_t size;
+
+      switch (type) {
+
+         case ENTITY_ROOM:
+            size = sizeof(Room);
+            break;
+
+         case ENTITY_OBJECT:
+            size = sizeof(Object);
+            break;
+
+         case ENTITY_CREATURE:
+            size = sizeof(Creature);
+            break;
+
+         case ENTITY_RESOURCE:
+            size = sizeof(Resource);
+            break;
+
+         default:
+            throw UndefinedException(
+               std::string("Entities of type ") + Entity::typeToStr(type)
+               + " can't be pooled"
+            );
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      Bucket &bucket = buckets[type];
+
+      if (!bucket.blockSize) {
+         bucket.blockSize = toBlockSize(size);
+      }
+
+      if (bucket.freeBlocks.size() < n) {
+         grow(bucket, n - bucket.freeBlocks.size());
+      }
+   }
+
+   /***************************************************************************/
+
+   EntityPool::Occupancy EntityPool::getOccupancy(EntityType type) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+      auto bucket = buckets.find(type);
+
+      if (buckets.end() == bucket) {
+         return {0, 0, 0};
+      }
+
+      return {
+         bucket->second.inUse,
+         bucket->second.inUse + bucket->second.freeBlocks.size(),
+         bucket->second.blockSize
+      };
+   }
+
+   /***************************************************************************/
+
+   std::unordered_map<EntityType, EntityPool::Occupancy, std::hash<int>>
+   EntityPool::getOccupancy() {
+
+      std::lock_guard<std::mutex> lock(mutex);
+      std::unordered_map<EntityType, Occupancy, std::hash<int>> occupancy;
+
+      for (const auto &bucket: buckets) {
+         occupancy[bucket.first] = {
+            bucket.second.inUse,
+            bucket.second.inUse + bucket.second.freeBlocks.size(),
+            bucket.second.blockSize
+         };
+      }
+
+      return occupancy;
+   }
+
+   /***************************************************************************/
+
+   EntityPool::MemoryUsage EntityPool::getMemoryUsage() {
+
+      std::lock_guard<std::mutex> lock(mutex);
+      MemoryUsage usage = {0, 0};
+
+      for (const auto &bucket: buckets) {
+         usage.bytesInUse += bucket.second.inUse * bucket.second.blockSize;
+         usage.bytesReserved += (bucket.second.inUse + bucket.second.freeBlocks.size()) *
+            bucket.second.blockSize;
+      }
+
+      return usage;
+   }
+}
@@ -9,8 +9,8 @@ namespace trogdor::entity {
 
    void Object::setPropertyValidators() {
 
-      setPropertyValidator(WeightProperty, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
-      setPropertyValidator(DamageProperty, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
+      setPropertyValidator(PROPERTY_SLOT_WEIGHT, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
+      setPropertyValidator(PROPERTY_SLOT_DAMAGE, [&](PropertyValue v) -> int {return isPropertyValueInt(v);});
    }
 
    /***************************************************************************/
@@ -26,11 +26,11 @@ namespace trogdor::entity {
          setTag(WeaponTag);
       }
 
-      setProperty(WeightProperty, DEFAULT_WEIGHT);
-      setProperty(DamageProperty, DEFAULT_DAMAGE);
+      setProperty(PROPERTY_SLOT_WEIGHT, DEFAULT_WEIGHT);
+      setProperty(PROPERTY_SLOT_DAMAGE, DEFAULT_DAMAGE);
 
       setPropertyValidators();
-      types.push_back(ENTITY_OBJECT);
+      setType(ENTITY_OBJECT);
       setClass("object");
    }
 
@@ -49,7 +49,7 @@ namespace trogdor::entity {
    ): Thing(g, data, std::move(o), std::move(e)) {
 
       setPropertyValidators();
-      types.push_back(ENTITY_OBJECT);
+      setType(ENTITY_OBJECT);
    }
 
    /***************************************************************************/
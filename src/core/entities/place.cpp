@@ -1,5 +1,6 @@
 #include <cmath>
 #include <memory>
+#include <algorithm>
 
 #include <trogdor/entities/place.h>
 #include <trogdor/entities/thing.h>
@@ -22,13 +23,13 @@ namespace trogdor::entity {
       std::unique_ptr<Trogerr> e
    ): Tangible(g, n, std::move(o), std::move(e)) {
 
-      types.push_back(ENTITY_PLACE);
+      setType(ENTITY_PLACE);
       static_cast<PlaceOut *>(outStream.get())->setPlace(this);
    }
 
    /***************************************************************************/
 
-   Place::Place(const Place &p, std::string n): Tangible(p, n) {}
+   Place::Place(const Place &p, std::string n): Tangible(p, n), preserveOrder(p.preserveOrder) {}
 
    /***************************************************************************/
 
@@ -39,6 +40,10 @@ namespace trogdor::entity {
       std::unique_ptr<Trogerr> e
    ): Tangible(g, data, std::move(o), std::move(e)) {
 
+      if (auto preserve = data.get("preserveOrder")) {
+         preserveOrder = std::get<bool>(*preserve);
+      }
+
       g->addCallback("afterDeserialize",
       std::make_shared<Entity::EntityCallback>([&](std::any) -> bool {
 
@@ -57,7 +62,7 @@ namespace trogdor::entity {
          return true;
       }));
 
-      types.push_back(ENTITY_PLACE);
+      setType(ENTITY_PLACE);
    }
 
    /***************************************************************************/
@@ -72,67 +77,279 @@ namespace trogdor::entity {
       }
 
       data->set("things", serializedThings);
+      data->set("preserveOrder", preserveOrder);
+
       return data;
    }
 
    /****************************************************************************/
 
-   void Place::insertPlayer(const std::shared_ptr<Player> &player) {
+   template <typename T>
+   void Place::insertContents(
+      std::vector<std::shared_ptr<T>> &contents,
+      const std::shared_ptr<T> &thing,
+      ContentsSlot slot
+   ) {
 
-      mutex.lock();
+      static_cast<Thing *>(thing.get())->contentsIndex[slot] = contents.size();
+      contents.push_back(thing);
+   }
+
+   /****************************************************************************/
+
+   template <typename T>
+   void Place::removeContents(
+      std::vector<std::shared_ptr<T>> &contents,
+      T *thing,
+      ContentsSlot slot
+   ) {
+
+      size_t i = static_cast<Thing *>(thing)->contentsIndex[slot];
+
+      // The recorded position can only be stale if the Thing was inserted
+      // into more than one Place, so fall back on a search in that case
+      if (i >= contents.size() || contents[i].get() != thing) {
 
-      things.insert(things.end(), player);
-      beings.insert(beings.end(), player);
-      players.insert(players.end(), player);
+         auto it = std::find_if(contents.begin(), contents.end(), [&](const auto &t) {
+            return t.get() == thing;
+         });
 
-      // Index by alias
-      for (const auto &alias: player->getAliases()) {
-         thingsByName[alias].push_back(player.get());
-         beingsByName[alias].push_back(player.get());
-         playersByName[alias].push_back(player.get());
+         if (contents.end() == it) {
+            return;
+         }
+
+         i = it - contents.begin();
       }
 
-      mutex.unlock();
-      player->setLocation(getShared());
+      if (preserveOrder) {
+
+         contents.erase(contents.begin() + i);
+
+         for (; i < contents.size(); i++) {
+            static_cast<Thing *>(contents[i].get())->contentsIndex[slot] = i;
+         }
+      }
+
+      else {
+
+         if (i != contents.size() - 1) {
+            contents[i] = std::move(contents.back());
+            static_cast<Thing *>(contents[i].get())->contentsIndex[slot] = i;
+         }
+
+         contents.pop_back();
+      }
    }
 
    /****************************************************************************/
 
-   void Place::insertCreature(const std::shared_ptr<Creature> &creature) {
+   template <typename T>
+   void Place::indexAliases(std::unordered_map<std::string, std::vector<T *>> &index, T *thing, ContentsSlot slot) {
 
-      mutex.lock();
+      Thing *t = static_cast<Thing *>(thing);
+
+      t->aliasIndex.resize(t->aliases.size());
+
+      for (size_t i = 0; i < t->aliases.size(); i++) {
+
+         auto &matches = index[t->aliases[i]];
+
+         t->aliasIndex[i][slot] = matches.size();
+         matches.push_back(thing);
+      }
+   }
+
+   /****************************************************************************/
+
+   template <typename T>
+   void Place::unindexAliases(std::unordered_map<std::string, std::vector<T *>> &index, T *thing, ContentsSlot slot) {
+
+      Thing *t = static_cast<Thing *>(thing);
+
+      // Records that another Thing has moved to position i in the list for
+      // one of its aliases
+      auto setPosition = [slot](Thing *moved, const std::string &alias, size_t i) {
+
+         size_t aliasNum = std::find(moved->aliases.begin(), moved->aliases.end(), alias) - moved->aliases.begin();
+
+         if (aliasNum < moved->aliasIndex.size()) {
+            moved->aliasIndex[aliasNum][slot] = i;
+         }
+      };
+
+      for (size_t aliasNum = 0; aliasNum < t->aliases.size(); aliasNum++) {
+
+         const std::string &alias = t->aliases[aliasNum];
+         auto entry = index.find(alias);
+
+         if (index.end() == entry) {
+            continue;
+         }
+
+         auto &matches = entry->second;
+
+         // Aliases added by Thing::addAlias() aren't indexed yet when it
+         // removes the Thing to re-insert it, so they have no position
+         size_t i = aliasNum < t->aliasIndex.size() ? t->aliasIndex[aliasNum][slot] : matches.size();
+
+         // As with removeContents(), the recorded position can only be stale
+         // if the Thing was inserted into more than one Place
+         if (i >= matches.size() || matches[i] != thing) {
+
+            auto it = std::find(matches.begin(), matches.end(), thing);
+
+            if (matches.end() == it) {
+               continue;
+            }
+
+            i = it - matches.begin();
+         }
+
+         if (preserveOrder) {
+
+            matches.erase(matches.begin() + i);
+
+            for (; i < matches.size(); i++) {
+               setPosition(static_cast<Thing *>(matches[i]), alias, i);
+            }
+         }
+
+         else {
+
+            if (i != matches.size() - 1) {
+               matches[i] = matches.back();
+               setPosition(static_cast<Thing *>(matches[i]), alias, i);
+            }
+
+            matches.pop_back();
+         }
+
+         if (matches.empty()) {
+            index.erase(entry);
+         }
+      }
+   }
+
+   /****************************************************************************/
+
+   void Place::insertThingUnlocked(const std::shared_ptr<Thing> &thing) {
+
+      insertContents(things, thing, CONTENTS_SLOT_THINGS);
+      indexAliases(thingsByName, thing.get(), CONTENTS_SLOT_THINGS);
+
+      switch (thing->getType()) {
+
+         case ENTITY_PLAYER: {
+
+            auto player = std::static_pointer_cast<Player>(thing);
+
+            insertContents<Being>(beings, player, CONTENTS_SLOT_BEINGS);
+            insertContents(players, player, CONTENTS_SLOT_TYPED);
+            indexAliases<Being>(beingsByName, player.get(), CONTENTS_SLOT_BEINGS);
+            indexAliases(playersByName, player.get(), CONTENTS_SLOT_TYPED);
+
+            break;
+         }
+
+         case ENTITY_CREATURE: {
+
+            auto creature = std::static_pointer_cast<Creature>(thing);
+
+            insertContents<Being>(beings, creature, CONTENTS_SLOT_BEINGS);
+            insertContents(creatures, creature, CONTENTS_SLOT_TYPED);
+            indexAliases<Being>(beingsByName, creature.get(), CONTENTS_SLOT_BEINGS);
+            indexAliases(creaturesByName, creature.get(), CONTENTS_SLOT_TYPED);
+
+            break;
+         }
 
-      things.insert(things.end(), creature);
-      beings.insert(beings.end(), creature);
-      creatures.insert(creatures.end(), creature);
+         default: {
 
-      // Index by alias
-      for (const auto &alias: creature->getAliases()) {
-         thingsByName[alias].push_back(creature.get());
-         beingsByName[alias].push_back(creature.get());
-         creaturesByName[alias].push_back(creature.get());
+            auto object = std::static_pointer_cast<Object>(thing);
+
+            insertContents(objects, object, CONTENTS_SLOT_TYPED);
+            indexAliases(objectsByName, object.get(), CONTENTS_SLOT_TYPED);
+
+            break;
+         }
+      }
+   }
+
+   /****************************************************************************/
+
+   void Place::removeThingUnlocked(Thing *thing) {
+
+      switch (thing->getType()) {
+
+         case ENTITY_PLAYER: {
+
+            auto player = static_cast<Player *>(thing);
+
+            unindexAliases(playersByName, player, CONTENTS_SLOT_TYPED);
+            unindexAliases<Being>(beingsByName, player, CONTENTS_SLOT_BEINGS);
+            removeContents(players, player, CONTENTS_SLOT_TYPED);
+            removeContents<Being>(beings, player, CONTENTS_SLOT_BEINGS);
+
+            break;
+         }
+
+         case ENTITY_CREATURE: {
+
+            auto creature = static_cast<Creature *>(thing);
+
+            unindexAliases(creaturesByName, creature, CONTENTS_SLOT_TYPED);
+            unindexAliases<Being>(beingsByName, creature, CONTENTS_SLOT_BEINGS);
+            removeContents(creatures, creature, CONTENTS_SLOT_TYPED);
+            removeContents<Being>(beings, creature, CONTENTS_SLOT_BEINGS);
+
+            break;
+         }
+
+         default: {
+
+            auto object = static_cast<Object *>(thing);
+
+            unindexAliases(objectsByName, object, CONTENTS_SLOT_TYPED);
+            removeContents(objects, object, CONTENTS_SLOT_TYPED);
+
+            break;
+         }
       }
 
+      unindexAliases(thingsByName, thing, CONTENTS_SLOT_THINGS);
+      removeContents(things, thing, CONTENTS_SLOT_THINGS);
+   }
+
+   /****************************************************************************/
+
+   void Place::insertPlayer(const std::shared_ptr<Player> &player) {
+
+      mutex.lock();
+      insertThingUnlocked(player);
       mutex.unlock();
-      creature->setLocation(getShared());
+
+      player->setLocation(getShared());
    }
 
    /****************************************************************************/
 
-   void Place::insertObject(const std::shared_ptr<Object> &object) {
+   void Place::insertCreature(const std::shared_ptr<Creature> &creature) {
 
       mutex.lock();
+      insertThingUnlocked(creature);
+      mutex.unlock();
 
-      things.insert(things.end(), object);
-      objects.insert(objects.end(), object);
+      creature->setLocation(getShared());
+   }
 
-      // Index by alias
-      for (const auto &alias: object->getAliases()) {
-         thingsByName[alias].push_back(object.get());
-         objectsByName[alias].push_back(object.get());
-      }
+   /****************************************************************************/
+
+   void Place::insertObject(const std::shared_ptr<Object> &object) {
 
+      mutex.lock();
+      insertThingUnlocked(object);
       mutex.unlock();
+
       object->setLocation(getShared());
    }
 
@@ -163,63 +380,59 @@ namespace trogdor::entity {
 
    /****************************************************************************/
 
-   void Place::removePlayer(const std::shared_ptr<Player> &player) {
+   void Place::insertThings(const std::vector<std::shared_ptr<Thing>> &newThings) {
 
-      for (const auto &alias: player->getAliases()) {
+      // Make sure everything can be inserted before inserting anything
+      for (const auto &thing: newThings) {
 
-         mutex.lock();
+         switch (thing->getType()) {
 
-         if (playersByName.find(alias) != playersByName.end()) {
-            playersByName.find(alias)->second.remove(player.get());
-         }
+            case ENTITY_PLAYER:
+            case ENTITY_CREATURE:
+            case ENTITY_OBJECT:
+               break;
 
-         if (beingsByName.find(alias) != beingsByName.end()) {
-            beingsByName.find(alias)->second.remove(player.get());
+            default:
+               throw UndefinedException(
+                  std::string("Place::insertThings(): attempting to insert unsupported type '")
+                  + thing->getTypeName() + "'");
          }
+      }
 
-         if (thingsByName.find(alias) != thingsByName.end()) {
-            thingsByName.find(alias)->second.remove(player.get());
-         }
+      mutex.lock();
+
+      things.reserve(things.size() + newThings.size());
 
-         mutex.unlock();
+      for (const auto &thing: newThings) {
+         insertThingUnlocked(thing);
       }
 
-      mutex.lock();
-      players.remove(player);
-      beings.remove(player);
-      things.remove(player);
       mutex.unlock();
 
-      player->setLocation(std::weak_ptr<Place>());
+      std::shared_ptr<Place> self = getShared();
+
+      for (const auto &thing: newThings) {
+         thing->setLocation(self);
+      }
    }
 
    /****************************************************************************/
 
-   void Place::removeCreature(const std::shared_ptr<Creature> &creature) {
-
-      for (const auto &alias: creature->getAliases()) {
-
-         mutex.lock();
+   void Place::removePlayer(const std::shared_ptr<Player> &player) {
 
-         if (creaturesByName.find(alias) != creaturesByName.end()) {
-            creaturesByName.find(alias)->second.remove(creature.get());
-         }
+      mutex.lock();
+      removeThingUnlocked(player.get());
+      mutex.unlock();
 
-         if (beingsByName.find(alias) != beingsByName.end()) {
-            beingsByName.find(alias)->second.remove(creature.get());
-         }
+      player->setLocation(std::weak_ptr<Place>());
+   }
 
-         if (thingsByName.find(alias) != thingsByName.end()) {
-            thingsByName.find(alias)->second.remove(creature.get());
-         }
+   /****************************************************************************/
 
-         mutex.unlock();
-      }
+   void Place::removeCreature(const std::shared_ptr<Creature> &creature) {
 
       mutex.lock();
-      creatures.remove(creature);
-      beings.remove(creature);
-      things.remove(creature);
+      removeThingUnlocked(creature.get());
       mutex.unlock();
 
       creature->setLocation(std::weak_ptr<Place>());
@@ -229,24 +442,8 @@ namespace trogdor::entity {
 
    void Place::removeObject(const std::shared_ptr<Object> &object) {
 
-      for (const auto &alias: object->getAliases()) {
-
-         mutex.lock();
-
-         if (objectsByName.find(alias) != objectsByName.end()) {
-            objectsByName.find(alias)->second.remove(object.get());
-         }
-
-         if (thingsByName.find(alias) != thingsByName.end()) {
-            thingsByName.find(alias)->second.remove(object.get());
-         }
-
-         mutex.unlock();
-      }
-
       mutex.lock();
-      objects.remove(object);
-      things.remove(object);
+      removeThingUnlocked(object.get());
       mutex.unlock();
 
       object->setLocation(std::weak_ptr<Place>());
@@ -290,18 +487,18 @@ namespace trogdor::entity {
             observer->out("display") << std::endl;
 
             // Display quantity as an integer
-            if (resourcePtr->getProperty<bool>(Resource::ReqIntAllocProperty)) {
+            if (resourcePtr->getProperty<bool>(PROPERTY_SLOT_REQ_INT_ALLOC)) {
 
                if (1 == std::lround(resource.second)) {
                   observer->out("display") << "You see a " <<
-                     resourcePtr->getProperty<std::string>(TitleProperty) <<
+                     resourcePtr->getPropertyRef<std::string>(PROPERTY_SLOT_TITLE) <<
                      "." << std::endl;
                }
 
                else {
                   observer->out("display") << "You see " << std::lround(resource.second)
                      << " "
-                     << resourcePtr->getProperty<std::string>(Resource::PluralTitleProperty)
+                     << resourcePtr->getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_TITLE)
                      << "." << std::endl;
                }
             }
@@ -309,7 +506,7 @@ namespace trogdor::entity {
             // Display quantity as a double
             else {
                observer->out("display") << "You see " << resource.second << " "
-                  << resourcePtr->getProperty<std::string>(Resource::PluralTitleProperty)
+                  << resourcePtr->getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_TITLE)
                   << "." << std::endl;
             }
          }
@@ -320,7 +517,11 @@ namespace trogdor::entity {
 
    void Place::displayThings(Being *observer) {
 
-      for (const auto &thing: things) {
+      // Glancing at a Thing triggers events, which might move things in or
+      // out of the Place, so iterate over a copy
+      std::vector<std::shared_ptr<Thing>> visibleThings = things;
+
+      for (const auto &thing: visibleThings) {
 
          // Players should see everything except themselves
          if (observer != static_cast<Being *>(thing.get())) {
@@ -334,10 +535,10 @@ namespace trogdor::entity {
 
    void Place::displayPlace(Being *observer, bool displayFull) {
 
-      observer->out("location") << getProperty<std::string>(TitleProperty);
+      observer->out("location") << getPropertyRef<std::string>(PROPERTY_SLOT_TITLE);
       observer->out("location").flush();
 
-      observer->out("display") << getProperty<std::string>(TitleProperty) <<
+      observer->out("display") << getPropertyRef<std::string>(PROPERTY_SLOT_TITLE) <<
          std::endl << std::endl;
       Tangible::display(observer, displayFull);
    }
@@ -8,7 +8,7 @@ namespace trogdor::entity {
    std::unique_ptr<Trogerr> e): Being(g, n, std::move(o), std::move(e)),
    lastCommand(std::make_unique<Command>(game->getVocabulary(), "")) {
 
-      types.push_back(ENTITY_PLAYER);
+      setType(ENTITY_PLAYER);
       setClass("player");
 
       setProperty("longDesc", name + " is a player.");
@@ -54,7 +54,7 @@ namespace trogdor::entity {
          lastCommand = std::make_unique<Command>(game->getVocabulary(), "");
       }
 
-      types.push_back(ENTITY_PLAYER);
+      setType(ENTITY_PLAYER);
    }
 
    /***************************************************************************/
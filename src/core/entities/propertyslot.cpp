@@ -0,0 +1,83 @@
+#include <string>
+#include <unordered_map>
+
+#include <trogdor/entities/propertyslot.h>
+#include <trogdor/entities/resource.h>
+#include <trogdor/entities/object.h>
+#include <trogdor/entities/creature.h>
+
+namespace trogdor::entity {
+
+
+   // Names of the built-in properties, in slot order
+   static const char *propertySlotNames[] = {
+
+      Entity::TitleProperty,
+      Entity::LongDescProperty,
+      Entity::ShortDescProperty,
+
+      Resource::ReqIntAllocProperty,
+      Resource::AmtAvailProperty,
+      Resource::MaxAmtPerDepositorProperty,
+      Resource::PluralNameProperty,
+      Resource::PluralTitleProperty,
+
+      Object::WeightProperty,
+      Object::DamageProperty,
+
+      Being::HealthProperty,
+      Being::MaxHealthProperty,
+      Being::WoundRateProperty,
+      Being::DamageBareHandsProperty,
+      Being::RespawnEnabledProperty,
+      Being::RespawnIntervalProperty,
+      Being::RespawnLivesProperty,
+      Being::InvMaxWeightProperty,
+
+      Creature::AllegianceProperty,
+      Creature::CounterAttackProperty,
+      Creature::AutoAttackEnabledProperty,
+      Creature::AutoAttackRepeatProperty,
+      Creature::AutoAttackIntervalProperty,
+      Creature::WanderEnabledProperty,
+      Creature::WanderIntervalProperty,
+      Creature::WanderLustProperty,
+      Creature::WanderModeProperty
+   };
+
+   static_assert(
+      sizeof(propertySlotNames) / sizeof(propertySlotNames[0]) == NUM_PROPERTY_SLOTS,
+      "propertySlotNames and enum PropertySlot are out of sync"
+   );
+
+   /***************************************************************************/
+
+   const char *propertySlotToStr(PropertySlot slot) {
+
+      return propertySlotNames[slot];
+   }
+
+   /***************************************************************************/
+
+   std::optional<PropertySlot> strToPropertySlot(std::string_view key) {
+
+      // Built once, the first time a property is looked up by name. The keys
+      // point into string literals, so the views never dangle.
+      static const std::unordered_map<std::string_view, PropertySlot> slots = [] {
+
+         std::unordered_map<std::string_view, PropertySlot> slots;
+
+         for (size_t i = 0; i < NUM_PROPERTY_SLOTS; i++) {
+            slots[propertySlotNames[i]] = static_cast<PropertySlot>(i);
+         }
+
+         return slots;
+      }();
+
+      if (auto slot = slots.find(key); slots.end() != slot) {
+         return slot->second;
+      }
+
+      return std::nullopt;
+   }
+}
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <unordered_map>
+
 #include <trogdor/utility.h>
 
 #include <trogdor/entities/resource.h>
@@ -44,15 +47,15 @@ namespace trogdor::entity {
 
    void Resource::setPropertyValidators() {
 
-      setPropertyValidator(ReqIntAllocProperty, [&](PropertyValue v) -> int {return isPropertyValueBool(v);});
-      setPropertyValidator(PluralNameProperty, [&](PropertyValue v) -> int {return isPropertyValueString(v);});
-      setPropertyValidator(PluralTitleProperty, [&](PropertyValue v) -> int {return isPropertyValueString(v);});
-      setPropertyValidator(MaxAmtPerDepositorProperty, [&](PropertyValue v) -> int {return isPropertyValueDouble(v);});
+      setPropertyValidator(PROPERTY_SLOT_REQ_INT_ALLOC, [&](PropertyValue v) -> int {return isPropertyValueBool(v);});
+      setPropertyValidator(PROPERTY_SLOT_PLURAL_NAME, [&](PropertyValue v) -> int {return isPropertyValueString(v);});
+      setPropertyValidator(PROPERTY_SLOT_PLURAL_TITLE, [&](PropertyValue v) -> int {return isPropertyValueString(v);});
+      setPropertyValidator(PROPERTY_SLOT_MAX_AMT_PER_DEPOSITOR, [&](PropertyValue v) -> int {return isPropertyValueDouble(v);});
 
       // Add property validators after setting initial values of properties for
       // efficiency (I know the defaults are going to be valid, so there's no
       // reason to call a validator.)
-      setPropertyValidator(AmtAvailProperty, [&](PropertyValue value) -> int {
+      setPropertyValidator(PROPERTY_SLOT_AMT_AVAIL, [&](PropertyValue value) -> int {
 
          // Value must be a double (only literals with decimals or integers that
          // are explictly cast to double will pass validation when passed to
@@ -83,19 +86,19 @@ namespace trogdor::entity {
    ): Entity(g, n, std::make_unique<NullOut>(), std::make_unique<NullErr>()) {
 
       if (amountAvailable) {
-         setProperty(AmtAvailProperty, *amountAvailable);
+         setProperty(PROPERTY_SLOT_AMT_AVAIL, *amountAvailable);
       }
 
       if (maxAmountPerDepositor) {
-         setProperty(MaxAmtPerDepositorProperty, *maxAmountPerDepositor);
+         setProperty(PROPERTY_SLOT_MAX_AMT_PER_DEPOSITOR, *maxAmountPerDepositor);
       }
 
-      setProperty(ReqIntAllocProperty, requireIntegerAllocations);
-      setProperty(PluralNameProperty, pluralName ? *pluralName : language.pluralizeNoun(n));
-      setProperty(PluralTitleProperty, getProperty<std::string>(PluralNameProperty));
+      setProperty(PROPERTY_SLOT_REQ_INT_ALLOC, requireIntegerAllocations);
+      setProperty(PROPERTY_SLOT_PLURAL_NAME, pluralName ? *pluralName : language.pluralizeNoun(n));
+      setProperty(PROPERTY_SLOT_PLURAL_TITLE, getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_NAME));
 
       setPropertyValidators();
-      types.push_back(ENTITY_RESOURCE);
+      setType(ENTITY_RESOURCE);
       setClass("resource");
    }
 
@@ -126,12 +129,7 @@ namespace trogdor::entity {
                   game->getTangible(std::get<std::string>(*depositor->get("depositor")));
 
                if (owner) {
-
-                  double amount = std::get<double>(*depositor->get("amount"));
-
-                  depositors[owner] = amount;
-                  owner->recordResourceAllocation(getShared(), amount);
-                  totalAmountAllocated += amount;
+                  allocateRaw(owner, std::get<double>(*depositor->get("amount")));
                }
             }
          }
@@ -139,7 +137,7 @@ namespace trogdor::entity {
          return true;
       }));
 
-      types.push_back(ENTITY_RESOURCE);
+      setType(ENTITY_RESOURCE);
       setPropertyValidators();
    }
 
@@ -180,17 +178,17 @@ namespace trogdor::entity {
       > templateParameters = {
 
          {false, {
-            {"{%title}", getProperty<std::string>(TitleProperty)},
+            {"{%title}", getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)},
             {"{%name}", getName()},
-            {"{%Title}", capitalize(getProperty<std::string>(TitleProperty))},
+            {"{%Title}", capitalize(getPropertyRef<std::string>(PROPERTY_SLOT_TITLE))},
             {"{%Name}", capitalize(getName())}
          }},
 
          {true, {
-            {"{%title}", getProperty<std::string>(PluralTitleProperty)},
-            {"{%name}", getProperty<std::string>(PluralNameProperty)},
-            {"{%Title}", capitalize(getProperty<std::string>(PluralTitleProperty))},
-            {"{%Name}", capitalize(getProperty<std::string>(PluralNameProperty))}
+            {"{%title}", getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_TITLE)},
+            {"{%name}", getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_NAME)},
+            {"{%Title}", capitalize(getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_TITLE))},
+            {"{%Name}", capitalize(getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_NAME))}
          }}
       };
 
@@ -211,19 +209,19 @@ namespace trogdor::entity {
 
       if (ENTITY_PLAYER == observer->getType()) {
 
-         if (isPropertySet(LongDescProperty) && getProperty<std::string>(LongDescProperty).length() > 0) {
-            observer->out("display") << hydrateString(getProperty<std::string>(LongDescProperty), isPlural)
+         if (isPropertySet(PROPERTY_SLOT_LONG_DESC) && getPropertyRef<std::string>(PROPERTY_SLOT_LONG_DESC).length() > 0) {
+            observer->out("display") << hydrateString(getPropertyRef<std::string>(PROPERTY_SLOT_LONG_DESC), isPlural)
                << std::endl;
          }
 
-         else if (isPropertySet(ShortDescProperty) && getProperty<std::string>(ShortDescProperty).length() > 0) {
-            observer->out("display") << hydrateString(getProperty<std::string>(ShortDescProperty), isPlural)
+         else if (isPropertySet(PROPERTY_SLOT_SHORT_DESC) && getPropertyRef<std::string>(PROPERTY_SLOT_SHORT_DESC).length() > 0) {
+            observer->out("display") << hydrateString(getPropertyRef<std::string>(PROPERTY_SLOT_SHORT_DESC), isPlural)
                << std::endl;
          }
 
          else {
             observer->out("display") << "You see " <<
-               (isPlural ? getProperty<std::string>(PluralTitleProperty) : getProperty<std::string>(TitleProperty)) <<
+               (isPlural ? getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_TITLE) : getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)) <<
                '.' << std::endl;
          }
       }
@@ -249,7 +247,7 @@ namespace trogdor::entity {
 
       display(
          observer.get(),
-         getProperty<bool>(ReqIntAllocProperty) && 1 == amount ? false : true
+         getProperty<bool>(PROPERTY_SLOT_REQ_INT_ALLOC) && 1 == amount ? false : true
       );
 
       if (triggerEvents) {
@@ -263,34 +261,120 @@ namespace trogdor::entity {
 
    /***************************************************************************/
 
-   void Resource::allocateRaw(
+   std::optional<size_t> Resource::findDepositor(const std::shared_ptr<Tangible> &entity) {
+
+      auto entry = depositorIndex.find(entity.get());
+
+      if (depositorIndex.end() == entry) {
+         return std::nullopt;
+      }
+
+      const std::weak_ptr<Tangible> &owner = depositors[entry->second].first;
+
+      // A new entity was allocated at the address of one that was destroyed
+      // while still holding some of the resource
+      if (owner.owner_before(entity) || entity.owner_before(owner)) {
+         totalAmountAllocated -= depositors[entry->second].second;
+         removeDepositor(entry->second);
+         return std::nullopt;
+      }
+
+      return entry->second;
+   }
+
+   /***************************************************************************/
+
+   void Resource::removeDepositor(size_t index) {
+
+      depositorIndex.erase(depositorKeys[index]);
+
+      if (index + 1 < depositors.size()) {
+         depositors[index] = std::move(depositors.back());
+         depositorKeys[index] = depositorKeys.back();
+         depositorIndex[depositorKeys[index]] = index;
+      }
+
+      depositors.pop_back();
+      depositorKeys.pop_back();
+   }
+
+   /***************************************************************************/
+
+   void Resource::adjustAllocation(
+      const std::shared_ptr<Resource> &self,
       const std::shared_ptr<Tangible> &entity,
       double amount
    ) {
 
-      auto sharedPtr = getShared();
-      double updatedBalance = amount;
+      std::optional<size_t> index = findDepositor(entity);
+      double updatedBalance = index ? depositors[*index].second + amount : amount;
 
-      mutex.lock();
-      entity->mutex.lock();
+      totalAmountAllocated += amount;
 
-      // If the entity already possesses some amount of the resource, make sure
-      // to take it into account when updating its balance after the allocation
-      if (depositors.end() != depositors.find(entity)) {
-         updatedBalance += depositors[entity];
+      if (updatedBalance <= 0) {
+
+         if (index) {
+            removeDepositor(*index);
+         }
+
+         entity->removeResourceAllocation(self);
       }
 
-      depositors[entity] = updatedBalance;
-      entity->recordResourceAllocation(sharedPtr, updatedBalance);
-      totalAmountAllocated += amount;
+      else if (index) {
+         depositors[*index].second = updatedBalance;
+         entity->recordResourceAllocation(self, updatedBalance);
+      }
+
+      else {
+         depositorIndex[entity.get()] = depositors.size();
+         depositors.push_back({entity, updatedBalance});
+         depositorKeys.push_back(entity.get());
+         entity->recordResourceAllocation(self, updatedBalance);
+      }
+   }
+
+   /***************************************************************************/
+
+   std::vector<std::unique_lock<std::mutex>> Resource::lockDepositors(
+      std::vector<Tangible *> entities
+   ) {
+
+      std::vector<std::unique_lock<std::mutex>> locks;
+
+      std::sort(entities.begin(), entities.end(), std::less<Tangible *>());
+      entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+      locks.reserve(entities.size());
 
-      if (depositors[entity] <= 0) {
-         depositors.erase(entity);
-         entity->removeResourceAllocation(sharedPtr);
+      for (const auto &entity: entities) {
+         locks.emplace_back(entity->mutex);
       }
 
-      entity->mutex.unlock();
-      mutex.unlock();
+      return locks;
+   }
+
+   /***************************************************************************/
+
+   void Resource::allocateRaw(
+      const std::shared_ptr<Tangible> &entity,
+      double amount
+   ) {
+
+      auto sharedPtr = getShared();
+
+      std::lock_guard<std::mutex> lock(mutex);
+      std::lock_guard<std::mutex> entityLock(entity->mutex);
+
+      adjustAllocation(sharedPtr, entity, amount);
+   }
+
+   /***************************************************************************/
+
+   double Resource::getAllocation(const std::shared_ptr<Tangible> &entity) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+      std::optional<size_t> index = findDepositor(entity);
+
+      return index ? depositors[*index].second : 0;
    }
 
    /***************************************************************************/
@@ -322,7 +406,7 @@ namespace trogdor::entity {
          return ALLOCATE_ZERO_OR_NEGATIVE_AMOUNT;
       }
 
-      if (getProperty<bool>(ReqIntAllocProperty)) {
+      if (getProperty<bool>(PROPERTY_SLOT_REQ_INT_ALLOC)) {
 
          double intPart, fracPart = modf(amount, &intPart);
 
@@ -341,8 +425,8 @@ namespace trogdor::entity {
       }
 
       if (
-         isPropertySet(AmtAvailProperty) &&
-         amount + totalAmountAllocated > getProperty<double>(AmtAvailProperty)
+         isPropertySet(PROPERTY_SLOT_AMT_AVAIL) &&
+         amount + totalAmountAllocated > getProperty<double>(PROPERTY_SLOT_AMT_AVAIL)
       ) {
 
          if (triggerEvents) {
@@ -358,15 +442,11 @@ namespace trogdor::entity {
 
       // If the entity already possesses some amount of the resource, make sure
       // to take it into account when updating its balance after the allocation
-      double updatedBalance = amount;
-
-      if (depositors.end() != depositors.find(entity)) {
-         updatedBalance += depositors[entity];
-      }
+      double updatedBalance = amount + getAllocation(entity);
 
       if (
-         isPropertySet(MaxAmtPerDepositorProperty) &&
-         updatedBalance > getProperty<double>(MaxAmtPerDepositorProperty)
+         isPropertySet(PROPERTY_SLOT_MAX_AMT_PER_DEPOSITOR) &&
+         updatedBalance > getProperty<double>(PROPERTY_SLOT_MAX_AMT_PER_DEPOSITOR)
       ) {
 
          if (triggerEvents) {
@@ -422,7 +502,7 @@ namespace trogdor::entity {
          return FREE_NEGATIVE_VALUE;
       }
 
-      if (getProperty<bool>(ReqIntAllocProperty)) {
+      if (getProperty<bool>(PROPERTY_SLOT_REQ_INT_ALLOC)) {
 
          double intPart, fracPart = modf(amount, &intPart);
 
@@ -440,10 +520,11 @@ namespace trogdor::entity {
          }
       }
 
-      if (
-         depositors.end() == depositors.find(entity) ||
-         depositors[entity] < amount
-      ) {
+      double balance = getAllocation(entity);
+
+      // Depositors always hold a positive amount, so a balance of 0 means the
+      // entity doesn't have any of the resource to free
+      if (balance <= 0 || balance < amount) {
 
          if (triggerEvents) {
             game->event({
@@ -458,7 +539,7 @@ namespace trogdor::entity {
 
       // Free everything
       if (0 == amount) {
-         amount = depositors[entity];
+         amount = balance;
       }
 
       allocateRaw(entity, -amount);
@@ -491,47 +572,191 @@ namespace trogdor::entity {
          return ALLOCATE_OR_FREE_ABORT;
       }
 
-      // The transfer should be transactional
-      transferMutex.lock();
+      AllocationStatus status = ALLOCATE_OR_FREE_SUCCESS;
+      double requested = amount;
+      double intPart, fracPart = modf(amount, &intPart);
 
-      auto status = free(depositor, amount, false);
+      if (amount < 0) {
+         status = FREE_NEGATIVE_VALUE;
+      }
 
-      if (ALLOCATE_OR_FREE_SUCCESS != status) {
+      else if (getProperty<bool>(PROPERTY_SLOT_REQ_INT_ALLOC) && fracPart) {
+         status = FREE_INT_REQUIRED;
+      }
 
-         game->event({
-            "transferResourceCantFree",
-            {triggers.get(), depositor->getEventListener(), beneficiary->getEventListener()},
-            {this, depositor.get(), beneficiary.get(), amount}
-         });
+      else {
+
+         auto sharedPtr = getShared();
+
+         // Both sides of the transfer are checked and made under the same
+         // locks, so nobody can change either balance in between
+         std::lock_guard<std::mutex> lock(mutex);
+         auto entityLocks = lockDepositors({depositor.get(), beneficiary.get()});
+
+         std::optional<size_t> index = findDepositor(depositor);
+         double balance = index ? depositors[*index].second : 0;
+
+         if (!index || balance < amount) {
+            status = FREE_EXCEEDS_ALLOCATION;
+         }
+
+         else {
 
-         transferMutex.unlock();
-         return status;
+            // Transfer everything
+            if (0 == amount) {
+               amount = balance;
+            }
+
+            if (depositor != beneficiary) {
+
+               std::optional<size_t> beneficiaryIndex = findDepositor(beneficiary);
+               double beneficiaryBalance = beneficiaryIndex ? depositors[*beneficiaryIndex].second : 0;
+
+               if (
+                  isPropertySet(PROPERTY_SLOT_MAX_AMT_PER_DEPOSITOR) &&
+                  beneficiaryBalance + amount > getProperty<double>(PROPERTY_SLOT_MAX_AMT_PER_DEPOSITOR)
+               ) {
+                  status = ALLOCATE_MAX_PER_DEPOSITOR_EXCEEDED;
+               }
+
+               else {
+                  adjustAllocation(sharedPtr, depositor, -amount);
+                  adjustAllocation(sharedPtr, beneficiary, amount);
+               }
+            }
+         }
       }
 
-      status = allocate(beneficiary, amount, false);
+      if (triggerEvents) {
 
-      if (ALLOCATE_OR_FREE_SUCCESS != status) {
+         if (ALLOCATE_MAX_PER_DEPOSITOR_EXCEEDED == status) {
+            game->event({
+               "transferResourceCantAllocate",
+               {triggers.get(), depositor->getEventListener(), beneficiary->getEventListener()},
+               {this, depositor.get(), beneficiary.get(), requested}
+            });
+         }
 
-         game->event({
-            "transferResourceCantAllocate",
-            {triggers.get(), depositor->getEventListener(), beneficiary->getEventListener()},
-            {this, depositor.get(), beneficiary.get(), amount}
-         });
+         else if (ALLOCATE_OR_FREE_SUCCESS != status) {
+            game->event({
+               "transferResourceCantFree",
+               {triggers.get(), depositor->getEventListener(), beneficiary->getEventListener()},
+               {this, depositor.get(), beneficiary.get(), requested}
+            });
+         }
+
+         else {
+            game->event({
+               "afterTransferResource",
+               {triggers.get(), depositor->getEventListener(), beneficiary->getEventListener()},
+               {this, depositor.get(), beneficiary.get(), amount}
+            });
+         }
+      }
 
-         // Return the depositor's previous allocation because the transfer failed
-         allocateRaw(depositor, amount);
+      return status;
+   }
+
+   /***************************************************************************/
 
-         transferMutex.unlock();
-         return status;
+   Resource::AllocationStatus Resource::transferMany(
+      const std::vector<Transfer> &transfers,
+      bool triggerEvents
+   ) {
+
+      double total = 0;
+
+      for (const auto &transfer: transfers) {
+         total += transfer.amount;
       }
 
-      transferMutex.unlock();
+      if (triggerEvents && !game->event({
+         "beforeTransferResources",
+         {triggers.get()},
+         {this, static_cast<int>(transfers.size()), total}
+      })) {
+         return ALLOCATE_OR_FREE_ABORT;
+      }
 
-      game->event({
-         "afterTransferResource",
-         {triggers.get(), depositor->getEventListener(), beneficiary->getEventListener()},
-         {this, depositor.get(), beneficiary.get(), amount}
-      });
+      bool requireInt = getProperty<bool>(PROPERTY_SLOT_REQ_INT_ALLOC);
+
+      // Each entity's net change across the whole batch, in the order they
+      // first appear
+      std::vector<std::pair<std::shared_ptr<Tangible>, double>> deltas;
+      std::unordered_map<Tangible *, size_t> deltaIndex;
+      std::vector<Tangible *> entities;
+
+      auto addDelta = [&](const std::shared_ptr<Tangible> &entity, double amount) {
+
+         auto entry = deltaIndex.find(entity.get());
+
+         if (deltaIndex.end() == entry) {
+            deltaIndex[entity.get()] = deltas.size();
+            deltas.push_back({entity, amount});
+            entities.push_back(entity.get());
+         }
+
+         else {
+            deltas[entry->second].second += amount;
+         }
+      };
+
+      for (const auto &transfer: transfers) {
+
+         double intPart, fracPart = modf(transfer.amount, &intPart);
+
+         if (transfer.amount < 0) {
+            return FREE_NEGATIVE_VALUE;
+         }
+
+         else if (requireInt && fracPart) {
+            return FREE_INT_REQUIRED;
+         }
+
+         else if (transfer.amount > 0 && transfer.depositor != transfer.beneficiary) {
+            addDelta(transfer.depositor, -transfer.amount);
+            addDelta(transfer.beneficiary, transfer.amount);
+         }
+      }
+
+      {
+         auto sharedPtr = getShared();
+
+         std::lock_guard<std::mutex> lock(mutex);
+         auto entityLocks = lockDepositors(entities);
+
+         std::optional<double> maxPerDepositor = isPropertySet(PROPERTY_SLOT_MAX_AMT_PER_DEPOSITOR) ?
+            std::optional<double>(getProperty<double>(PROPERTY_SLOT_MAX_AMT_PER_DEPOSITOR)) : std::nullopt;
+
+         // Check every balance before touching any of them
+         for (const auto &delta: deltas) {
+
+            std::optional<size_t> index = findDepositor(delta.first);
+            double balance = index ? depositors[*index].second : 0;
+
+            if (balance + delta.second < 0) {
+               return FREE_EXCEEDS_ALLOCATION;
+            }
+
+            else if (delta.second > 0 && maxPerDepositor && balance + delta.second > *maxPerDepositor) {
+               return ALLOCATE_MAX_PER_DEPOSITOR_EXCEEDED;
+            }
+         }
+
+         for (const auto &delta: deltas) {
+            if (delta.second) {
+               adjustAllocation(sharedPtr, delta.first, delta.second);
+            }
+         }
+      }
+
+      if (triggerEvents) {
+         game->event({
+            "afterTransferResources",
+            {triggers.get()},
+            {this, static_cast<int>(transfers.size()), total}
+         });
+      }
 
       return ALLOCATE_OR_FREE_SUCCESS;
    }
@@ -14,7 +14,7 @@ namespace trogdor::entity {
       std::unique_ptr<Trogerr> e
    ): Place(g, n, std::move(o), std::move(e)) {
 
-      types.push_back(ENTITY_ROOM);
+      setType(ENTITY_ROOM);
       setClass("room");
    }
 
@@ -24,6 +24,7 @@ namespace trogdor::entity {
 
       // TODO: trying to decide if this makes sense?
       connections = r.connections;
+      connectedDirections = r.connectedDirections;
    }
 
    /***************************************************************************/
@@ -41,28 +42,40 @@ namespace trogdor::entity {
          std::shared_ptr<serial::Serializable> serializedConnections =
             std::get<std::shared_ptr<serial::Serializable>>(*data.get("connections"));
 
+         std::shared_ptr<serial::Serializable> serializedConnectionDescriptions;
+
+         if (data.get("connectionDescriptions")) {
+            serializedConnectionDescriptions =
+               std::get<std::shared_ptr<serial::Serializable>>(*data.get("connectionDescriptions"));
+         }
+
          for (const auto &connection: serializedConnections->getAll()) {
 
             if (const std::shared_ptr<Room> &roomPtr =
             game->getRoom(std::get<std::string>((connection.second)))) {
-               connections[connection.first] = roomPtr;
-            }
-         }
 
-         if (data.get("connectionDescriptions")) {
+               // Directions added at runtime aren't part of the serialized
+               // game, so make sure the vocabulary knows about them
+               if (!game->getVocabulary().isDirection(connection.first)) {
+                  game->insertDirection(connection.first);
+               }
 
-            std::shared_ptr<serial::Serializable> serializedConnectionDescriptions =
-               std::get<std::shared_ptr<serial::Serializable>>(*data.get("connectionDescriptions"));
+               std::optional<std::string> description;
+
+               if (serializedConnectionDescriptions) {
+                  if (auto d = serializedConnectionDescriptions->get(connection.first)) {
+                     description = std::get<std::string>(*d);
+                  }
+               }
 
-            for (const auto &description: serializedConnectionDescriptions->getAll()) {
-               connectionDescriptions[description.first] = std::get<std::string>(description.second);
+               setConnection(connection.first, roomPtr, description);
             }
          }
 
          return true;
       }));
 
-      types.push_back(ENTITY_ROOM);
+      setType(ENTITY_ROOM);
    }
 
    /****************************************************************************/
@@ -71,20 +84,11 @@ namespace trogdor::entity {
 
       if (!observedBy(observer->getShared()) || displayFull) {
 
-         std::vector<std::string> toRemove;
-
-         for (const auto &description: connectionDescriptions) {
-            if (getConnection(description.first)) {
-               observer->out("display") << std::endl << description.second << std::endl;
-            } else {
-               toRemove.push_back(description.first);
+         for (size_t i = 0; i < connections.size(); i++) {
+            if (connections[i].description.length() && getConnection(i)) {
+               observer->out("display") << std::endl << connections[i].description << std::endl;
             }
          }
-
-         // If we encountered any stale connection descriptions, remove them.
-         for (const auto &badConnection: toRemove) {
-            connectionDescriptions[badConnection].erase();
-         }
       }
    }
 
@@ -106,15 +110,21 @@ namespace trogdor::entity {
       std::shared_ptr<serial::Serializable> serializedConnections = std::make_shared<serial::Serializable>();
       std::shared_ptr<serial::Serializable> serializedConnectionDescriptions = std::make_shared<serial::Serializable>();
 
-      for (const auto &connection: connections) {
-         if (const auto &connectedRoom = connection.second.lock()) {
-            serializedConnections->set(connection.first, connectedRoom->getName());
+      for (size_t i = 0; i < connections.size(); i++) {
+
+         if (!connections[i].connected) {
+            continue;
          }
-      }
 
-      for (const auto &description: connectionDescriptions) {
-         if (getConnection(description.first)) {
-            serializedConnectionDescriptions->set(description.first, description.second);
+         else if (const auto &connectedRoom = connections[i].room.lock()) {
+
+            const std::string &direction = game->getVocabulary().getDirectionName(i);
+
+            serializedConnections->set(direction, connectedRoom->getName());
+
+            if (connections[i].description.length()) {
+               serializedConnectionDescriptions->set(direction, connections[i].description);
+            }
          }
       }
 
@@ -126,41 +136,54 @@ namespace trogdor::entity {
 
    /**************************************************************************/
 
-   std::shared_ptr<Room> Room::getConnectionByIndex(size_t i) {
-
-      std::string direction;
-      std::weak_ptr<Room> connection;
+   void Room::removeConnectionUnlocked(size_t directionId) {
 
-      if (0 == getNumConnections()) {
-         return std::shared_ptr<Room>();
+      if (directionId >= connections.size() || !connections[directionId].connected) {
+         return;
       }
 
-      else if (i > getNumConnections() - 1) {
-         direction = connections.begin()->first;
-         connection = connections.begin()->second;
-      }
+      size_t position = connections[directionId].position;
 
-      else {
+      // Move the last connected direction into the removed one's spot
+      connectedDirections[position] = connectedDirections.back();
+      connections[connectedDirections[position]].position = position;
+      connectedDirections.pop_back();
 
-         auto c = connections.begin();
+      connections[directionId] = Connection();
+   }
 
-         for (; i > 0; i--) {
-            c++;
-         }
+   /**************************************************************************/
 
-         direction = c->first;
-         connection = c->second;
+   std::shared_ptr<Room> Room::getConnection(size_t directionId) {
+
+      if (directionId >= connections.size() || !connections[directionId].connected) {
+         return std::shared_ptr<Room>();
       }
 
-      std::shared_ptr<Room> retVal = connection.lock();
+      std::shared_ptr<Room> connection = connections[directionId].room.lock();
 
-      if (!retVal) {
+      if (!connection) {
          mutex.lock();
-         connections.erase(direction);
+         removeConnectionUnlocked(directionId);
          mutex.unlock();
       }
 
-      return retVal;
+      return connection;
+   }
+
+   /**************************************************************************/
+
+   std::shared_ptr<Room> Room::getConnectionByIndex(size_t i) {
+
+      if (0 == getNumConnections()) {
+         return std::shared_ptr<Room>();
+      }
+
+      else if (i > getNumConnections() - 1) {
+         i = 0;
+      }
+
+      return getConnection(connectedDirections[i]);
    }
 
    /**************************************************************************/
@@ -172,15 +195,7 @@ namespace trogdor::entity {
    ) {
 
       if (game->getVocabulary().isDirection(direction)) {
-
-         mutex.lock();
-         connections[direction] = connectTo;
-
-         if (description) {
-            connectionDescriptions[direction] = *description;
-         }
-
-         mutex.unlock();
+         setConnection(*game->getVocabulary().getDirectionId(direction), connectTo, description);
       }
 
       else {
@@ -190,4 +205,46 @@ namespace trogdor::entity {
          );
       }
    }
+
+   /**************************************************************************/
+
+   void Room::setConnection(
+      size_t directionId,
+      const std::shared_ptr<Room> &connectTo,
+      std::optional<std::string> description
+   ) {
+
+      if (directionId >= game->getVocabulary().getNumDirections()) {
+         throw ValidationException(
+            std::string("error: attempt to connect to Room using invalid ")
+            + "direction ID " + std::to_string(directionId)
+         );
+      }
+
+      mutex.lock();
+
+      if (directionId >= connections.size()) {
+         connections.resize(directionId + 1);
+      }
+
+      Connection &connection = connections[directionId];
+
+      if (!connection.connected) {
+         connection.connected = true;
+         connection.position = connectedDirections.size();
+         connectedDirections.push_back(directionId);
+      }
+
+      connection.room = connectTo;
+
+      if (description) {
+         connection.description = *description;
+      }
+
+      mutex.unlock();
+
+      if (game) {
+         game->getRoomGraph().updateConnections(*this);
+      }
+   }
 }
@@ -0,0 +1,466 @@
+#include <trogdor/game.h>
+#include <trogdor/entities/room.h>
+#include <trogdor/entities/thing.h>
+#include <trogdor/entities/roomgraph.h>
+
+
+namespace trogdor::entity {
+
+
+   void RoomGraph::clearCache() {
+
+      rows.clear();
+      rowOrder.clear();
+      targets.clear();
+      componentsStale = true;
+   }
+
+   /***************************************************************************/
+
+   void RoomGraph::refresh() {
+
+      if (!stale) {
+         return;
+      }
+
+      nodes.clear();
+      nodeIds.clear();
+      clearCache();
+
+      // The graph can be rebuilt on any thread, including ones that don't
+      // hold the game's lock, so we can't iterate over the registry itself
+      std::vector<std::shared_ptr<Room>> rooms = game->getRoomSnapshot();
+
+      nodes.reserve(rooms.size());
+
+      for (const auto &room: rooms) {
+         nodeIds[room.get()] = nodes.size();
+         nodes.push_back({room, {}, {}});
+      }
+
+      for (size_t i = 0; i < nodes.size(); i++) {
+         if (auto room = nodes[i].room.lock()) {
+            indexConnections(i, *room);
+         }
+      }
+
+      stale = false;
+   }
+
+   /***************************************************************************/
+
+   void RoomGraph::indexConnections(size_t node, Room &room) {
+
+      // Looking up a connection can remove it if the Room it led to no longer
+      // exists, so we can't iterate over the Room's own list
+      std::vector<size_t> directions = room.getConnectedDirections();
+
+      for (const auto &direction: directions) {
+
+         auto connection = room.getConnection(direction);
+
+         if (!connection) {
+            continue;
+         }
+
+         auto target = nodeIds.find(connection.get());
+
+         if (nodeIds.end() != target) {
+            nodes[node].out.push_back({direction, target->second});
+            nodes[target->second].in.push_back({direction, node});
+         }
+      }
+   }
+
+   /***************************************************************************/
+
+   void RoomGraph::unindexConnections(size_t node) {
+
+      for (const auto &edge: nodes[node].out) {
+
+         auto &in = nodes[edge.node].in;
+
+         for (size_t i = 0; i < in.size(); i++) {
+            if (in[i].node == node && in[i].direction == edge.direction) {
+               in[i] = in.back();
+               in.pop_back();
+               break;
+            }
+         }
+      }
+
+      nodes[node].out.clear();
+   }
+
+   /***************************************************************************/
+
+   std::optional<size_t> RoomGraph::findNode(const Room *room) {
+
+      refresh();
+
+      auto node = nodeIds.find(room);
+      return nodeIds.end() != node ? std::optional<size_t>(node->second) : std::nullopt;
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<const RoomGraph::Row> RoomGraph::getRow(size_t destination) {
+
+      auto cached = rows.find(destination);
+
+      if (rows.end() != cached) {
+         return cached->second;
+      }
+
+      auto row = std::make_shared<Row>();
+
+      row->distance.assign(nodes.size(), UNREACHABLE);
+      row->next.assign(nodes.size(), {0, 0});
+
+      // Search backward from the destination, so that each node we reach
+      // learns how far it is and which edge it should take to get closer
+      std::vector<size_t> queue;
+
+      queue.reserve(nodes.size());
+      queue.push_back(destination);
+      row->distance[destination] = 0;
+
+      for (size_t head = 0; head < queue.size(); head++) {
+
+         size_t current = queue[head];
+
+         for (const auto &edge: nodes[current].in) {
+            if (UNREACHABLE == row->distance[edge.node]) {
+               row->distance[edge.node] = row->distance[current] + 1;
+               row->next[edge.node] = {edge.direction, current};
+               queue.push_back(edge.node);
+            }
+         }
+      }
+
+      numSearches++;
+
+      if (!maxCachedRows) {
+         return row;
+      }
+
+      while (rows.size() >= maxCachedRows) {
+         rows.erase(rowOrder.front());
+         rowOrder.pop_front();
+      }
+
+      rowOrder.push_back(destination);
+      rows[destination] = row;
+
+      return row;
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<const RoomGraph::Row> RoomGraph::getTargetRow(const Thing *target) {
+
+      refresh();
+
+      std::shared_ptr<Place> location = target->getLocation().lock();
+
+      if (!location || ENTITY_ROOM != location->getType()) {
+         targets.erase(target);
+         return nullptr;
+      }
+
+      const Room *room = static_cast<const Room *>(location.get());
+      Target &entry = targets[target];
+
+      // The target hasn't gone anywhere since the last time we looked
+      if (entry.row && room == entry.room) {
+         return entry.row;
+      }
+
+      auto node = nodeIds.find(room);
+
+      if (nodeIds.end() == node) {
+         targets.erase(target);
+         return nullptr;
+      }
+
+      entry.room = room;
+      entry.row = getRow(node->second);
+
+      return entry.row;
+   }
+
+   /***************************************************************************/
+
+   void RoomGraph::refreshComponents() {
+
+      if (!componentsStale) {
+         return;
+      }
+
+      components.assign(nodes.size(), UNREACHABLE);
+      numComponents = 0;
+
+      std::vector<size_t> stack;
+
+      for (size_t start = 0; start < nodes.size(); start++) {
+
+         if (UNREACHABLE != components[start]) {
+            continue;
+         }
+
+         components[start] = numComponents;
+         stack.push_back(start);
+
+         while (!stack.empty()) {
+
+            size_t current = stack.back();
+            stack.pop_back();
+
+            for (const auto *edges: {&nodes[current].out, &nodes[current].in}) {
+               for (const auto &edge: *edges) {
+                  if (UNREACHABLE == components[edge.node]) {
+                     components[edge.node] = numComponents;
+                     stack.push_back(edge.node);
+                  }
+               }
+            }
+         }
+
+         numComponents++;
+      }
+
+      componentsStale = false;
+   }
+
+   /***************************************************************************/
+
+   void RoomGraph::invalidate() {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      stale = true;
+      clearCache();
+   }
+
+   /***************************************************************************/
+
+   void RoomGraph::updateConnections(Room &room) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      // If the graph is stale, the Room's connections will be picked up when
+      // it's rebuilt
+      if (stale) {
+         return;
+      }
+
+      auto node = nodeIds.find(&room);
+
+      if (nodeIds.end() == node) {
+         return;
+      }
+
+      unindexConnections(node->second);
+      indexConnections(node->second, room);
+      clearCache();
+   }
+
+   /***************************************************************************/
+
+   void RoomGraph::setMaxCachedRows(size_t max) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      maxCachedRows = max;
+
+      while (rows.size() > maxCachedRows) {
+         rows.erase(rowOrder.front());
+         rowOrder.pop_front();
+      }
+   }
+
+   /***************************************************************************/
+
+   size_t RoomGraph::getNumCachedRows() const {
+
+      std::lock_guard<std::mutex> lock(mutex);
+      return rows.size();
+   }
+
+   /***************************************************************************/
+
+   size_t RoomGraph::getNumSearches() const {
+
+      std::lock_guard<std::mutex> lock(mutex);
+      return numSearches;
+   }
+
+   /***************************************************************************/
+
+   std::optional<size_t> RoomGraph::getDistance(const Room *from, const Room *to) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      std::optional<size_t> source = findNode(from);
+      std::optional<size_t> destination = findNode(to);
+
+      if (!source || !destination) {
+         return std::nullopt;
+      }
+
+      size_t distance = getRow(*destination)->distance[*source];
+      return UNREACHABLE != distance ? std::optional<size_t>(distance) : std::nullopt;
+   }
+
+   /***************************************************************************/
+
+   std::optional<RoomGraph::Step> RoomGraph::getNextStep(const Room *from, const Room *to) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      std::optional<size_t> source = findNode(from);
+      std::optional<size_t> destination = findNode(to);
+
+      if (!source || !destination) {
+         return std::nullopt;
+      }
+
+      std::shared_ptr<const Row> row = getRow(*destination);
+
+      if (0 == row->distance[*source] || UNREACHABLE == row->distance[*source]) {
+         return std::nullopt;
+      }
+
+      const Edge &next = row->next[*source];
+      return Step{next.direction, nodes[next.node].room.lock()};
+   }
+
+   /***************************************************************************/
+
+   std::vector<RoomGraph::Step> RoomGraph::getPath(const Room *from, const Room *to) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      std::vector<Step> path;
+      std::optional<size_t> source = findNode(from);
+      std::optional<size_t> destination = findNode(to);
+
+      if (!source || !destination) {
+         return path;
+      }
+
+      std::shared_ptr<const Row> row = getRow(*destination);
+
+      if (UNREACHABLE == row->distance[*source]) {
+         return path;
+      }
+
+      path.reserve(row->distance[*source]);
+
+      for (size_t current = *source; current != *destination; current = row->next[current].node) {
+         path.push_back({row->next[current].direction, nodes[row->next[current].node].room.lock()});
+      }
+
+      return path;
+   }
+
+   /***************************************************************************/
+
+   std::optional<size_t> RoomGraph::getDistanceTo(const Room *from, const Thing *target) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      std::optional<size_t> source = findNode(from);
+      std::shared_ptr<const Row> row = getTargetRow(target);
+
+      if (!source || !row || UNREACHABLE == row->distance[*source]) {
+         return std::nullopt;
+      }
+
+      return row->distance[*source];
+   }
+
+   /***************************************************************************/
+
+   std::optional<RoomGraph::Step> RoomGraph::getStepToward(const Room *from, const Thing *target) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      std::optional<size_t> source = findNode(from);
+      std::shared_ptr<const Row> row = getTargetRow(target);
+
+      if (!source || !row || 0 == row->distance[*source] || UNREACHABLE == row->distance[*source]) {
+         return std::nullopt;
+      }
+
+      const Edge &next = row->next[*source];
+      return Step{next.direction, nodes[next.node].room.lock()};
+   }
+
+   /***************************************************************************/
+
+   std::optional<RoomGraph::Step> RoomGraph::getStepAwayFrom(const Room *from, const Thing *target) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      std::optional<size_t> source = findNode(from);
+      std::shared_ptr<const Row> row = getTargetRow(target);
+
+      if (!source || !row) {
+         return std::nullopt;
+      }
+
+      // UNREACHABLE is the largest possible distance, so a step that leaves
+      // the target behind for good always wins
+      const Edge *best = nullptr;
+      size_t bestDistance = row->distance[*source];
+
+      for (const auto &edge: nodes[*source].out) {
+         if (row->distance[edge.node] > bestDistance) {
+            best = &edge;
+            bestDistance = row->distance[edge.node];
+         }
+      }
+
+      if (!best) {
+         return std::nullopt;
+      }
+
+      return Step{best->direction, nodes[best->node].room.lock()};
+   }
+
+   /***************************************************************************/
+
+   void RoomGraph::forgetTarget(const Thing *target) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+      targets.erase(target);
+   }
+
+   /***************************************************************************/
+
+   std::optional<size_t> RoomGraph::getComponent(const Room *room) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+      std::optional<size_t> node = findNode(room);
+
+      if (!node) {
+         return std::nullopt;
+      }
+
+      refreshComponents();
+      return components[*node];
+   }
+
+   /***************************************************************************/
+
+   size_t RoomGraph::getNumComponents() {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      refresh();
+      refreshComponents();
+
+      return numComponents;
+   }
+}
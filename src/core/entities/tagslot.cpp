@@ -0,0 +1,60 @@
+#include <string>
+#include <unordered_map>
+
+#include <trogdor/entities/tagslot.h>
+#include <trogdor/entities/resource.h>
+#include <trogdor/entities/object.h>
+#include <trogdor/entities/being.h>
+
+namespace trogdor::entity {
+
+
+   // Names of the built-in tags, in slot order
+   static const char *tagSlotNames[] = {
+
+      Resource::StickyTag,
+      Resource::EphemeralTag,
+
+      Object::WeaponTag,
+      Object::UntakeableTag,
+      Object::UndroppableTag,
+
+      Being::AttackableTag
+   };
+
+   static_assert(
+      sizeof(tagSlotNames) / sizeof(tagSlotNames[0]) == NUM_TAG_SLOTS,
+      "tagSlotNames and enum TagSlot are out of sync"
+   );
+
+   /***************************************************************************/
+
+   const char *tagSlotToStr(TagSlot slot) {
+
+      return tagSlotNames[slot];
+   }
+
+   /***************************************************************************/
+
+   std::optional<TagSlot> strToTagSlot(std::string_view tag) {
+
+      // Built once, the first time a tag is looked up by name. The keys point
+      // into string literals, so the views never dangle.
+      static const std::unordered_map<std::string_view, TagSlot> slots = [] {
+
+         std::unordered_map<std::string_view, TagSlot> slots;
+
+         for (size_t i = 0; i < NUM_TAG_SLOTS; i++) {
+            slots[tagSlotNames[i]] = static_cast<TagSlot>(i);
+         }
+
+         return slots;
+      }();
+
+      if (auto slot = slots.find(tag); slots.end() != slot) {
+         return slot->second;
+      }
+
+      return std::nullopt;
+   }
+}
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <trogdor/entities/tangible.h>
 #include <trogdor/entities/being.h>
 
@@ -12,7 +14,7 @@ namespace trogdor::entity {
       std::unique_ptr<Trogerr> e
    ): Entity(g, n, std::move(o), std::move(e)) {
 
-      types.push_back(ENTITY_TANGIBLE);
+      setType(ENTITY_TANGIBLE);
    }
 
    /***************************************************************************/
@@ -41,7 +43,7 @@ namespace trogdor::entity {
                const std::shared_ptr<Being> &being = game->getBeing(glancedBy);
 
                if (being) {
-                  glancedByMap.insert(being);
+                  recordObservation(*being, false);
                }
             }
          }
@@ -56,7 +58,7 @@ namespace trogdor::entity {
                const std::shared_ptr<Being> &being = game->getBeing(observedBy);
 
                if (being) {
-                  observedByMap.insert(being);
+                  recordObservation(*being, true);
                }
             }
          }
@@ -64,7 +66,7 @@ namespace trogdor::entity {
          return true;
       }));
 
-      types.push_back(ENTITY_TANGIBLE);
+      setType(ENTITY_TANGIBLE);
    }
 
    /***************************************************************************/
@@ -72,24 +74,24 @@ namespace trogdor::entity {
    std::shared_ptr<serial::Serializable> Tangible::serialize() {
 
       std::shared_ptr<serial::Serializable> data = Entity::serialize();
+
       std::vector<std::string> serializedGlancedBy;
+      std::vector<std::string> serializedObservedBy;
 
-      for (const auto &glancedBy: glancedByMap) {
-         if (auto observer = glancedBy.lock()) {
-            serializedGlancedBy.push_back(observer->getName());
-         }
-      }
+      if (game) {
 
-      data->set("glancedBy", serializedGlancedBy);
+         std::lock_guard<std::mutex> lock(observationsMutex);
 
-      std::vector<std::string> serializedObservedBy;
-
-      for (const auto &observedBy: observedByMap) {
-         if (auto observer = observedBy.lock()) {
-            serializedObservedBy.push_back(observer->getName());
+         for (const auto &observation: observations) {
+            if (Entity *observer = game->getEntity(observation.being)) {
+               (observation.observed ? serializedObservedBy : serializedGlancedBy).push_back(
+                  observer->getName()
+               );
+            }
          }
       }
 
+      data->set("glancedBy", serializedGlancedBy);
       data->set("observedBy", serializedObservedBy);
 
       // Serialized resource already keeps track of allocations, so including
@@ -100,6 +102,136 @@ namespace trogdor::entity {
 
    /***************************************************************************/
 
+   size_t Tangible::findObservation(uint32_t index) const {
+
+      return std::lower_bound(
+         observations.begin(),
+         observations.end(),
+         index,
+         [](const Observation &observation, uint32_t index) {
+            return observation.being.index < index;
+         }
+      ) - observations.begin();
+   }
+
+   /***************************************************************************/
+
+   void Tangible::recordObservation(Being &being, bool observed) {
+
+      EntityHandle handle = being.getHandle();
+
+      // Game can only have us forget a Being if each of us can find the
+      // other, so neither one is remembered unless both are in the game
+      if (!handle || !getHandle()) {
+         return;
+      }
+
+      bool isNew = true;
+
+      observationsMutex.lock();
+      size_t i = findObservation(handle.index);
+
+      if (i == observations.size() || observations[i].being.index != handle.index) {
+         observations.insert(observations.begin() + i, {handle, observed});
+      }
+
+      // Same slot, different generation: whoever was here before has left the
+      // game without being forgotten, so their observation doesn't carry over
+      else if (observations[i].being != handle) {
+         observations[i] = {handle, observed};
+      }
+
+      else {
+         observations[i].observed = observations[i].observed || observed;
+         isNew = false;
+      }
+
+      observationsMutex.unlock();
+
+      // The Being keeps track of us so that we're the only ones Game has to
+      // visit when it leaves
+      if (isNew) {
+         being.addObservedTangible(getHandle());
+      }
+   }
+
+   /***************************************************************************/
+
+   bool Tangible::hasObservation(const Being &being, bool observed) const {
+
+      EntityHandle handle = being.getHandle();
+
+      if (!handle) {
+         return false;
+      }
+
+      std::lock_guard<std::mutex> lock(observationsMutex);
+      size_t i = findObservation(handle.index);
+
+      return i < observations.size() && observations[i].being == handle &&
+         (observations[i].observed || !observed);
+   }
+
+   /***************************************************************************/
+
+   bool Tangible::observedBy(const std::shared_ptr<Being> &b) const {
+
+      return hasObservation(*b, true);
+   }
+
+   /***************************************************************************/
+
+   bool Tangible::glancedBy(const std::shared_ptr<Being> &b) const {
+
+      return hasObservation(*b, false);
+   }
+
+   /***************************************************************************/
+
+   void Tangible::forgetObserver(EntityHandle being) {
+
+      std::lock_guard<std::mutex> lock(observationsMutex);
+      size_t i = findObservation(being.index);
+
+      if (i < observations.size() && observations[i].being == being) {
+
+         observations.erase(observations.begin() + i);
+
+         // Give memory back after a crowd has come and gone
+         if (observations.size() < observations.capacity() / 4) {
+            observations.shrink_to_fit();
+         }
+      }
+   }
+
+   /***************************************************************************/
+
+   void Tangible::forgetObservers() {
+
+      std::lock_guard<std::mutex> lock(observationsMutex);
+
+      observations.clear();
+      observations.shrink_to_fit();
+   }
+
+   /***************************************************************************/
+
+   size_t Tangible::getNumObservers() const {
+
+      std::lock_guard<std::mutex> lock(observationsMutex);
+      return observations.size();
+   }
+
+   /***************************************************************************/
+
+   size_t Tangible::getObserverMemoryUsage() const {
+
+      std::lock_guard<std::mutex> lock(observationsMutex);
+      return observations.capacity() * sizeof(Observation);
+   }
+
+   /***************************************************************************/
+
    void Tangible::observe(const std::shared_ptr<Being> &observer, bool triggerEvents, bool displayFull) {
 
       if (triggerEvents && !game->event({
@@ -112,9 +244,7 @@ namespace trogdor::entity {
 
       display(observer.get(), displayFull);
 
-      mutex.lock();
-      observedByMap.insert(observer);
-      mutex.unlock();
+      recordObservation(*observer, true);
 
       if (triggerEvents) {
          game->event({
@@ -139,9 +269,7 @@ namespace trogdor::entity {
 
       displayShort(observer);
 
-      mutex.lock();
-      glancedByMap.insert(observer);
-      mutex.unlock();
+      recordObservation(*observer, false);
 
       if (triggerEvents) {
          game->event({
@@ -160,7 +288,7 @@ namespace trogdor::entity {
 
       if (!observedBy(observerShared) || displayFull) {
          if (ENTITY_PLAYER == observer->getType()) {
-            observer->out("display") << (isPropertySet(LongDescProperty) ? getProperty<std::string>(LongDescProperty) : "")
+            observer->out("display") << (isPropertySet(PROPERTY_SLOT_LONG_DESC) ? getPropertyRef<std::string>(PROPERTY_SLOT_LONG_DESC) : "")
                << std::endl;
          }
       }
@@ -16,7 +16,7 @@ namespace trogdor::entity {
       std::unique_ptr<Trogerr> e
    ): Tangible(g, n, std::move(o), std::move(e)), location(std::weak_ptr<Place>()) {
 
-      types.push_back(ENTITY_THING);
+      setType(ENTITY_THING);
 
       // Name is also an alias that we can reference a Thing by
       aliases.push_back(n);
@@ -65,7 +65,7 @@ namespace trogdor::entity {
          }));
       }
 
-      types.push_back(ENTITY_THING);
+      setType(ENTITY_THING);
    }
 
    /***************************************************************************/
@@ -87,7 +87,7 @@ namespace trogdor::entity {
    void Thing::display(Being *observer, bool displayFull) {
 
       observer->out("display") << "You see "
-         << getProperty<std::string>(TitleProperty) << '.' << std::endl;
+         << getPropertyRef<std::string>(PROPERTY_SLOT_TITLE) << '.' << std::endl;
       Tangible::display(observer, displayFull);
    }
 
@@ -95,13 +95,13 @@ namespace trogdor::entity {
 
    void Thing::displayShort(Being *observer) {
 
-      if (isPropertySet(ShortDescProperty) && getProperty<std::string>(ShortDescProperty).length()) {
+      if (isPropertySet(PROPERTY_SLOT_SHORT_DESC) && getPropertyRef<std::string>(PROPERTY_SLOT_SHORT_DESC).length()) {
          Tangible::displayShort(observer);
       }
 
       else {
          observer->out("display") << "You see "
-            << getProperty<std::string>(TitleProperty) << '.' << std::endl;
+            << getPropertyRef<std::string>(PROPERTY_SLOT_TITLE) << '.' << std::endl;
       }
    }
 
@@ -1,3 +1,4 @@
+#include <trogdor/game.h>
 #include <trogdor/event/eventlistener.h>
 
 #include <trogdor/event/triggers/autoattack.h>
@@ -38,7 +39,7 @@ namespace trogdor::event {
 
    /***************************************************************************/
 
-   EventListener::EventListener(const serial::Serializable &data, const std::shared_ptr<LuaState> &L) {
+   EventListener::EventListener(const serial::Serializable &data, Game *game) {
 
       const auto deserializedEvents =
          std::get<std::shared_ptr<serial::Serializable>>(*data.get("triggers"));
@@ -54,7 +55,7 @@ namespace trogdor::event {
             std::string typeName = std::get<std::string>(*trigger->get("type"));
 
             if (typeid(LuaEventTrigger) == EventTrigger::getType(typeName.c_str())) {
-               arg = std::tuple<serial::Serializable, const std::shared_ptr<LuaState> &>({*trigger, L});
+               arg = std::tuple<serial::Serializable, const std::shared_ptr<LuaState> &>({*trigger, game->getLuaState()});
             } else {
                arg = *trigger;
             }
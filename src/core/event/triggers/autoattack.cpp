@@ -55,12 +55,12 @@ namespace trogdor::event {
       // each Creature that has auto-attack enabled should be setup to attack
       for (auto const &creature: place->getCreatures()) {
 
-         if (creature->getProperty<bool>(entity::Creature::AutoAttackEnabledProperty)) {
+         if (creature->getProperty<bool>(entity::PROPERTY_SLOT_AUTOATTACK_ENABLED)) {
             game->insertTimerJob(std::make_shared<AutoAttackTimerJob>(
                game,
-               creature->getProperty<int>(entity::Creature::AutoAttackIntervalProperty),
-               creature->getProperty<bool>(entity::Creature::AutoAttackRepeatProperty) ? -1 : 1,
-               creature->getProperty<int>(entity::Creature::AutoAttackIntervalProperty),
+               creature->getProperty<int>(entity::PROPERTY_SLOT_AUTOATTACK_INTERVAL),
+               creature->getProperty<bool>(entity::PROPERTY_SLOT_AUTOATTACK_REPEAT) ? -1 : 1,
+               creature->getProperty<int>(entity::PROPERTY_SLOT_AUTOATTACK_INTERVAL),
                creature.get(),
                being
             ));
@@ -50,9 +50,9 @@ namespace trogdor::event {
       Game  *game  = std::get<Game *>(e.getArguments()[0]);
       entity::Being *being = static_cast<entity::Being *>(std::get<entity::Entity *>(e.getArguments()[1]));
 
-      if (being->getProperty<bool>(entity::Being::RespawnEnabledProperty)) {
+      if (being->getProperty<bool>(entity::PROPERTY_SLOT_RESPAWN_ENABLED)) {
 
-         int in = being->getProperty<int>(entity::Being::RespawnIntervalProperty);
+         int in = being->getProperty<int>(entity::PROPERTY_SLOT_RESPAWN_INTERVAL);
 
          // we have to wait a certain number of clock ticks
          if (in > 0) {
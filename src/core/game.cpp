@@ -20,6 +20,8 @@
 #include <trogdor/event/triggers/deathdrop.h>
 #include <trogdor/event/triggers/respawn.h>
 
+#include <trogdor/timer/jobs/wander.h>
+
 #include <trogdor/iostream/placeout.h>
 #include <trogdor/iostream/nullout.h>
 #include <trogdor/iostream/nullerr.h>
@@ -51,7 +53,6 @@ namespace trogdor {
             std::make_unique<NullErr>()
          );
 
-         L = std::make_shared<LuaState>(this);
          eventListener = std::make_unique<event::EventListener>();
       }
 
@@ -107,8 +108,67 @@ namespace trogdor {
          std::make_unique<NullErr>()
       );
 
+      // Games saved before classes were serialized won't have any
+      if (data->get("entityClasses") && data->arraySize("entityClasses")) {
+
+         for (const auto &prototype:
+         std::get<std::vector<std::shared_ptr<serial::Serializable>>>(*data->get("entityClasses"))) {
+
+            std::shared_ptr<entity::Entity> entity;
+
+            switch (entity::Entity::strToType(
+               std::get<std::vector<std::string>>(*prototype->get("types")).back()
+            )) {
+
+               case entity::ENTITY_RESOURCE:
+                  entity = std::make_shared<entity::Resource>(this, *prototype);
+                  break;
+
+               case entity::ENTITY_ROOM:
+                  entity = std::make_shared<entity::Room>(
+                     this, *prototype, std::make_unique<PlaceOut>(), err().copy()
+                  );
+                  break;
+
+               case entity::ENTITY_OBJECT:
+                  entity = std::make_shared<entity::Object>(
+                     this, *prototype, std::make_unique<NullOut>(), err().copy()
+                  );
+                  break;
+
+               case entity::ENTITY_CREATURE:
+                  entity = std::make_shared<entity::Creature>(
+                     this, *prototype, std::make_unique<NullOut>(), err().copy()
+                  );
+                  break;
+
+               default:
+                  continue;
+            }
+
+            entityClasses[entity->getClass()] = entity;
+         }
+      }
+
       const serial::Value entityArr = *data->get("entities");
 
+      // Reserve room in the pool for every Entity up front, so that each
+      // type's Entities are packed into as few chunks as possible
+      std::unordered_map<entity::EntityType, size_t, std::hash<int>> nEntities;
+
+      for (const auto &entity:
+      std::get<std::vector<std::shared_ptr<serial::Serializable>>>(entityArr)) {
+         nEntities[entity::Entity::strToType(
+            std::get<std::vector<std::string>>(*entity->get("types")).back()
+         )]++;
+      }
+
+      for (const auto &count: nEntities) {
+         if (entity::ENTITY_PLAYER != count.first) {
+            entityPool->reserve(count.first, count.second);
+         }
+      }
+
       for (const auto &entity:
       std::get<std::vector<std::shared_ptr<serial::Serializable>>>(entityArr)) {
 
@@ -120,7 +180,7 @@ namespace trogdor {
 
                insertEntity(
                   std::get<std::string>(*entity->get("name")),
-                  std::make_shared<entity::Resource>(this, *entity)
+                  makeEntity<entity::Resource>(this, *entity)
                );
 
                break;
@@ -129,7 +189,7 @@ namespace trogdor {
 
                insertEntity(
                   std::get<std::string>(*entity->get("name")),
-                  std::make_shared<entity::Room>(
+                  makeEntity<entity::Room>(
                      this,
                      *entity,
                      std::make_unique<PlaceOut>(),
@@ -143,7 +203,7 @@ namespace trogdor {
 
                insertEntity(
                   std::get<std::string>(*entity->get("name")),
-                  std::make_shared<entity::Object>(
+                  makeEntity<entity::Object>(
                      this,
                      *entity,
                      std::make_unique<NullOut>(),
@@ -157,7 +217,7 @@ namespace trogdor {
 
                insertEntity(
                   std::get<std::string>(*entity->get("name")),
-                  std::make_shared<entity::Creature>(
+                  makeEntity<entity::Creature>(
                      this,
                      *entity,
                      std::make_unique<NullOut>(),
@@ -187,13 +247,17 @@ namespace trogdor {
          }
       }
 
-      L = std::make_unique<LuaState>(
-         this,
-         *std::get<std::shared_ptr<serial::Serializable>>(*data->get("lua"))
-      );
+      const auto &serializedLua = *std::get<std::shared_ptr<serial::Serializable>>(*data->get("lua"));
+
+      // If no scripts were ever loaded, there's nothing to restore, and the
+      // Lua state can wait until something actually needs it
+      if (std::get<std::string>(*serializedLua.get("scripts")).length()) {
+         L = std::make_shared<LuaState>(this, serializedLua);
+         L->configureGC(luaGCConfig);
+      }
 
       eventListener = std::make_unique<event::EventListener>(
-         *std::get<std::shared_ptr<serial::Serializable>>(*data->get("eventListener")), L
+         *std::get<std::shared_ptr<serial::Serializable>>(*data->get("eventListener")), this
       );
 
       timer = std::make_unique<Timer>(
@@ -223,11 +287,16 @@ namespace trogdor {
       std::shared_ptr<serial::Serializable> serializedMeta = std::make_shared<serial::Serializable>();
 
       std::vector<std::shared_ptr<serial::Serializable>> serializedEntities;
+      std::vector<std::shared_ptr<serial::Serializable>> serializedClasses;
 
       for (const auto &entity: entities) {
          serializedEntities.push_back(entity.second->serialize());
       }
 
+      for (const auto &prototype: entityClasses) {
+         serializedClasses.push_back(prototype.second->serialize());
+      }
+
       for (const auto &metaItem: meta) {
          serializedMeta->set(metaItem.first, metaItem.second);
       }
@@ -236,13 +305,24 @@ namespace trogdor {
       serializedIntro->set("text", introduction.text);
 
       data->set("inGame", gameWasStarted);
-      data->set("lua", L->serialize());
+      // A Lua state that was never created serializes the same way as one
+      // that never loaded any scripts
+      if (hasLuaState()) {
+         data->set("lua", L->serialize());
+      }
+
+      else {
+         std::shared_ptr<serial::Serializable> serializedLua = std::make_shared<serial::Serializable>();
+         serializedLua->set("scripts", std::string(""));
+         data->set("lua", serializedLua);
+      }
       data->set("timer", timer->serialize());
       data->set("introduction", serializedIntro);
       data->set("meta", serializedMeta);
       data->set("defaultPlayer", defaultPlayer->serialize());
       data->set("eventListener", eventListener->serialize());
       data->set("entities", serializedEntities);
+      data->set("entityClasses", serializedClasses);
 
       // TODO: if I'm stopping game and timer to ensure consistency while
       // serializing, how do I want to signal to deserialization later that it
@@ -266,6 +346,7 @@ namespace trogdor {
       stop();
       meta.clear();
       clearEntities();
+      entityClasses.clear();
 
       _deserialize(data, makeOutStream, makeErrStream);
    }
@@ -387,44 +468,514 @@ namespace trogdor {
          throw entity::EntityException(std::string("Entity '") + name + "' already exists");
       }
 
+      if (entity->isType(entity::ENTITY_PLAYER)) {
+         throw UndefinedException("Game::insertEntity: Use Game::insertPlayer instead");
+      }
+
+      // Only concrete types can be inserted
+      else if (!(entity->getTypeMask() & (
+         entity::entityTypeBit(entity::ENTITY_RESOURCE) |
+         entity::entityTypeBit(entity::ENTITY_ROOM) |
+         entity::entityTypeBit(entity::ENTITY_OBJECT) |
+         entity::entityTypeBit(entity::ENTITY_CREATURE)
+      ))) {
+         throw UndefinedException("Game::insertEntity: unsupported entity type");
+      }
+
       mutex.lock();
 
-      switch (entity->getType()) {
+      registerEntity(name, entity);
+      entity->setGame(this);
 
-         case entity::ENTITY_RESOURCE:
-            resources[name] = std::dynamic_pointer_cast<entity::Resource>(entity);
-            break;
+      mutex.unlock();
+   }
 
-         case entity::ENTITY_ROOM:
-            tangibles[name] = std::dynamic_pointer_cast<entity::Tangible>(entity);
-            places[name] = std::dynamic_pointer_cast<entity::Place>(entity);
-            rooms[name] = std::dynamic_pointer_cast<entity::Room>(entity);
-            break;
+   /***************************************************************************/
 
-         case entity::ENTITY_OBJECT:
-            tangibles[name] = std::dynamic_pointer_cast<entity::Tangible>(entity);
-            things[name] = std::dynamic_pointer_cast<entity::Thing>(entity);
-            objects[name] = std::dynamic_pointer_cast<entity::Object>(entity);
-            break;
+   void Game::insertEntityClass(std::string className, std::shared_ptr<entity::Entity> prototype) {
 
-         case entity::ENTITY_CREATURE:
-            tangibles[name] = std::dynamic_pointer_cast<entity::Tangible>(entity);
-            things[name] = std::dynamic_pointer_cast<entity::Thing>(entity);
-            beings[name] = std::dynamic_pointer_cast<entity::Being>(entity);
-            creatures[name] = std::dynamic_pointer_cast<entity::Creature>(entity);
-            break;
+      if (prototype->isType(entity::ENTITY_PLAYER)) {
+         throw UndefinedException("Game::insertEntityClass: classes can't be defined for type Player");
+      }
 
-         case entity::ENTITY_PLAYER:
-            throw UndefinedException("Game::insertEntity: Use Game::insertPlayer instead");
+      mutex.lock();
+      entityClasses[className] = prototype;
+      mutex.unlock();
+   }
 
-         default:
-            throw UndefinedException("Game::insertEntity: unsupported entity type");
+   /***************************************************************************/
+
+   std::shared_ptr<entity::Entity> Game::getEntityClass(const std::string &className) const {
+
+      auto prototype = entityClasses.find(className);
+      return entityClasses.end() == prototype ? nullptr : prototype->second;
+   }
+
+   /***************************************************************************/
+
+   std::vector<std::shared_ptr<entity::Thing>> Game::spawnMany(
+      const std::string &className,
+      size_t count,
+      const std::shared_ptr<entity::Place> &place,
+      std::string namePattern,
+      bool triggerEvents
+   ) {
+
+      std::shared_ptr<entity::Entity> prototype = getEntityClass(className);
+
+      if (!prototype) {
+         throw UndefinedException(
+            std::string("Game::spawnMany: class '") + className + "' doesn't exist"
+         );
       }
 
-      entities[name] = entity;
-      entity->setGame(this);
+      else if (!prototype->isType(entity::ENTITY_OBJECT) && !prototype->isType(entity::ENTITY_CREATURE)) {
+         throw UndefinedException(
+            std::string("Game::spawnMany: '") + className + "' isn't a class of Objects or Creatures"
+         );
+      }
 
-      mutex.unlock();
+      if (namePattern.empty()) {
+         namePattern = className;
+      }
+
+      // Each name is prefix + number + suffix
+      size_t placeholder = namePattern.find("{}");
+
+      std::string prefix = namePattern.substr(0, placeholder);
+      std::string suffix = std::string::npos == placeholder ? "" : namePattern.substr(placeholder + 2);
+
+      std::vector<std::shared_ptr<entity::Thing>> spawned;
+      spawned.reserve(count);
+
+      {
+         std::lock_guard<std::recursive_mutex> lock(mutex);
+
+         entityPool->reserve(prototype->getType(), count);
+         entities.reserve(entities.size() + count);
+
+         // The copy constructors validate each name, so if the pattern is
+         // invalid, we'll find out before anything's been inserted
+         for (size_t number = 1; spawned.size() < count; number++) {
+
+            std::string name = prefix + std::to_string(number) + suffix;
+
+            if (entities.end() != entities.find(name)) {
+               continue;
+            }
+
+            if (entity::ENTITY_OBJECT == prototype->getType()) {
+               spawned.push_back(makeEntity<entity::Object>(
+                  *std::static_pointer_cast<entity::Object>(prototype), name
+               ));
+            }
+
+            else {
+               spawned.push_back(makeEntity<entity::Creature>(
+                  *std::static_pointer_cast<entity::Creature>(prototype), name
+               ));
+            }
+         }
+
+         for (const auto &thing: spawned) {
+            registerEntity(thing->getName(), thing);
+            thing->setGame(this);
+         }
+      }
+
+      if (place) {
+         place->insertThings(spawned);
+      }
+
+      // Instances of classes that wander have to start wandering on their own
+      if (
+         entity::ENTITY_CREATURE == prototype->getType() &&
+         prototype->getProperty<bool>(entity::PROPERTY_SLOT_WANDER_ENABLED)
+      ) {
+
+         int interval = prototype->getProperty<int>(entity::PROPERTY_SLOT_WANDER_INTERVAL);
+
+         for (const auto &thing: spawned) {
+            insertTimerJob(std::make_shared<WanderTimerJob>(
+               this, interval, -1, interval, static_cast<entity::Creature *>(thing.get())
+            ));
+         }
+      }
+
+      if (triggerEvents) {
+
+         std::list<event::EventListener *> listeners;
+
+         if (place) {
+            listeners.push_back(place->getEventListener());
+         }
+
+         event({
+            "afterSpawnMany",
+            listeners,
+            {this, static_cast<entity::Entity *>(place.get()), className, static_cast<int>(count)}
+         });
+      }
+
+      return spawned;
+   }
+
+   /***************************************************************************/
+
+   bool Game::playerIsInGame(const std::string name) const {
+
+      return players.find(name) == players.end() ? false : true;
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<entity::Resource> Game::getResource(const std::string name) const {
+
+      auto entity = entities.find(name);
+
+      if (entities.end() == entity || !entity->second->isType(entity::ENTITY_RESOURCE)) {
+         return nullptr;
+      }
+
+      return std::static_pointer_cast<entity::Resource>(entity->second);
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<entity::Tangible> Game::getTangible(const std::string name) const {
+
+      auto entity = entities.find(name);
+
+      if (entities.end() == entity || !entity->second->isType(entity::ENTITY_TANGIBLE)) {
+         return nullptr;
+      }
+
+      return std::static_pointer_cast<entity::Tangible>(entity->second);
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<entity::Place> Game::getPlace(const std::string name) const {
+
+      auto entity = entities.find(name);
+
+      if (entities.end() == entity || !entity->second->isType(entity::ENTITY_PLACE)) {
+         return nullptr;
+      }
+
+      return std::static_pointer_cast<entity::Place>(entity->second);
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<entity::Thing> Game::getThing(const std::string name) const {
+
+      auto entity = entities.find(name);
+
+      if (entities.end() == entity || !entity->second->isType(entity::ENTITY_THING)) {
+         return nullptr;
+      }
+
+      return std::static_pointer_cast<entity::Thing>(entity->second);
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<entity::Being> Game::getBeing(const std::string name) const {
+
+      auto entity = entities.find(name);
+
+      if (entities.end() == entity || !entity->second->isType(entity::ENTITY_BEING)) {
+         return nullptr;
+      }
+
+      return std::static_pointer_cast<entity::Being>(entity->second);
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<entity::Player> Game::getPlayer(const std::string name) const {
+
+      auto entity = entities.find(name);
+
+      if (entities.end() == entity || !entity->second->isType(entity::ENTITY_PLAYER)) {
+         return nullptr;
+      }
+
+      return std::static_pointer_cast<entity::Player>(entity->second);
+   }
+
+   /***************************************************************************/
+
+   std::vector<std::shared_ptr<entity::Player>> Game::getPlayerSnapshot() const {
+
+      std::lock_guard<std::mutex> lock(snapshotMutex);
+      return playerList;
+   }
+
+   /***************************************************************************/
+
+   std::vector<std::shared_ptr<entity::Room>> Game::getRoomSnapshot() const {
+
+      std::lock_guard<std::mutex> lock(snapshotMutex);
+      return roomList;
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<entity::Creature> Game::getCreature(const std::string name) const {
+
+      auto entity = entities.find(name);
+
+      if (entities.end() == entity || !entity->second->isType(entity::ENTITY_CREATURE)) {
+         return nullptr;
+      }
+
+      return std::static_pointer_cast<entity::Creature>(entity->second);
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<entity::Object> Game::getObject(const std::string name) const {
+
+      auto entity = entities.find(name);
+
+      if (entities.end() == entity || !entity->second->isType(entity::ENTITY_OBJECT)) {
+         return nullptr;
+      }
+
+      return std::static_pointer_cast<entity::Object>(entity->second);
+   }
+
+   /***************************************************************************/
+
+   std::shared_ptr<entity::Room> Game::getRoom(const std::string name) const {
+
+      auto entity = entities.find(name);
+
+      if (entities.end() == entity || !entity->second->isType(entity::ENTITY_ROOM)) {
+         return nullptr;
+      }
+
+      return std::static_pointer_cast<entity::Room>(entity->second);
+   }
+
+   /***************************************************************************/
+
+   // Removes an Entity from playerList or roomList. Players and Rooms come
+   // and go rarely enough that a linear search is fine.
+   template <typename T>
+   static void eraseFromList(std::vector<std::shared_ptr<T>> &list, const entity::Entity *entity) {
+
+      for (size_t i = 0; i < list.size(); i++) {
+         if (entity == list[i].get()) {
+            list[i] = std::move(list.back());
+            list.pop_back();
+            return;
+         }
+      }
+   }
+
+   /***************************************************************************/
+
+   void Game::registerEntity(const std::string &name, std::shared_ptr<entity::Entity> entity) {
+
+      entity->withTagsLocked([&] {
+
+         std::lock_guard<std::mutex> lock(tagIndexMutex);
+
+         // If the Entity already has a handle (because it was deserialized),
+         // we try to give it the same one back so that references to it
+         // saved elsewhere remain valid
+         if (!handles.insert(entity->getHandle(), entity.get())) {
+            entity->setHandle(handles.insert(entity.get()));
+         }
+
+         entity->forEachTag([&](const std::string &tag) {
+            tagIndex[tag].insert(entity.get());
+         });
+      });
+
+      // Indexed by handle, so this has to come after the Entity gets one
+      for (int type = entity::ENTITY_ENTITY; type < entity::NUM_ENTITY_TYPES; type++) {
+
+         if (entity->isType(static_cast<entity::EntityType>(type))) {
+
+            entity::EntityTypeIndex &index = typeIndices[type];
+            uint32_t slot = entity->getHandle().index;
+
+            if (index.positions.size() <= slot) {
+               index.positions.resize(slot + 1);
+            }
+
+            index.positions[slot] = index.entities.size();
+            index.entities.push_back(entity.get());
+         }
+      }
+
+      // The lists are updated before the graph is invalidated, so that if
+      // it's rebuilt in between, it's just marked stale again
+      if (entity->isType(entity::ENTITY_PLAYER)) {
+         snapshotMutex.lock();
+         playerList.push_back(std::static_pointer_cast<entity::Player>(entity));
+         snapshotMutex.unlock();
+      }
+
+      else if (entity->isType(entity::ENTITY_ROOM)) {
+
+         snapshotMutex.lock();
+         roomList.push_back(std::static_pointer_cast<entity::Room>(entity));
+         snapshotMutex.unlock();
+
+         roomGraph.invalidate();
+      }
+
+      entities[name] = std::move(entity);
+   }
+
+   /***************************************************************************/
+
+   void Game::unregisterEntity(const std::string &name) {
+
+      auto entity = entities.find(name);
+      entity::EntityHandle handle = entity->second->getHandle();
+
+      for (int type = entity::ENTITY_ENTITY; type < entity::NUM_ENTITY_TYPES; type++) {
+
+         if (entity->second->isType(static_cast<entity::EntityType>(type))) {
+
+            entity::EntityTypeIndex &index = typeIndices[type];
+            uint32_t position = index.positions[handle.index];
+
+            // Swap with the last Entity of the type and pop
+            index.entities[position] = index.entities.back();
+            index.positions[index.entities[position]->getHandle().index] = position;
+            index.entities.pop_back();
+         }
+      }
+
+      entity->second->withTagsLocked([&] {
+
+         std::lock_guard<std::mutex> lock(tagIndexMutex);
+
+         entity->second->forEachTag([&](const std::string &tag) {
+            eraseFromTagIndex(entity->second.get(), tag);
+         });
+
+         handles.remove(handle);
+         entity->second->setHandle({});
+      });
+      entity->second->setGame(nullptr);
+
+      if (entity->second->isType(entity::ENTITY_PLAYER)) {
+         snapshotMutex.lock();
+         eraseFromList(playerList, entity->second.get());
+         snapshotMutex.unlock();
+      }
+
+      else if (entity->second->isType(entity::ENTITY_ROOM)) {
+
+         snapshotMutex.lock();
+         eraseFromList(roomList, entity->second.get());
+         snapshotMutex.unlock();
+
+         roomGraph.invalidate();
+      }
+
+      else if (entity->second->isType(entity::ENTITY_THING)) {
+         roomGraph.forgetTarget(static_cast<entity::Thing *>(entity->second.get()));
+      }
+
+      // A Tangible that leaves can't be found through the handles Beings kept
+      // for it, so it forgets them instead
+      if (entity->second->isType(entity::ENTITY_TANGIBLE)) {
+         static_cast<entity::Tangible *>(entity->second.get())->forgetObservers();
+      }
+
+      // Every Tangible remembers which Beings have looked at it, so a Being
+      // that leaves has to be forgotten or those records would pile up for as
+      // long as the game runs. The Being knows which Tangibles those are.
+      if (entity->second->isType(entity::ENTITY_BEING)) {
+
+         auto being = static_cast<entity::Being *>(entity->second.get());
+
+         for (const auto &tangibleHandle: being->takeObservedTangibles()) {
+
+            // Handles of Tangibles that have since left the game don't
+            // resolve
+            if (auto tangible = handles.resolve(tangibleHandle)) {
+               static_cast<entity::Tangible *>(tangible)->forgetObserver(handle);
+            }
+         }
+      }
+
+      entities.erase(entity);
+   }
+
+   /***************************************************************************/
+
+   void Game::indexTag(entity::Entity *entity, const std::string &tag) {
+
+      std::lock_guard<std::mutex> lock(tagIndexMutex);
+
+      // Entities that are being constructed or have already been removed
+      // shouldn't show up in the index
+      if (entity == handles.resolve(entity->getHandle())) {
+         tagIndex[tag].insert(entity);
+      }
+   }
+
+   /***************************************************************************/
+
+   void Game::unindexTag(entity::Entity *entity, const std::string &tag) {
+
+      std::lock_guard<std::mutex> lock(tagIndexMutex);
+      eraseFromTagIndex(entity, tag);
+   }
+
+   /***************************************************************************/
+
+   void Game::eraseFromTagIndex(entity::Entity *entity, const std::string &tag) {
+
+      auto tagged = tagIndex.find(tag);
+
+      if (tagIndex.end() != tagged) {
+
+         tagged->second.erase(entity);
+
+         if (tagged->second.empty()) {
+            tagIndex.erase(tagged);
+         }
+      }
+   }
+
+   /***************************************************************************/
+
+   std::vector<std::shared_ptr<entity::Entity>> Game::getEntitiesWithTag(const std::string &tag) {
+
+      std::vector<std::shared_ptr<entity::Entity>> tagged;
+      std::lock_guard<std::mutex> lock(tagIndexMutex);
+
+      if (auto entry = tagIndex.find(tag); tagIndex.end() != entry) {
+
+         tagged.reserve(entry->second.size());
+
+         for (entity::Entity *entity: entry->second) {
+            tagged.push_back(entity->getShared());
+         }
+      }
+
+      return tagged;
+   }
+
+   /***************************************************************************/
+
+   size_t Game::countEntitiesWithTag(const std::string &tag) {
+
+      std::lock_guard<std::mutex> lock(tagIndexMutex);
+      auto entry = tagIndex.find(tag);
+
+      return tagIndex.end() != entry ? entry->second.size() : 0;
    }
 
    /***************************************************************************/
@@ -483,37 +1034,7 @@ namespace trogdor {
 
       mutex.lock();
 
-      switch (entities[name]->getType()) {
-
-         case entity::ENTITY_RESOURCE:
-            resources.erase(name);
-            break;
-
-         case entity::ENTITY_ROOM:
-            tangibles.erase(name);
-            places.erase(name);
-            rooms.erase(name);
-            break;
-
-         case entity::ENTITY_OBJECT:
-            tangibles.erase(name);
-            things.erase(name);
-            objects.erase(name);
-            break;
-
-         case entity::ENTITY_CREATURE:
-            tangibles.erase(name);
-            things.erase(name);
-            beings.erase(name);
-            creatures.erase(name);
-            break;
-
-         default:
-            throw UndefinedException("Game::removeEntity: unsupported entity type");
-      }
-
-      entities[name]->setGame(nullptr);
-      entities.erase(name);
+      unregisterEntity(name);
 
       mutex.unlock();
    }
@@ -548,17 +1069,12 @@ namespace trogdor {
 
       mutex.lock();
 
-      entities[player->getName()] = player;
-      tangibles[player->getName()] = player;
-      things[player->getName()] = player;
-      beings[player->getName()] = player;
-      players[player->getName()] = player;
-
+      registerEntity(player->getName(), player);
       player->setGame(this);
 
       // set Player's initial location
       if (!deserialize) {
-         places["start"]->insertThing(player);
+         getPlace("start")->insertThing(player);
       }
 
       mutex.unlock();
@@ -583,32 +1099,26 @@ namespace trogdor {
       const std::string message
    ) {
 
-      if (players.find(name) != players.end()) {
+      if (std::shared_ptr<entity::Player> player = getPlayer(name)) {
 
-         executeCallback("removePlayer", players[name]);
+         executeCallback("removePlayer", player);
 
          if (message.length()) {
-            players[name]->out("system") << message << std::endl;
+            player->out("system") << message << std::endl;
          }
 
          // Signal to the player that they're being removed from the game by
          // sending an empty message on the "removed" channel
-         players[name]->out("removed") << std::endl;
+         player->out("removed") << std::endl;
 
          // if the Player is located in a Place, make sure to remove it
-         if (auto location = players[name]->getLocation().lock()) {
-            location->removeThing(players[name]);
+         if (auto location = player->getLocation().lock()) {
+            location->removeThing(player);
          }
 
          mutex.lock();
 
-         entities[name]->setGame(nullptr);
-
-         entities.erase(name);
-         tangibles.erase(name);
-         things.erase(name);
-         beings.erase(name);
-         players.erase(name);
+         unregisterEntity(name);
 
          mutex.unlock();
       }
@@ -637,6 +1147,158 @@ namespace trogdor {
 
    /***************************************************************************/
 
+   const std::shared_ptr<LuaState> &Game::getLuaState() {
+
+      std::lock_guard<std::mutex> lock(luaStateMutex);
+
+      if (!L) {
+         L = std::make_shared<LuaState>(this);
+         L->configureGC(luaGCConfig);
+      }
+
+      return L;
+   }
+
+   /***************************************************************************/
+
+   void Game::startLuaProfiler(std::optional<int> interval) {
+
+      // Make sure the Lua state exists before we try to profile it
+      getLuaState();
+
+      L->lock();
+
+      try {
+         L->startProfiler(interval ? *interval : LuaState::DEFAULT_PROFILER_INTERVAL);
+      }
+
+      catch (...) {
+         L->unlock();
+         throw;
+      }
+
+      L->unlock();
+   }
+
+   /***************************************************************************/
+
+   void Game::stopLuaProfiler() {
+
+      // There's nothing to stop or reset if Lua was never used
+      if (!hasLuaState()) {
+         return;
+      }
+
+      L->lock();
+      L->stopProfiler();
+      L->unlock();
+   }
+
+   /***************************************************************************/
+
+   void Game::resetLuaProfiler() {
+
+      // There's nothing to stop or reset if Lua was never used
+      if (!hasLuaState()) {
+         return;
+      }
+
+      L->lock();
+      L->resetProfiler();
+      L->unlock();
+   }
+
+   /***************************************************************************/
+
+   std::string Game::dumpLuaProfile() {
+
+      std::ostringstream profile;
+
+      if (!hasLuaState()) {
+         return profile.str();
+      }
+
+      L->lock();
+      L->dumpProfile(profile);
+      L->unlock();
+
+      return profile.str();
+   }
+
+   /***************************************************************************/
+
+   void Game::resumeLuaCoroutines(size_t time) {
+
+      // Scripts can't have spawned any coroutines if Lua was never used
+      if (!hasLuaState()) {
+         return;
+      }
+
+      L->lock();
+      L->getScheduler()->resume(time);
+      L->unlock();
+   }
+
+   /***************************************************************************/
+
+   void Game::setLuaCoroutineBudget(std::chrono::microseconds budget) {
+
+      // Make sure the Lua state exists so the budget isn't lost
+      getLuaState();
+
+      L->lock();
+      L->getScheduler()->setBudget(budget);
+      L->unlock();
+   }
+
+   /***************************************************************************/
+
+   void Game::configureLuaGC(const LuaGCConfig &config) {
+
+      LuaState::validateGCConfig(config);
+
+      luaStateMutex.lock();
+
+      luaGCConfig = config;
+      std::shared_ptr<LuaState> state = L;
+
+      // Lua code that fires events takes these locks in the opposite order,
+      // so luaStateMutex has to be released before locking the state
+      luaStateMutex.unlock();
+
+      if (state) {
+         state->lock();
+         state->configureGC(config);
+         state->unlock();
+      }
+   }
+
+   /***************************************************************************/
+
+   std::chrono::microseconds Game::collectLuaGarbage(std::chrono::microseconds limit) {
+
+      std::chrono::microseconds spent(0);
+      std::shared_ptr<LuaState> state;
+
+      luaStateMutex.lock();
+
+      if (luaGCConfig.idleStepping) {
+         state = L;
+      }
+
+      luaStateMutex.unlock();
+
+      // If the state is busy, something more important is going on
+      if (state && state->tryLock()) {
+         spent = state->stepGC(limit);
+         state->unlock();
+      }
+
+      return spent;
+   }
+
+   /***************************************************************************/
+
    unsigned long Game::getTime() const {
 
       return timer->getTime();
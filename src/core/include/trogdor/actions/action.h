@@ -113,7 +113,7 @@ namespace trogdor {
 
             else if (
                resource->isPlural(name) ||
-               !resource->getProperty<bool>(entity::Resource::ReqIntAllocProperty)
+               !resource->getProperty<bool>(entity::PROPERTY_SLOT_REQ_INT_ALLOC)
             ) {
                return max;
             }
@@ -148,11 +148,10 @@ namespace trogdor {
             std::function<void()> operation
          ) {
 
-            auto i = depositor->getResources().find(resource->getShared());
+            std::optional<double> allocation = depositor->getResourceAllocation(resource->getShared());
 
-            if (i != depositor->getResources().end()) {
+            if (allocation) {
 
-               auto allocation = *i;
                double intPart, fracPart = modf(amount, &intPart);
 
                if (amount <= 0) {
@@ -160,24 +159,24 @@ namespace trogdor {
                      << std::endl;
                }
 
-               else if (resource->getProperty<bool>(entity::Resource::ReqIntAllocProperty) && fracPart) {
+               else if (resource->getProperty<bool>(entity::PROPERTY_SLOT_REQ_INT_ALLOC) && fracPart) {
                   player->out("display") << "Please specify a whole number of "
-                     << resource->getProperty<std::string>(entity::Resource::PluralTitleProperty)
+                     << resource->getPropertyRef<std::string>(entity::PROPERTY_SLOT_PLURAL_TITLE)
                      << '.' << std::endl;
                }
 
-               else if (amount > allocation.second) {
+               else if (amount > *allocation) {
 
                   if (static_cast<entity::Tangible *>(player) == depositor) {
                      player->out("display") << "You only have "
-                        << resource->amountToString(allocation.second) << ' '
-                        << resource->titleToString(allocation.second) << '.' << std::endl;
+                        << resource->amountToString(*allocation) << ' '
+                        << resource->titleToString(*allocation) << '.' << std::endl;
                   }
 
                   else {
                      player->out("display") << "There are only "
-                        << resource->amountToString(allocation.second) << ' '
-                        << resource->titleToString(allocation.second) << '.' << std::endl;
+                        << resource->amountToString(*allocation) << ' '
+                        << resource->titleToString(*allocation) << '.' << std::endl;
                   }
                }
 
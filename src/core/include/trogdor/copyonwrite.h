@@ -0,0 +1,82 @@
+#ifndef COPYONWRITE_H
+#define COPYONWRITE_H
+
+
+#include <memory>
+
+
+namespace trogdor {
+
+
+   /*
+      Holds a value that's shared between copies until one of them needs to
+      modify it, at which point that copy gets a private version of its own.
+      Entities cloned from a class prototype use this for data that most
+      instances never change (messages, tags, property validators, etc.), so
+      that a thousand Objects of the same class only store it once.
+
+      Reading through operator* and operator-> never copies anything. Every
+      modification has to go through write(), which makes the private copy if
+      the value is still shared. References obtained by reading remain valid
+      until the next call to write().
+
+      Like the rest of an Entity's state, CopyOnWrite doesn't do any locking
+      of its own.
+   */
+   template <typename T> class CopyOnWrite {
+
+      private:
+
+         std::shared_ptr<T> value;
+
+      public:
+
+         /*
+            Constructors. A default constructed CopyOnWrite holds a default
+            constructed T that isn't shared with anything.
+         */
+         inline CopyOnWrite(): value(std::make_shared<T>()) {}
+         CopyOnWrite(const CopyOnWrite &) = default;
+         CopyOnWrite &operator=(const CopyOnWrite &) = default;
+
+         /*
+            Read-only access to the value.
+         */
+         inline const T &operator*() const {return *value;}
+         inline const T *operator->() const {return value.get();}
+
+         /*
+            Returns a modifiable reference to the value, first making a
+            private copy of it if it's shared with anything else.
+
+            Input:
+               (none)
+
+            Output:
+               T &
+         */
+         inline T &write() {
+
+            if (value.use_count() > 1) {
+               value = std::make_shared<T>(*value);
+            }
+
+            return *value;
+         }
+
+         /*
+            Returns true if the value is currently shared with at least one
+            other copy.
+
+            Input:
+               (none)
+
+            Output:
+               bool
+         */
+         inline bool isShared() const {return value.use_count() > 1;}
+   };
+}
+
+
+#endif
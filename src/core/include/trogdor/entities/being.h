@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <memory>
 #include <map>
+#include <vector>
 #include <unordered_map>
 #include <random>
 
@@ -81,7 +82,13 @@ namespace trogdor::entity {
 
          // getInventoryObjectsByName() returns a reference to this empty list
          // whenever a name turns up zero results.
-         static std::list<std::weak_ptr<Object>> emptyObjectList;
+         static std::vector<std::weak_ptr<Object>> emptyObjectList;
+
+         // Handles of the Tangibles that remember the Being glancing at or
+         // observing them, sorted by index. When the Being leaves the game,
+         // these are the only Tangibles Game has to tell to forget it.
+         std::vector<EntityHandle> observedTangibles;
+         std::mutex observedTangiblesMutex;
 
          // If Being is dropping an ephemeral Resource, we call this to free the
          // allocation.
@@ -99,7 +106,7 @@ namespace trogdor::entity {
                return;
             }
 
-            std::string message = resource->getMessage("drop");
+            std::string message(resource->getMessage("drop"));
 
             switch(resource->free(getShared(), amount)) {
 
@@ -177,7 +184,7 @@ namespace trogdor::entity {
                      for (auto const &thing: location->getThings()) {
                         if (thing.get() != this) {
                            thing->out("notifications")
-                              << getProperty<std::string>(TitleProperty)
+                              << getPropertyRef<std::string>(PROPERTY_SLOT_TITLE)
                               << " drops " << resource->amountToString(amount) << ' '
                               << resource->titleToString(amount) << "." << std::endl;
                         }
@@ -203,8 +210,8 @@ namespace trogdor::entity {
                            << std::endl;
                      } else {
                      out("display") << "This place can only hold "
-                        << resource->amountToString(resource->getProperty<double>(Resource::MaxAmtPerDepositorProperty))
-                        << ' ' << resource->titleToString(resource->getProperty<double>(Resource::MaxAmtPerDepositorProperty))
+                        << resource->amountToString(resource->getProperty<double>(PROPERTY_SLOT_MAX_AMT_PER_DEPOSITOR))
+                        << ' ' << resource->titleToString(resource->getProperty<double>(PROPERTY_SLOT_MAX_AMT_PER_DEPOSITOR))
                         << '.' << std::endl;
                      }
 
@@ -264,16 +271,32 @@ namespace trogdor::entity {
 
          struct {
 
-            // Inventory items. I used to use std::set<std::shared_ptr<Object>>,
-            // but I can't use a weak_ptr as a key, and since I'm ordering the
-            // objects in the set alphabetically anyway, I'll just use std::map
-            // instead with the Object's name used for the key.
-            std::map<std::string, std::weak_ptr<Object>> objects;
+            // Inventory items, kept sorted by name so that they're listed
+            // alphabetically and can be found with a binary search. A Being
+            // rarely carries so much that shifting the vector on insert or
+            // removal costs more than chasing a tree's nodes would.
+            std::vector<std::pair<std::string, std::weak_ptr<Object>>> objects;
+
+            // The weight counted toward the total for each item, in the same
+            // order as objects
+            std::vector<int> weights;
 
             // Inventory items indexed by alias
-            std::unordered_map<std::string, std::list<std::weak_ptr<Object>>> objectsByName;
+            std::unordered_map<std::string, std::vector<std::weak_ptr<Object>>> objectsByName;
+
+            // Combined weight of everything in the inventory. It's updated as
+            // Objects come and go and whenever an Object's weight changes, so
+            // that checking whether another one will fit doesn't have to add
+            // up the whole inventory.
+            int weight = 0;
          } inventory;
 
+         // This callback, which fires whenever a property is set on an
+         // inventory Object, keeps the inventory's total weight up to date if
+         // it was the Object's weight that changed. It's added by
+         // insertIntoInventory() and removed by removeFromInventory().
+         std::shared_ptr<EntityCallback> updateObjectWeight;
+
          /*
             Overrides Tangible::display() in order to handle the description of
             living vs. deceased Beings.
@@ -313,15 +336,45 @@ namespace trogdor::entity {
          inline void indexInventoryItemName(std::string alias, Object *object) {
 
             mutex.lock();
+            inventory.objectsByName[alias].push_back(object->getShared());
+            mutex.unlock();
+         }
 
-            if (inventory.objectsByName.find(alias) == inventory.objectsByName.end()) {
-               inventory.objectsByName[alias] = {};
-            }
+         /*
+            Returns the position of the named Object in the inventory, or the
+            position where it would be inserted if it isn't there. Assumes the
+            Being is locked.
 
-            inventory.objectsByName.find(alias)->second.push_back(object->getShared());
-            mutex.unlock();
+            Input:
+               Object's name (const std::string &)
+
+            Output:
+               Iterator into inventory.objects
+         */
+         inline auto findInventoryObject(const std::string &name) {
+
+            return std::lower_bound(
+               inventory.objects.begin(),
+               inventory.objects.end(),
+               name,
+               [](const std::pair<std::string, std::weak_ptr<Object>> &item, const std::string &name) {
+                  return item.first < name;
+               }
+            );
          }
 
+         /*
+            Brings the inventory's total weight up to date after an Object in
+            it was given a new weight.
+
+            Input:
+               Object whose weight changed (Object *)
+
+            Output:
+               (none)
+         */
+         void updateInventoryWeight(Object *object);
+
          /*
             Calculates amount of damage (in hit points) that we do when we
             attack another Being.
@@ -438,7 +491,7 @@ namespace trogdor::entity {
          */
          inline bool isAlive() const {
 
-            return getProperty<int>(HealthProperty) || !getProperty<int>(MaxHealthProperty) ? true : false;
+            return getProperty<int>(PROPERTY_SLOT_HEALTH) || !getProperty<int>(PROPERTY_SLOT_MAX_HEALTH) ? true : false;
          }
 
          /*
@@ -452,7 +505,7 @@ namespace trogdor::entity {
          */
          inline bool isImmortal() const {
 
-            return 0 == getProperty<int>(MaxHealthProperty) ? true : false;
+            return 0 == getProperty<int>(PROPERTY_SLOT_MAX_HEALTH) ? true : false;
          }
 
          /*
@@ -464,21 +517,46 @@ namespace trogdor::entity {
             Output:
                current weight (int)
          */
-         inline int const getInventoryCurWeight() const {
+         inline int const getInventoryCurWeight() const {return inventory.weight;}
 
-            int weight = 0;
+         /*
+            Records that a Tangible remembers the Being glancing at or
+            observing it. Tangible calls this the first time it records an
+            observation by the Being.
 
-            // Calculating this on the fly each time seems wasteful, but I'm
-            // not sure how else to handle this right now when an Object could
-            // be externally invalidated at any time.
-            for (const auto &objPtr: inventory.objects) {
-               if (const auto &object = objPtr.second.lock()) {
-                  weight += object->getProperty<int>(Object::WeightProperty);
-               }
-            }
+            Input:
+               Handle of the Tangible (EntityHandle)
 
-            return weight;
-         }
+            Output:
+               (none)
+         */
+         void addObservedTangible(EntityHandle tangible);
+
+         /*
+            Returns the handles of the Tangibles that remember the Being and
+            clears the list. Game calls this when the Being leaves the game.
+            Handles of Tangibles that have since left the game may be
+            included; they'll no longer resolve.
+
+            Input:
+               (none)
+
+            Output:
+               Tangible handles (std::vector<EntityHandle>)
+         */
+         std::vector<EntityHandle> takeObservedTangibles();
+
+         /*
+            Returns the number of Tangibles that remember the Being glancing at
+            or observing them.
+
+            Input:
+               (none)
+
+            Output:
+               Number of Tangibles (size_t)
+         */
+         size_t getNumObservedTangibles();
 
          /*
             Returns all objects in the Being's inventory.
@@ -487,7 +565,7 @@ namespace trogdor::entity {
                (none)
 
             Output:
-               Set of objects in the inventory
+               Vector of (name, object) pairs sorted by name
          */
          inline const auto &getInventoryObjects() const {return inventory.objects;}
 
@@ -558,8 +636,8 @@ namespace trogdor::entity {
          inline void notifyHealth() {
 
             out("health") << std::string("{\"health\":") +
-               std::to_string(getProperty<int>(HealthProperty)) + ",\"maxHealth\":" +
-               std::to_string(getProperty<int>(MaxHealthProperty)) + '}';
+               std::to_string(getProperty<int>(PROPERTY_SLOT_HEALTH)) + ",\"maxHealth\":" +
+               std::to_string(getProperty<int>(PROPERTY_SLOT_MAX_HEALTH)) + '}';
             out("health").flush();
          }
 
@@ -574,11 +652,11 @@ namespace trogdor::entity {
          */
          inline void incRespawnLives() {
 
-            int respawnLives = getProperty<int>(RespawnLivesProperty);
+            int respawnLives = getProperty<int>(PROPERTY_SLOT_RESPAWN_LIVES);
 
             // only increment number of lives if not unlimited
             if (respawnLives > -1) {
-               setProperty(RespawnLivesProperty, respawnLives + 1);
+               setProperty(PROPERTY_SLOT_RESPAWN_LIVES, respawnLives + 1);
             }
          }
 
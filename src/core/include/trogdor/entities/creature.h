@@ -21,6 +21,13 @@ namespace trogdor::entity {
             ENEMY
          };
 
+         // How a wandering Creature chooses which Room to go to next
+         enum WanderMode {
+            WANDER_RANDOM, // Take any exit
+            WANDER_PURSUE, // Head toward the nearest Player
+            WANDER_FLEE    // Head away from the nearest Player
+         };
+
          // Wander interval property must be greater than or equal to 1
          static constexpr int WANDER_INTERVAL_LESS_THAN_ONE = 2;
 
@@ -56,6 +63,10 @@ namespace trogdor::entity {
          // each time it considers doing so
          static constexpr const char *WanderLustProperty = "wander.lust";
 
+         // How the Creature chooses which Room to move to (see enum
+         // WanderMode)
+         static constexpr const char *WanderModeProperty = "wander.mode";
+
          // by default, a creature will automatically attack when attacked
          static constexpr bool DEFAULT_COUNTER_ATTACK = true;
          static constexpr enum AllegianceType DEFAULT_ALLEGIANCE = NEUTRAL;
@@ -69,6 +80,7 @@ namespace trogdor::entity {
          static constexpr bool DEFAULT_WANDER_ENABLED = false;
          static constexpr int DEFAULT_WANDER_INTERVAL = 10;
          static constexpr double DEFAULT_WANDER_LUST = 0.5;
+         static constexpr enum WanderMode DEFAULT_WANDER_MODE = WANDER_RANDOM;
 
       private:
 
@@ -77,7 +89,7 @@ namespace trogdor::entity {
          struct DamageComparator {
 
             inline bool operator() (const Object * const &lhs, const Object * const &rhs) const {
-               return lhs->getProperty<int>(Object::DamageProperty) < rhs->getProperty<int>(Object::DamageProperty);
+               return lhs->getProperty<int>(PROPERTY_SLOT_DAMAGE) < rhs->getProperty<int>(PROPERTY_SLOT_DAMAGE);
             }
          };
 
@@ -97,6 +109,25 @@ namespace trogdor::entity {
          // the first time an object is added to a creature's inventory.
          std::shared_ptr<std::function<bool(std::any)>> updateObjectTag;
 
+         // The Thing a Creature is pursuing or fleeing from. Once chosen, the
+         // Creature sticks with its target until it's removed from the game,
+         // dies, or can no longer be reached, so that it doesn't flip-flop
+         // between Players who are about the same distance away.
+         std::weak_ptr<Thing> wanderTarget;
+
+         /*
+            Returns the Creature's current wander target if it's still valid,
+            or else chooses the nearest living Player that can be reached from
+            the Creature's location. Returns nullptr if there isn't one.
+
+            Input:
+               The Creature's current location (const Room *)
+
+            Output:
+               std::shared_ptr<Thing>
+         */
+         std::shared_ptr<Thing> acquireWanderTarget(const Room *location);
+
          /*
             Sets property validators for all properties settable by Creature.
 
@@ -210,7 +241,7 @@ namespace trogdor::entity {
          */
          inline std::string getAllegianceStr() const {
 
-            switch (getProperty<int>(AllegianceProperty)) {
+            switch (getProperty<int>(PROPERTY_SLOT_ALLEGIANCE)) {
 
                case FRIEND:
                   return "friend";
@@ -241,6 +272,47 @@ namespace trogdor::entity {
          */
          Object *selectWeapon();
 
+         /*
+            Returns the Thing the Creature is pursuing or fleeing from, if any.
+
+            Input:
+               (none)
+
+            Output:
+               std::shared_ptr<Thing>
+         */
+         std::shared_ptr<Thing> getWanderTarget();
+
+         /*
+            Sets the Thing the Creature should pursue or flee from when it
+            wanders. This doesn't have to be a Player. If the target is later
+            removed, dies, or can't be reached, the Creature will go back to
+            picking the nearest Player on its own.
+
+            Input:
+               Target (const std::shared_ptr<Thing> &)
+
+            Output:
+               (none)
+         */
+         void setWanderTarget(const std::shared_ptr<Thing> &target);
+
+         /*
+            Chooses the Room the Creature would go to if it wandered right now,
+            according to its wander mode. Pursuing and fleeing Creatures follow
+            the Game's RoomGraph toward or away from their target, and fall
+            back to a random exit if there's no target they can reach. Returns
+            nullptr if the Creature should stay put (it isn't in a Room, has
+            nowhere to go, has caught up with its target, or is cornered.)
+
+            Input:
+               (none)
+
+            Output:
+               std::shared_ptr<Room>
+         */
+         std::shared_ptr<Room> selectWanderDestination();
+
          /*
             Triggers the Creature to possibly wander into another room subject
             to the values set in wanderSettings. If the Creature is dead, they
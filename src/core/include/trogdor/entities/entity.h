@@ -4,15 +4,21 @@
 
 #include <any>
 #include <list>
+#include <vector>
 #include <set>
+#include <array>
+#include <bitset>
 #include <memory>
-#include <regex>
 #include <unordered_set>
 
 #include <trogdor/game.h>
 
 #include <trogdor/entities/type.h>
+#include <trogdor/entities/entityhandle.h>
+#include <trogdor/entities/propertyslot.h>
+#include <trogdor/entities/tagslot.h>
 #include <trogdor/messages.h>
+#include <trogdor/copyonwrite.h>
 
 #include <trogdor/lua/luatable.h>
 #include <trogdor/lua/luastate.h>
@@ -40,6 +46,29 @@ namespace trogdor::entity {
    // Defines a valid entity or entity class name
    static constexpr const char *validEntityNameRegex = "^[ A-Za-z0-9_-]+$";
 
+   // The characters matched by validEntityNameRegex, indexed by unsigned char.
+   // Entity::isNameValid() checks names against this table rather than
+   // compiling the regex every time it's called.
+   static constexpr std::array<bool, 256> validEntityNameChars = [] {
+
+      std::array<bool, 256> chars = {};
+
+      for (unsigned char c = 'a'; c <= 'z'; c++) {
+         chars[c] = true;
+         chars[c - 'a' + 'A'] = true;
+      }
+
+      for (unsigned char c = '0'; c <= '9'; c++) {
+         chars[c] = true;
+      }
+
+      chars[' '] = true;
+      chars['_'] = true;
+      chars['-'] = true;
+
+      return chars;
+   }();
+
    // An entity name cannot be any of these
    static const char *reservedNames[] = {
       "myself",
@@ -75,39 +104,224 @@ namespace trogdor::entity {
          // Valid types for a single entity property value
          typedef std::variant<size_t, int, double, bool, std::string> PropertyValue;
 
+         // How property values are stored internally. Strings are pooled (see
+         // stringpool.h), so that when an Entity that shares its properties
+         // with others changes one of them, like its health during combat,
+         // copying the rest doesn't copy its title and descriptions too.
+         typedef std::variant<size_t, int, double, bool, PooledString> StoredPropertyValue;
+
       private:
 
+         // Properties, indexed by PropertySlot for built-in properties like
+         // title, description, etc. (see propertyslot.h) and by name for
+         // custom properties that don't have a slot
+         struct Properties {
+            std::array<StoredPropertyValue, NUM_PROPERTY_SLOTS> slots;
+            std::bitset<NUM_PROPERTY_SLOTS> slotsSet;
+            std::unordered_map<std::string, StoredPropertyValue> custom;
+         };
+
+         // Maps entity properties to their validation functions (if they exist)
+         struct PropertyValidators {
+            std::array<std::function<int(PropertyValue)>, NUM_PROPERTY_SLOTS> slots;
+            std::unordered_map<std::string, std::function<int(PropertyValue)>> custom;
+         };
+
+         // Everything below that's wrapped in CopyOnWrite is shared between an
+         // Entity and the copies made from it (usually instances created from
+         // a class prototype) until one of them changes it. Anything that
+         // modifies them must go through write().
+
          // Custom messages that should be displayed for certain events that act
          // on or with the Entity
-         Messages msgs;
+         CopyOnWrite<Messages> msgs;
 
          // Entity tags are labels that are either set or not set and are an
-         // easy method of categorization
-         std::unordered_set<std::string> tags;
+         // easy method of categorization. Built-in tags are stored as bits
+         // indexed by TagSlot (see tagslot.h), and custom tags by name.
+         std::bitset<NUM_TAG_SLOTS> slotTags;
+         CopyOnWrite<std::unordered_set<std::string>> customTags;
 
          // meta data associated with the entity
          std::unordered_map<std::string, std::string> meta;
 
-         // Entity properties like title, description, etc.
-         std::unordered_map<std::string, PropertyValue> properties;
+         // The Entity's properties and their validators
+         CopyOnWrite<Properties> properties;
+         CopyOnWrite<PropertyValidators> propertyValidators;
 
-         // Maps entity properties to their validation functions (if they exist)
-         std::unordered_map<
-            std::string,
-            std::function<int(PropertyValue)>
-         > propertyValidators;
+         /*
+            Converts a property value to the requested type. Numeric types are
+            a little more flexible and can in some cases be promoted to other
+            types. Throws std::bad_variant_access if the value can't be
+            converted.
+
+            Template arguments:
+               The type to be returned
+
+            Input:
+               Property value (const StoredPropertyValue &)
+
+            Output:
+               Property (template type)
+         */
+         template<typename T> static inline T convertProperty(const StoredPropertyValue &value) {
+
+            // Strings are stored as PooledStrings
+            if constexpr (std::is_same_v<T, std::string>) {
+               return std::get<PooledString>(value).str();
+            }
+
+            else switch (value.index()) {
+
+               case 0: // size_t
+
+      				if constexpr (std::is_same_v<T, int>) {
+                     return static_cast<int>(std::get<size_t>(value));
+                  }
+
+      				if constexpr (std::is_same_v<T, double>) {
+                     return static_cast<double>(std::get<size_t>(value));
+                  }
+
+                  // Will fail as expected if type isn't size_t
+                  else {
+                     return std::get<T>(value);
+                  }
+
+               case 1: // int
+
+      				if constexpr (std::is_same_v<T, double>) {
+                     return static_cast<double>(std::get<int>(value));
+                  }
+
+                  else {
+                     return std::get<T>(value);
+                  }
+
+               case 2: // double
+
+                  // I'll allow the loss of precision if we want to get a double
+                  // as an int
+      				if constexpr (std::is_same_v<T, int>) {
+                     return static_cast<int>(std::get<double>(value));
+                  }
+
+                  else {
+                     return std::get<T>(value);
+                  }
+
+               default:
+                  return std::get<T>(value);
+            }
+         }
+
+         /*
+            Converts a property value to the form it's stored in and back.
+
+            Input:
+               Property value (const PropertyValue & or const StoredPropertyValue &)
+
+            Output:
+               Converted value (StoredPropertyValue or PropertyValue)
+         */
+         static inline StoredPropertyValue storePropertyValue(const PropertyValue &value) {
+
+            switch (value.index()) {
+
+               case 0:
+                  return std::get<size_t>(value);
+
+               case 1:
+                  return std::get<int>(value);
+
+               case 2:
+                  return std::get<double>(value);
+
+               case 3:
+                  return std::get<bool>(value);
+
+               default:
+                  return PooledString(std::get<std::string>(value));
+            }
+         }
+
+         static inline PropertyValue loadPropertyValue(const StoredPropertyValue &value) {
+
+            switch (value.index()) {
+
+               case 0:
+                  return std::get<size_t>(value);
+
+               case 1:
+                  return std::get<int>(value);
+
+               case 2:
+                  return std::get<double>(value);
+
+               case 3:
+                  return std::get<bool>(value);
+
+               default:
+                  return std::get<PooledString>(value).str();
+            }
+         }
+
+         /*
+            Returns a reference to a stored property value of exactly type T.
+            Throws std::bad_variant_access if it's some other type.
+
+            Template arguments:
+               The type to be returned
+
+            Input:
+               Property value (const StoredPropertyValue &)
+
+            Output:
+               Property (const template type &)
+         */
+         template<typename T> static inline const T &getStoredRef(const StoredPropertyValue &value) {
+
+            if constexpr (std::is_same_v<T, std::string>) {
+               return std::get<PooledString>(value).str();
+            }
+
+            else {
+               return std::get<T>(value);
+            }
+         }
+
+         /*
+            Throws the exception that results from reading a property that
+            isn't set.
+
+            Input:
+               Key (const std::string &)
+
+            Output:
+               (none)
+         */
+         [[noreturn]] static inline void throwUndefinedProperty(const std::string &key) {
+
+            throw std::invalid_argument(std::string("attempted to access undefined entity property '") + key + "'");
+         }
 
       protected:
 
          std::mutex mutex;
 
-         // every kind of Entity that we are by virtue of inheritance
-         std::list<enum EntityType> types;
+         // The Entity's most specific type, along with a bitmask of every
+         // kind of Entity that we are by virtue of inheritance
+         enum EntityType type = ENTITY_UNDEFINED;
+         EntityTypeMask typeMask = 0;
 
          // Pointer to the Game that contains the Entity (set to nullptr when
          // the Entity is removed)
          Game *game;
 
+         // The Entity's handle in the Game that contains it (null when the
+         // Entity isn't part of a Game)
+         EntityHandle handle;
+
          const std::string name;
          std::string className;
 
@@ -164,6 +378,24 @@ namespace trogdor::entity {
 
          /********************************************************************/
 
+         /*
+            Called by each constructor in the hierarchy to record the type
+            being constructed. Since the most derived constructor runs last,
+            the Entity ends up with its most specific type, and the bitmask
+            for that type already includes all of its ancestors.
+
+            Input:
+               Entity type (enum EntityType)
+
+            Output:
+               (none)
+         */
+         inline void setType(enum EntityType newType) {
+
+            type = newType;
+            typeMask = entityTypeMask(newType);
+         }
+
          /*
             Executes all callbacks for the specified operation. Callbacks take
             as input arbitrary data (callback should know what kind of data it
@@ -192,11 +424,23 @@ namespace trogdor::entity {
                (none)
          */
          inline void setPropertyValidator(
-            std::string key,
+            PropertySlot slot,
             std::function<int(PropertyValue)> validator
          ) {
 
-            propertyValidators[key] = validator;
+            propertyValidators.write().slots[slot] = validator;
+         }
+
+         inline void setPropertyValidator(
+            const std::string &key,
+            std::function<int(PropertyValue)> validator
+         ) {
+
+            if (auto slot = strToPropertySlot(key)) {
+               setPropertyValidator(*slot, validator);
+            } else {
+               propertyValidators.write().custom[key] = validator;
+            }
          }
 
          /*
@@ -234,15 +478,16 @@ namespace trogdor::entity {
 
          /*
             Returns true if the given entity or class name is valid and false
-            otherwise.
+            otherwise. A valid name is one that matches validEntityNameRegex
+            and isn't reserved.
 
             Input:
-               Entity or class name (std::string)
+               Entity or class name (const std::string &)
 
             Output:
                True if the name is valid and false if not
          */
-         static inline bool isNameValid(std::string name) {
+         static inline bool isNameValid(const std::string &name) {
 
             // There are certain names that are forbidden to entities
             for (
@@ -255,7 +500,17 @@ namespace trogdor::entity {
                }
             }
 
-            return std::regex_match(name, std::regex(validEntityNameRegex)) ? true : false;
+            if (name.empty()) {
+               return false;
+            }
+
+            for (unsigned char c: name) {
+               if (!validEntityNameChars[c]) {
+                  return false;
+               }
+            }
+
+            return true;
          }
 
          /*
@@ -539,6 +794,32 @@ namespace trogdor::entity {
          */
          void setGame(Game *g);
 
+         /*
+            Returns the handle the Game issued to the Entity when it was
+            inserted, which can be used to refer to the Entity without holding
+            a shared_ptr or looking it up by name (see entityhandle.h.) If the
+            Entity isn't part of a Game, the handle will be null.
+
+            Input:
+               (none)
+
+            Output:
+               Handle (EntityHandle)
+         */
+         inline EntityHandle getHandle() const {return handle;}
+
+         /*
+            Like setGame(), this should only be called by Game when an Entity
+            is inserted or removed.
+
+            Input:
+               Handle (EntityHandle)
+
+            Output:
+               (none)
+         */
+         inline void setHandle(EntityHandle h) {handle = h;}
+
          /*
             Returns the Entity's most specific type.
 
@@ -548,7 +829,7 @@ namespace trogdor::entity {
             Output:
                (none)
          */
-         inline enum EntityType getType() const {return types.back();}
+         inline enum EntityType getType() const {return type;}
 
          /*
             Returns a string representation of the Entity's most specific type.
@@ -559,7 +840,19 @@ namespace trogdor::entity {
             Output:
                Type name (std::string)
          */
-         inline std::string getTypeName() const {return typeToStr(types.back());}
+         inline std::string getTypeName() const {return typeToStr(type);}
+
+         /*
+            Returns a bitmask with a bit set for the Entity's type and every
+            type it inherits from (see entityTypeBit() in type.h.)
+
+            Input:
+               (none)
+
+            Output:
+               Bitmask (EntityTypeMask)
+         */
+         inline EntityTypeMask getTypeMask() const {return typeMask;}
 
          /*
             Returns true if the Entity is of the given type. Examines the whole
@@ -572,28 +865,83 @@ namespace trogdor::entity {
             Output:
                true if the Entity is of the given type and false if not
          */
-         inline bool isType(enum EntityType type) const {
-
-            auto matchedType = find_if(types.begin(), types.end(),
-            [&](enum EntityType curType) {
-               return type == curType;
-            });
+         inline bool isType(enum EntityType checkType) const {
 
-            return matchedType == types.end() ? false : true;
+            return typeMask & entityTypeBit(checkType);
          }
 
          /*
-            Returns true if the given tag is set and false otherwise.
+            Returns true if the given tag is set and false otherwise. Checking
+            a built-in tag by TagSlot doesn't have to look up its name.
 
             Input:
-               Tag (std::string)
+               Tag (TagSlot or const std::string &)
 
             Output:
                Whether or not the tag is set (bool)
          */
-         inline bool isTagSet(std::string tag) const {
+         inline bool isTagSet(TagSlot slot) const {
+
+            return slotTags.test(slot);
+         }
+
+         inline bool isTagSet(const std::string &tag) const {
+
+            if (auto slot = strToTagSlot(tag)) {
+               return slotTags.test(*slot);
+            }
+
+            return customTags->end() != customTags->find(tag) ? true : false;
+         }
+
+         /*
+            Calls the given function once for each tag that's set. Built-in
+            tags are visited first, in slot order.
+
+            Template arguments:
+               Callable type (deduced)
+
+            Input:
+               Function (void(const std::string &))
+
+            Output:
+               (none)
+         */
+         template<typename F> inline void forEachTag(F &&f) const {
+
+            for (size_t i = 0; i < NUM_TAG_SLOTS; i++) {
+               if (slotTags.test(i)) {
+                  f(std::string(tagSlotToStr(static_cast<TagSlot>(i))));
+               }
+            }
 
-            return tags.end() != tags.find(tag) ? true : false;
+            for (const auto &tag: *customTags) {
+               f(tag);
+            }
+         }
+
+         /*
+            Calls the given function while holding the Entity's lock, so that
+            its tags can't be set or removed on another thread in the
+            meantime. Game uses this to walk an Entity's tags as it's inserted
+            and removed, taking its own tag index lock from inside the
+            function, which keeps the Entity's lock first in the same order
+            setTag() and removeTag() use. The function must not call anything
+            else that locks the Entity.
+
+            Template arguments:
+               Callable type (deduced)
+
+            Input:
+               Function (void())
+
+            Output:
+               (none)
+         */
+         template<typename F> inline void withTagsLocked(F &&f) {
+
+            std::lock_guard<std::mutex> lock(mutex);
+            f();
          }
 
          /*
@@ -615,84 +963,185 @@ namespace trogdor::entity {
             return meta.find(key)->second;
          }
 
+         /*
+            Returns a pointer to the property's value, or nullptr if it isn't
+            set. The pointer is invalidated when any of the Entity's properties
+            are next set or removed.
+
+            Input:
+               Key (PropertySlot or const std::string &)
+
+            Output:
+               const StoredPropertyValue * (strings are stored as PooledStrings)
+         */
+         inline const StoredPropertyValue *findProperty(PropertySlot slot) const {
+
+            return properties->slotsSet.test(slot) ? &properties->slots[slot] : nullptr;
+         }
+
+         inline const StoredPropertyValue *findProperty(const std::string &key) const {
+
+            if (auto slot = strToPropertySlot(key)) {
+               return findProperty(*slot);
+            }
+
+            auto property = properties->custom.find(key);
+            return properties->custom.end() != property ? &property->second : nullptr;
+         }
+
          /*
             Returns true if the entity property is set and false if not.
 
             Input:
-               Key (std::string)
+               Key (PropertySlot or const std::string &)
 
             Output:
                Whether or not the property is set (bool)
          */
-         inline bool isPropertySet(std::string key) const {
+         inline bool isPropertySet(PropertySlot slot) const {
+
+            return properties->slotsSet.test(slot);
+         }
+
+         inline bool isPropertySet(const std::string &key) const {
+
+            return findProperty(key) ? true : false;
+         }
+
+         /*
+            Calls the given function once for each of the Entity's properties,
+            passing in the property's name and value. Built-in properties are
+            visited first, in slot order.
+
+            Template arguments:
+               Callable type (deduced)
+
+            Input:
+               Function (void(const std::string &, const PropertyValue &))
+
+            Output:
+               (none)
+         */
+         template<typename F> inline void forEachProperty(F &&f) const {
+
+            for (size_t i = 0; i < NUM_PROPERTY_SLOTS; i++) {
+               if (properties->slotsSet.test(i)) {
+                  f(std::string(propertySlotToStr(static_cast<PropertySlot>(i))), loadPropertyValue(properties->slots[i]));
+               }
+            }
+
+            for (const auto &property: properties->custom) {
+               f(property.first, loadPropertyValue(property.second));
+            }
+         }
+
+         /*
+            Returns the number of properties that are set.
+
+            Input:
+               (none)
+
+            Output:
+               Number of properties (size_t)
+         */
+         inline size_t getPropertyCount() const {
+
+            return properties->slotsSet.count() + properties->custom.size();
+         }
+
+         /*
+            Returns a copy of all the Entity's properties, indexed by name.
+            Prefer forEachProperty(), which doesn't have to build a map.
+
+            Input:
+               (none)
+
+            Output:
+               std::unordered_map<std::string, PropertyValue>
+         */
+         inline std::unordered_map<std::string, PropertyValue> getProperties() const {
+
+            std::unordered_map<std::string, PropertyValue> properties;
+
+            properties.reserve(getPropertyCount());
+            forEachProperty([&](const std::string &key, const PropertyValue &value) {
+               properties[key] = value;
+            });
 
-            return properties.end() != properties.find(key) ? true : false;
+            return properties;
          }
 
          /*
             Returns the value of a property. Throws std::invalid_argument if the
             property isn't set and std::bad_variant_access if an attempt is made
-            to access a property with the incorrect type.
+            to access a property with the incorrect type. Numeric types can be
+            promoted (see convertProperty().)
+
+            Looking a property up by slot skips hashing its name, so prefer it
+            for built-in properties.
 
             Template arguments:
                The type to be returned
 
             Input:
-               Key (std::string)
+               Key (PropertySlot or const std::string &)
 
             Output:
                Property (template type)
          */
-         template<typename T> inline const T getProperty(std::string key) const {
+         template<typename T> inline const T getProperty(PropertySlot slot) const {
 
-            if (properties.end() == properties.find(key)) {
-               throw std::invalid_argument(std::string("attempted to access undefined entity property '") + key + "'");
+            if (!properties->slotsSet.test(slot)) {
+               throwUndefinedProperty(propertySlotToStr(slot));
             }
 
-            // The rules should be a little more flexible for numeric types,
-            // which can in some cases be promoted to other types
-            switch (properties.find(key)->second.index()) {
+            return convertProperty<T>(properties->slots[slot]);
+         }
 
-               case 0: // size_t
+         template<typename T> inline const T getProperty(const std::string &key) const {
 
-      				if constexpr (std::is_same_v<T, int>) {
-                     return static_cast<int>(std::get<size_t>(properties.find(key)->second));
-                  }
+            const StoredPropertyValue *value = findProperty(key);
 
-      				if constexpr (std::is_same_v<T, double>) {
-                     return static_cast<double>(std::get<size_t>(properties.find(key)->second));
-                  }
+            if (!value) {
+               throwUndefinedProperty(key);
+            }
 
-                  // Will fail as expected if type isn't size_t
-                  else {
-                     return std::get<T>(properties.find(key)->second);
-                  }
+            return convertProperty<T>(*value);
+         }
 
-               case 1: // int
+         /*
+            Like getProperty(), but returns a reference to the stored value
+            instead of a copy. No numeric promotion is performed, so T must be
+            the exact type that's stored. The reference is invalidated when any
+            of the Entity's properties are next set or removed.
 
-      				if constexpr (std::is_same_v<T, double>) {
-                     return static_cast<double>(std::get<int>(properties.find(key)->second));
-                  }
+            Template arguments:
+               The type to be returned
 
-                  else {
-                     return std::get<T>(properties.find(key)->second);
-                  }
+            Input:
+               Key (PropertySlot or const std::string &)
 
-               case 2: // double
+            Output:
+               Property (const template type &)
+         */
+         template<typename T> inline const T &getPropertyRef(PropertySlot slot) const {
 
-                  // I'll allow the loss of precision if we want to get a double
-                  // as an int
-      				if constexpr (std::is_same_v<T, int>) {
-                     return static_cast<int>(std::get<double>(properties.find(key)->second));
-                  }
+            if (!properties->slotsSet.test(slot)) {
+               throwUndefinedProperty(propertySlotToStr(slot));
+            }
 
-                  else {
-                     return std::get<T>(properties.find(key)->second);
-                  }
+            return getStoredRef<T>(properties->slots[slot]);
+         }
 
-               default:
-                  return std::get<T>(properties.find(key)->second);
+         template<typename T> inline const T &getPropertyRef(const std::string &key) const {
+
+            const StoredPropertyValue *value = findProperty(key);
+
+            if (!value) {
+               throwUndefinedProperty(key);
             }
+
+            return getStoredRef<T>(*value);
          }
 
          /*
@@ -707,24 +1156,57 @@ namespace trogdor::entity {
             key, and property value being passed in as a std::tuple.
 
             Input:
-               Key (std::string)
+               Key (PropertySlot or const std::string &)
                Value (PropertyValue)
 
             Output:
                A status code indicating success or the reason for failure (int)
          */
-         inline int setProperty(std::string key, PropertyValue value) {
+         inline int setProperty(PropertySlot slot, PropertyValue value) {
 
             int status = PROPERTY_VALID;
 
-            if (propertyValidators.end() != propertyValidators.find(key)) {
-               status = propertyValidators[key](value);
+            if (propertyValidators->slots[slot]) {
+               status = propertyValidators->slots[slot](value);
             }
 
             if (PROPERTY_VALID == status) {
 
+               StoredPropertyValue stored = storePropertyValue(value);
+
                mutex.lock();
-               properties[key] = value;
+               Properties &writable = properties.write();
+               writable.slots[slot] = std::move(stored);
+               writable.slotsSet.set(slot);
+               mutex.unlock();
+
+               executeCallback(
+                  "setProperty",
+                  std::tuple<Entity *, std::string, PropertyValue>({this, propertySlotToStr(slot), value})
+               );
+            }
+
+            return status;
+         }
+
+         inline int setProperty(const std::string &key, PropertyValue value) {
+
+            if (auto slot = strToPropertySlot(key)) {
+               return setProperty(*slot, value);
+            }
+
+            int status = PROPERTY_VALID;
+
+            if (auto validator = propertyValidators->custom.find(key); propertyValidators->custom.end() != validator) {
+               status = validator->second(value);
+            }
+
+            if (PROPERTY_VALID == status) {
+
+               StoredPropertyValue stored = storePropertyValue(value);
+
+               mutex.lock();
+               properties.write().custom[key] = std::move(stored);
                mutex.unlock();
 
                executeCallback(
@@ -741,7 +1223,12 @@ namespace trogdor::entity {
          // setProperty() without casting (example: setProperty("key", 0) results
          // in the result being seen as a nullptr and triggers this wrapper
          // method as if it were a string, which will throw an exception. Grr.)
-         inline int setProperty(std::string key, const char *value) {
+         inline int setProperty(PropertySlot slot, const char *value) {
+
+            return setProperty(slot, std::string(value));
+         }
+
+         inline int setProperty(const std::string &key, const char *value) {
 
             return setProperty(key, std::string(value));
          }
@@ -751,15 +1238,40 @@ namespace trogdor::entity {
             (effectively 1 if the element existed and 0 if it didn't.)
 
             Input:
-               Key (std::string)
+               Key (PropertySlot or const std::string &)
 
             Output:
                Number of elements erased (size_t)
          */
-         inline size_t removeProperty(std::string key) {
+         inline size_t removeProperty(PropertySlot slot) {
 
             mutex.lock();
-            size_t numErased = properties.erase(key);
+
+            size_t numErased = 0;
+
+            // Don't unshare the properties if there's nothing to remove
+            if (properties->slotsSet.test(slot)) {
+
+               Properties &writable = properties.write();
+
+               writable.slotsSet.reset(slot);
+               writable.slots[slot] = StoredPropertyValue();
+               numErased = 1;
+            }
+
+            mutex.unlock();
+
+            return numErased;
+         }
+
+         inline size_t removeProperty(const std::string &key) {
+
+            if (auto slot = strToPropertySlot(key)) {
+               return removeProperty(*slot);
+            }
+
+            mutex.lock();
+            size_t numErased = properties->custom.count(key) ? properties.write().custom.erase(key) : 0;
             mutex.unlock();
 
             return numErased;
@@ -783,9 +1295,9 @@ namespace trogdor::entity {
                (none)
 
             Output:
-               Entity's name (std::string)
+               Entity's name (const std::string &)
          */
-         inline std::string getName() const {return name;}
+         inline const std::string &getName() const {return name;}
 
          /*
             Returns reference to entity's event listener.
@@ -800,15 +1312,18 @@ namespace trogdor::entity {
 
          /*
             Returns the specified message.  If it doesn't exist, an empty string
-            is returned.
+            is returned. Messages are pooled (see stringpool.h), so this doesn't
+            copy anything, but the view is only valid until the message is next
+            set. Copy it into a std::string if it needs to outlive anything that
+            might do that (triggering an event, for example.)
 
             Input:
-               Message name (std::string)
+               Message name (const std::string &)
 
             Output:
-               Message (std::string)
+               Message (std::string_view)
          */
-         inline std::string getMessage(std::string message) {return msgs.get(message.c_str());}
+         inline std::string_view getMessage(const std::string &message) const {return msgs->get(message);}
 
          /*
             Passes through to msgs.set()
@@ -823,7 +1338,7 @@ namespace trogdor::entity {
          inline void setMessage(std::string name, std::string message) {
 
             mutex.lock();
-            msgs.set(name, message);
+            msgs.write().set(name, message);
             mutex.unlock();
          }
 
@@ -864,28 +1379,34 @@ namespace trogdor::entity {
          /*
             Sets a tag. This is virtual so that other Entity's can wrap around
             it and monitor for changes in tags that are relevant to their state.
+            If the Entity belongs to a Game, the Game's tag index is updated.
 
             Input:
-               Tag (std::string)
+               Tag (std::string or TagSlot)
 
             Output:
                (none)
          */
          virtual void setTag(std::string tag);
 
+         inline void setTag(TagSlot slot) {setTag(tagSlotToStr(slot));}
+
          /*
             Removes a tag. This is virtual so that other Entity's can wrap
             around it and monitor for changes in tags that are relevant to their
-            state.
+            state. If the Entity belongs to a Game, the Game's tag index is
+            updated.
 
             Input:
-               Tag (std::string)
+               Tag (std::string or TagSlot)
 
             Output:
                (none)
          */
          virtual void removeTag(std::string tag);
 
+         inline void removeTag(TagSlot slot) {removeTag(tagSlotToStr(slot));}
+
          /*
             Static method that takes as input iterators over a list of Entities
             that match a given name or alias, asks the Player for clarification
@@ -932,15 +1453,15 @@ namespace trogdor::entity {
 
    /***************************************************************************/
 
-   typedef std::list<Resource *> ResourceList;
-   typedef std::list<Tangible *> TangibleList;
-   typedef std::list<Place *>    PlaceList;
-   typedef std::list<Room *>     RoomList;
-   typedef std::list<Thing *>    ThingList;
-   typedef std::list<Being *>    BeingList;
-   typedef std::list<Player *>   PlayerList;
-   typedef std::list<Creature *> CreatureList;
-   typedef std::list<Object *>   ObjectList;
+   typedef std::list<Resource *>   ResourceList;
+   typedef std::list<Tangible *>   TangibleList;
+   typedef std::list<Place *>      PlaceList;
+   typedef std::list<Room *>       RoomList;
+   typedef std::vector<Thing *>    ThingList;
+   typedef std::vector<Being *>    BeingList;
+   typedef std::vector<Player *>   PlayerList;
+   typedef std::vector<Creature *> CreatureList;
+   typedef std::list<Object *>     ObjectList;
 
    typedef std::unordered_map<std::string, ResourceList> ResourcesByNameMap;
    typedef std::unordered_map<std::string, TangibleList> TangiblesByNameMap;
@@ -0,0 +1,168 @@
+#ifndef ENTITY_HANDLE_H
+#define ENTITY_HANDLE_H
+
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace trogdor::entity {
+
+
+   class Entity;
+
+   /*
+      A lightweight, non-owning reference to an Entity that's been inserted
+      into a Game. A handle is a slot index into the Game's EntityHandleTable
+      plus the generation of the Entity that occupied the slot when the handle
+      was issued. When an Entity is removed, its slot's generation is bumped,
+      so every handle that still refers to it resolves to nullptr instead of
+      to whatever Entity reuses the slot next.
+
+      Resolving a handle is an array lookup and a comparison, which makes it
+      cheaper than both std::weak_ptr::lock() (an atomic operation) and
+      looking an Entity up by name. Handles are only meaningful within the
+      Game that issued them, but because they're preserved when a Game is
+      serialized, they can be stored in serialized data.
+
+      A default constructed handle is null (generation 0 is never issued.)
+   */
+   struct EntityHandle {
+
+      uint32_t index = 0;
+      uint32_t generation = 0;
+
+      inline bool isNull() const {return 0 == generation;}
+      inline explicit operator bool() const {return !isNull();}
+
+      inline bool operator==(const EntityHandle &rhs) const {
+
+         return index == rhs.index && generation == rhs.generation;
+      }
+
+      inline bool operator!=(const EntityHandle &rhs) const {return !(*this == rhs);}
+   };
+
+   /*
+      Maps EntityHandles to the Entities they refer to. Each Game owns one and
+      issues a handle to every Entity it contains. The table doesn't own
+      anything; the Game's shared_ptrs keep each Entity alive for as long as
+      its slot is occupied.
+   */
+   class EntityHandleTable {
+
+      private:
+
+         // A single slot in the table
+         struct Slot {
+            Entity *entity = nullptr;  // Entity occupying the slot, if any
+            uint32_t generation = 1;   // Generation of the current (or next) occupant
+            uint32_t freePos = 0;      // Where the slot is in freeSlots while it's unoccupied
+         };
+
+         std::vector<Slot> slots;
+
+         // Indices of unoccupied slots that can be reused
+         std::vector<uint32_t> freeSlots;
+
+         /*
+            Adds an unoccupied slot to freeSlots, or takes it back out by
+            moving the last free slot into its place. Restoring handles out
+            of order can leave a lot of skipped slots in the list, so removal
+            can't afford to search it.
+
+            Input:
+               Slot index (uint32_t)
+
+            Output:
+               (none)
+         */
+         void pushFreeSlot(uint32_t index);
+         void eraseFreeSlot(uint32_t index);
+
+      public:
+
+         /*
+            Issues a new handle for the given Entity.
+
+            Input:
+               Entity (Entity *)
+
+            Output:
+               New handle (EntityHandle)
+         */
+         EntityHandle insert(Entity *entity);
+
+         /*
+            Places an Entity in the slot named by a previously issued handle,
+            so that handles saved before a Game was serialized still resolve
+            after it's deserialized. Returns false without doing anything if
+            the slot is already occupied, in which case the caller should
+            issue a new handle with insert().
+
+            Input:
+               Handle (EntityHandle)
+               Entity (Entity *)
+
+            Output:
+               Whether or not the Entity was placed (bool)
+         */
+         bool insert(EntityHandle handle, Entity *entity);
+
+         /*
+            Frees an Entity's slot, invalidating every copy of its handle. Does
+            nothing if the handle is already invalid.
+
+            Input:
+               Handle (EntityHandle)
+
+            Output:
+               (none)
+         */
+         void remove(EntityHandle handle);
+
+         /*
+            Removes every Entity from the table.
+
+            Input:
+               (none)
+
+            Output:
+               (none)
+         */
+         void clear();
+
+         /*
+            Returns the Entity a handle refers to, or nullptr if that Entity
+            has since been removed (or the handle is null.)
+
+            Input:
+               Handle (EntityHandle)
+
+            Output:
+               Entity *
+         */
+         inline Entity *resolve(EntityHandle handle) const {
+
+            if (handle.index < slots.size() && slots[handle.index].generation == handle.generation) {
+               return slots[handle.index].entity;
+            }
+
+            return nullptr;
+         }
+
+         /*
+            Returns the number of Entities currently in the table.
+
+            Input:
+               (none)
+
+            Output:
+               Number of Entities (size_t)
+         */
+         inline size_t size() const {return slots.size() - freeSlots.size();}
+   };
+}
+
+
+#endif
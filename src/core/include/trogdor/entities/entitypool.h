@@ -0,0 +1,312 @@
+#ifndef ENTITYPOOL_H
+#define ENTITYPOOL_H
+
+
+#include <new>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+#include <unordered_map>
+
+#include <trogdor/entities/type.h>
+
+
+namespace trogdor::entity {
+
+
+   class Entity;
+   class Room;
+   class Object;
+   class Creature;
+   class Resource;
+
+   /*
+      Fixed-size block allocator for a Game's Entities. Each Game owns one, and
+      every Room, Object, Creature and Resource it creates (whether they come
+      from a game definition, a saved game or a Lua script) is allocated from
+      it. Memory is carved out of large chunks, one set of chunks per Entity
+      type, so that Entities of the same type sit next to each other instead
+      of being scattered across the heap, and blocks freed by removed or
+      garbage collected Entities are reused by the next Entity of the same
+      type instead of going back to the global heap.
+
+      Ownership of a pooled Entity is handed off to a shared_ptr created by
+      share() or make(), whose deleter returns the Entity's memory to the
+      pool. The deleter keeps the pool alive, so Entities can safely outlive
+      the Game or LuaState that created them. Once the last of them is gone,
+      the pool's chunks are released all at once.
+
+      Only the Entities themselves are pooled. The containers, streams and
+      listeners they own still come from the global heap.
+   */
+   class EntityPool {
+
+      public:
+
+         // Default number of blocks allocated at a time for each Entity type
+         static constexpr size_t DEFAULT_BLOCKS_PER_CHUNK = 32;
+
+         // Usage statistics for a single Entity type
+         struct Occupancy {
+            size_t inUse;       // Number of live Entities
+            size_t capacity;    // Number of blocks allocated for the type
+            size_t blockSize;   // Size of each block in bytes
+         };
+
+         // Memory used by the pool as a whole
+         struct MemoryUsage {
+            size_t bytesInUse;     // Bytes occupied by live Entities
+            size_t bytesReserved;  // Bytes allocated for all blocks, used or not
+         };
+
+      private:
+
+         // Blocks of a single size, used for a single Entity type
+         struct Bucket {
+            size_t blockSize = 0;
+            size_t inUse = 0;
+            std::vector<std::unique_ptr<std::byte[]>> chunks;
+            std::vector<void *> freeBlocks;
+         };
+
+         // Synchronize access, since shared_ptr deleters can run on any thread
+         std::mutex mutex;
+
+         // Number of blocks to allocate each time a bucket runs out
+         size_t blocksPerChunk;
+
+         // One bucket per Entity type
+         std::unordered_map<EntityType, Bucket, std::hash<int>> buckets;
+
+         /*
+            Adds a chunk of n blocks to the bucket. Assumes the caller holds
+            the lock.
+
+            Input:
+               Bucket (Bucket &)
+               Number of blocks (size_t)
+
+            Output:
+               (none)
+         */
+         void grow(Bucket &bucket, size_t n);
+
+         /*
+            Returns a free block from the given Entity type's bucket, growing
+            the bucket if necessary.
+
+            Input:
+               Entity type (EntityType)
+               Block size (size_t)
+
+            Output:
+               Uninitialized memory (void *)
+         */
+         void *allocate(EntityType type, size_t size);
+
+         /*
+            Returns a block to its bucket.
+
+            Input:
+               Entity type (EntityType)
+               Block (void *)
+
+            Output:
+               (none)
+         */
+         void deallocate(EntityType type, void *block);
+
+         /*
+            Rounds a size up so that every block in a chunk stays suitably
+            aligned.
+
+            Input:
+               Size (size_t)
+
+            Output:
+               Block size (size_t)
+         */
+         static constexpr size_t toBlockSize(size_t size) {
+
+            return (size + alignof(std::max_align_t) - 1) /
+               alignof(std::max_align_t) * alignof(std::max_align_t);
+         }
+
+         /*
+            Maps the class of a poolable Entity to its type.
+
+            Template arguments:
+               Entity class (Room, Object, Creature or Resource)
+
+            Output:
+               Entity type (EntityType)
+         */
+         template<typename T> static constexpr EntityType typeOf() {
+
+            if constexpr (std::is_same_v<T, Room>) {
+               return ENTITY_ROOM;
+            } else if constexpr (std::is_same_v<T, Object>) {
+               return ENTITY_OBJECT;
+            } else if constexpr (std::is_same_v<T, Creature>) {
+               return ENTITY_CREATURE;
+            } else {
+               static_assert(std::is_same_v<T, Resource>, "only Rooms, Objects, Creatures and Resources can be pooled");
+               return ENTITY_RESOURCE;
+            }
+         }
+
+      public:
+
+         /*
+            Constructor.
+         */
+         EntityPool(const EntityPool &) = delete;
+         EntityPool &operator=(const EntityPool &) = delete;
+         inline EntityPool(size_t chunkSize = DEFAULT_BLOCKS_PER_CHUNK):
+         blocksPerChunk(chunkSize ? chunkSize : 1) {}
+
+         /*
+            Constructs a new Entity of type T in the pool and returns it.
+            Arguments are forwarded to T's constructor.
+
+            Template arguments:
+               Entity type (Room, Object, Creature or Resource)
+               Constructor argument types
+
+            Input:
+               Constructor arguments
+
+            Output:
+               T *
+         */
+         template<typename T, typename... Args> T *create(Args&&... args) {
+
+            static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned Entity types can't be pooled");
+
+            EntityType type = typeOf<T>();
+            void *block = allocate(type, sizeof(T));
+
+            try {
+               return new (block) T(std::forward<Args>(args)...);
+            }
+
+            catch (...) {
+               deallocate(type, block);
+               throw;
+            }
+         }
+
+         /*
+            Destroys an Entity created by create() and returns its memory to
+            the pool.
+
+            Input:
+               Entity *
+
+            Output:
+               (none)
+         */
+         void destroy(Entity *e);
+
+         /*
+            Hands ownership of a pooled Entity over to a shared_ptr. When the
+            last reference is released, the Entity is destroyed and its memory
+            is returned to the pool.
+
+            Input:
+               Pool the Entity was created in (std::shared_ptr<EntityPool>)
+               Entity *
+
+            Output:
+               std::shared_ptr<Entity>
+         */
+         static std::shared_ptr<Entity> share(
+            const std::shared_ptr<EntityPool> &pool,
+            Entity *e
+         );
+
+         /*
+            Constructs a new Entity of type T in the pool and returns a
+            shared_ptr that owns it. Equivalent to calling create() followed
+            by share().
+
+            Template arguments:
+               Entity type (Room, Object, Creature or Resource)
+               Constructor argument types
+
+            Input:
+               Pool to allocate from (std::shared_ptr<EntityPool>)
+               Constructor arguments
+
+            Output:
+               std::shared_ptr<T>
+         */
+         template<typename T, typename... Args> static std::shared_ptr<T> make(
+            const std::shared_ptr<EntityPool> &pool,
+            Args&&... args
+         ) {
+
+            T *e = pool->create<T>(std::forward<Args>(args)...);
+
+            // If the control block can't be allocated, shared_ptr calls the
+            // deleter for us
+            return std::shared_ptr<T>(e, [pool](T *e) {
+               pool->destroy(e);
+            });
+         }
+
+         /*
+            Makes sure there's room for at least n Entities of the given type
+            without having to allocate any more memory.
+
+            Input:
+               Entity type (EntityType)
+               Number of Entities (size_t)
+
+            Output:
+               (none)
+         */
+         void reserve(EntityType type, size_t n);
+
+         /*
+            Returns usage statistics for the given Entity type.
+
+            Input:
+               Entity type (EntityType)
+
+            Output:
+               Occupancy
+         */
+         Occupancy getOccupancy(EntityType type);
+
+         /*
+            Returns usage statistics for every Entity type that's been
+            allocated in the pool.
+
+            Input:
+               (none)
+
+            Output:
+               std::unordered_map<EntityType, Occupancy, std::hash<int>>
+         */
+         std::unordered_map<EntityType, Occupancy, std::hash<int>> getOccupancy();
+
+         /*
+            Returns the number of bytes occupied by live Entities and the
+            total number of bytes the pool has allocated.
+
+            Input:
+               (none)
+
+            Output:
+               MemoryUsage
+         */
+         MemoryUsage getMemoryUsage();
+   };
+}
+
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef ENTITY_VIEW_H
+#define ENTITY_VIEW_H
+
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <unordered_map>
+
+#include <trogdor/entities/type.h>
+
+namespace trogdor::entity {
+
+
+   class Entity;
+
+   /*
+      Dense list of the Entities in a Game that are of a particular type,
+      maintained by Game as Entities are inserted and removed, and iterated by
+      an EntityView. Each Entity's position in the list is stored by handle
+      index (see entityhandle.h), so that removing one is a swap with the last
+      Entity followed by a pop.
+   */
+   struct EntityTypeIndex {
+      std::vector<Entity *> entities;
+      std::vector<uint32_t> positions;
+   };
+
+   /*
+      A read-only view of the Entities in a Game's registry that are of a
+      particular type. Game stores every Entity exactly once, by name, and
+      hands out one of these for each type instead of keeping a separate
+      table per type.
+
+      A view looks and iterates like the unordered_map it replaced: each
+      element is a pair of the Entity's name and a shared_ptr to it, already
+      cast to the view's type, and find() works by name. Iterating walks the
+      type's EntityTypeIndex, so it only visits Entities of the view's type,
+      and the shared_ptr for an element is only made when it's dereferenced.
+      Looking an Entity up with find() is still a single hash lookup.
+
+      Base is always Entity. It's only a template parameter so that this
+      header can be included by game.h, where Entity is still incomplete.
+   */
+   template <typename T, typename Base = Entity> class EntityView {
+
+      public:
+
+         typedef std::unordered_map<std::string, std::shared_ptr<Base>> Registry;
+         typedef std::pair<const std::string &, std::shared_ptr<T>> value_type;
+
+         class const_iterator {
+
+            public:
+
+               typedef std::forward_iterator_tag iterator_category;
+               typedef EntityView::value_type value_type;
+               typedef std::ptrdiff_t difference_type;
+               typedef void pointer;
+               typedef value_type reference;
+
+            private:
+
+               typename std::vector<Base *>::const_iterator current;
+
+               // Lets it->second work even though elements are created on
+               // the fly rather than stored
+               struct ArrowProxy {
+                  value_type value;
+                  inline const value_type *operator->() const {return &value;}
+               };
+
+            public:
+
+               inline const_iterator(typename std::vector<Base *>::const_iterator c):
+               current(c) {}
+
+               inline value_type operator*() const {
+
+                  return {(*current)->getName(), std::static_pointer_cast<T>((*current)->getShared())};
+               }
+
+               inline ArrowProxy operator->() const {return {**this};}
+
+               /*
+                  Returns the Entity the iterator points to without making a
+                  shared_ptr.
+
+                  Input:
+                     (none)
+
+                  Output:
+                     T *
+               */
+               inline T *get() const {return static_cast<T *>(*current);}
+
+               inline const_iterator &operator++() {
+
+                  current++;
+                  return *this;
+               }
+
+               inline const_iterator operator++(int) {
+
+                  const_iterator old = *this;
+
+                  ++*this;
+                  return old;
+               }
+
+               inline bool operator==(const const_iterator &rhs) const {return current == rhs.current;}
+               inline bool operator!=(const const_iterator &rhs) const {return current != rhs.current;}
+         };
+
+         typedef const_iterator iterator;
+
+      private:
+
+         const Registry &registry;
+         enum EntityType type;
+
+         // Entities of this type, maintained by Game
+         const EntityTypeIndex &index;
+
+      public:
+
+         /*
+            Constructor.
+
+            Input:
+               Registry the view looks into (const Registry &)
+               Type of Entity visible through the view (enum EntityType)
+               Entities of that type, kept up to date by the owner (const EntityTypeIndex &)
+         */
+         inline EntityView(const Registry &r, enum EntityType t, const EntityTypeIndex &i):
+         registry(r), type(t), index(i) {}
+
+         EntityView(const EntityView &) = delete;
+         EntityView &operator=(const EntityView &) = delete;
+
+         inline const_iterator begin() const {return {index.entities.begin()};}
+         inline const_iterator end() const {return {index.entities.end()};}
+
+         /*
+            Returns an iterator to the Entity with the given name, or end() if
+            there is no such Entity or it isn't of the view's type.
+
+            Input:
+               Entity name (const std::string &)
+
+            Output:
+               const_iterator
+         */
+         inline const_iterator find(const std::string &name) const {
+
+            auto entity = registry.find(name);
+
+            if (registry.end() == entity || !entity->second->isType(type)) {
+               return end();
+            }
+
+            return {index.entities.begin() + index.positions[entity->second->getHandle().index]};
+         }
+
+         /*
+            Returns the number of Entities visible through the view.
+
+            Input:
+               (none)
+
+            Output:
+               Number of Entities (size_t)
+         */
+         inline size_t size() const {return index.entities.size();}
+         inline bool empty() const {return index.entities.empty();}
+   };
+}
+
+
+#endif
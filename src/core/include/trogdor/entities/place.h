@@ -2,7 +2,7 @@
 #define PLACE_H
 
 
-#include <list>
+#include <vector>
 #include <cstring>
 #include <sstream>
 #include <memory>
@@ -24,21 +24,126 @@ namespace trogdor::entity {
 
    class Place: public Tangible {
 
+      public:
+
+         // Each Thing in a Place keeps track of where it is in three of the
+         // Place's containers (see Thing::contentsIndex)
+         enum ContentsSlot {
+            CONTENTS_SLOT_THINGS = 0,   // things
+            CONTENTS_SLOT_BEINGS = 1,   // beings
+            CONTENTS_SLOT_TYPED = 2,    // players, creatures, or objects
+            NUM_CONTENTS_SLOTS = 3
+         };
+
       protected:
 
-         // sequential list of all entities in a place
-         std::list<std::shared_ptr<Thing>>    things;
-         std::list<std::shared_ptr<Being>>    beings;
-         std::list<std::shared_ptr<Player>>   players;
-         std::list<std::shared_ptr<Creature>> creatures;
-         std::list<std::shared_ptr<Object>>   objects;
+         // Every Thing in the Place, along with the subsets that are Beings,
+         // Players, Creatures and Objects. These are contiguous so they're
+         // cheap to iterate over, and since each Thing knows its position in
+         // them, removing one only requires moving the last element into its
+         // place (or, if preserveOrder is set, shifting everything after it.)
+         std::vector<std::shared_ptr<Thing>>    things;
+         std::vector<std::shared_ptr<Being>>    beings;
+         std::vector<std::shared_ptr<Player>>   players;
+         std::vector<std::shared_ptr<Creature>> creatures;
+         std::vector<std::shared_ptr<Object>>   objects;
 
          // alias -> entity list indices
-         std::unordered_map<std::string, std::list<Thing *>>    thingsByName;
-         std::unordered_map<std::string, std::list<Being *>>    beingsByName;
-         std::unordered_map<std::string, std::list<Player *>>   playersByName;
-         std::unordered_map<std::string, std::list<Creature *>> creaturesByName;
-         std::unordered_map<std::string, std::list<Object *>>   objectsByName;
+         std::unordered_map<std::string, std::vector<Thing *>>    thingsByName;
+         std::unordered_map<std::string, std::vector<Being *>>    beingsByName;
+         std::unordered_map<std::string, std::vector<Player *>>   playersByName;
+         std::unordered_map<std::string, std::vector<Creature *>> creaturesByName;
+         std::unordered_map<std::string, std::vector<Object *>>   objectsByName;
+
+         // If true, removing a Thing leaves everything else in the order it
+         // was inserted in, at the cost of making removal linear in the
+         // number of Things in the Place
+         bool preserveOrder = false;
+
+         /*
+            Appends a Thing to one of the Place's containers and records its
+            position. Assumes the Place is already locked.
+
+            Input:
+               Container (std::vector<std::shared_ptr<T>> &)
+               Thing to insert (const std::shared_ptr<T> &)
+               Which of the Thing's positions to record (ContentsSlot)
+
+            Output:
+               (none)
+         */
+         template <typename T>
+         void insertContents(
+            std::vector<std::shared_ptr<T>> &contents,
+            const std::shared_ptr<T> &thing,
+            ContentsSlot slot
+         );
+
+         /*
+            Removes a Thing from one of the Place's containers, updating the
+            recorded positions of any Things that had to be moved. Does nothing
+            if the Thing isn't in the container. Assumes the Place is already
+            locked.
+
+            Input:
+               Container (std::vector<std::shared_ptr<T>> &)
+               Thing to remove (T *)
+               Which of the Thing's positions was recorded (ContentsSlot)
+
+            Output:
+               (none)
+         */
+         template <typename T>
+         void removeContents(
+            std::vector<std::shared_ptr<T>> &contents,
+            T *thing,
+            ContentsSlot slot
+         );
+
+         /*
+            Adds a Thing to or removes a Thing from an alias index under each
+            of its aliases, recording its position in each alias's list (see
+            Thing::aliasIndex.) Assumes the Place is already locked.
+
+            Input:
+               Alias index (std::unordered_map<std::string, std::vector<T *>> &)
+               Thing (T *)
+               Which of the Thing's positions to record (ContentsSlot)
+
+            Output:
+               (none)
+         */
+         template <typename T>
+         void indexAliases(std::unordered_map<std::string, std::vector<T *>> &index, T *thing, ContentsSlot slot);
+
+         template <typename T>
+         void unindexAliases(std::unordered_map<std::string, std::vector<T *>> &index, T *thing, ContentsSlot slot);
+
+         /*
+            Inserts a Thing into all the containers and alias indices it
+            belongs in without setting its location. Assumes the Place is
+            already locked and that the Thing is a Player, Creature or Object.
+
+            Input:
+               Thing to insert (const std::shared_ptr<Thing> &)
+
+            Output:
+               (none)
+         */
+         void insertThingUnlocked(const std::shared_ptr<Thing> &thing);
+
+         /*
+            Removes a Thing from all the containers and alias indices it's in
+            without resetting its location. Assumes the Place is already
+            locked.
+
+            Input:
+               Thing to remove (Thing *)
+
+            Output:
+               (none)
+         */
+         void removeThingUnlocked(Thing *thing);
 
          /*
             Display all Resources currently allocated to the Place.
@@ -152,6 +257,38 @@ namespace trogdor::entity {
          */
          virtual std::shared_ptr<serial::Serializable> serialize();
 
+         /*
+            Returns whether or not the Place keeps its contents in the order
+            they were inserted when something is removed.
+
+            Input:
+               (none)
+
+            Output:
+               bool
+         */
+         inline bool getPreserveOrder() const {return preserveOrder;}
+
+         /*
+            Sets whether or not the Place keeps its contents in the order they
+            were inserted when something is removed. By default, removing a
+            Thing moves the last Thing in each list into its spot, which is
+            faster but means that the order of getThings(), getBeings(), etc.
+            can change.
+
+            Input:
+               Whether or not to preserve insertion order (bool)
+
+            Output:
+               (none)
+         */
+         inline void setPreserveOrder(bool preserve) {
+
+            mutex.lock();
+            preserveOrder = preserve;
+            mutex.unlock();
+         }
+
          /*
             Inserts a Player that resides inside the Place.
 
@@ -198,6 +335,20 @@ namespace trogdor::entity {
          */
          void insertThing(const std::shared_ptr<Thing> &thing);
 
+         /*
+            Inserts several Things at once, locking the Place only once rather
+            than once per Thing. Throws an instance of UndefinedException
+            without inserting anything if any of the Things is of an
+            unsupported type.
+
+            Input:
+               Things to insert (const std::vector<std::shared_ptr<Thing>> &)
+
+            Output:
+               (none)
+         */
+         void insertThings(const std::vector<std::shared_ptr<Thing>> &newThings);
+
          /*
             Removes a Player from the Place.
 
@@ -249,7 +400,7 @@ namespace trogdor::entity {
                name (std::string)
 
             Output:
-               const std::list<std::shared_ptr<Thing>> &
+               const ThingList &
          */
          inline const auto &getThingsByName(std::string name) const {
 
@@ -264,7 +415,7 @@ namespace trogdor::entity {
                name (std::string)
 
             Output:
-               const std::list<std::shared_ptr<Being>> &
+               const BeingList &
          */
          inline const auto &getBeingsByName(std::string name) const {
 
@@ -279,7 +430,7 @@ namespace trogdor::entity {
                (None)
 
             Output:
-               const std::list<std::shared_ptr<Thing>> &
+               const std::vector<std::shared_ptr<Thing>> &
          */
          inline const auto &getThings() const {return things;}
 
@@ -290,7 +441,7 @@ namespace trogdor::entity {
                (None)
 
             Output:
-               const std::list<std::shared_ptr<Being>> &
+               const std::vector<std::shared_ptr<Being>> &
          */
          inline const auto &getBeings() const {return beings;}
 
@@ -301,7 +452,7 @@ namespace trogdor::entity {
                (None)
 
             Output:
-               const std::list<std::shared_ptr<Player>> &
+               const std::vector<std::shared_ptr<Player>> &
          */
          inline const auto &getPlayers() const {return players;}
 
@@ -312,7 +463,7 @@ namespace trogdor::entity {
                (None)
 
             Output:
-               const std::list<std::shared_ptr<Creature>> &
+               const std::vector<std::shared_ptr<Creature>> &
          */
          inline const auto &getCreatures() const {return creatures;}
    
@@ -323,7 +474,7 @@ namespace trogdor::entity {
                (None)
 
             Output:
-               const std::list<std::shared_ptr<Object>> &
+               const std::vector<std::shared_ptr<Object>> &
          */
          inline const auto &getObjects() const {return objects;}
    };
@@ -0,0 +1,88 @@
+#ifndef ENTITY_PROPERTYSLOT_H
+#define ENTITY_PROPERTYSLOT_H
+
+
+#include <optional>
+#include <string_view>
+
+namespace trogdor::entity {
+
+
+   // Every built-in property (the ones with named constants like
+   // Entity::TitleProperty) is interned into a fixed slot, so that Entities can
+   // store and look them up by index instead of hashing the property name on
+   // every access. Slots are grouped by the type that defines them. Any
+   // property that isn't listed here is a custom property and is stored by
+   // name instead.
+   //
+   // If you add a new built-in property, add it here and to the table of names
+   // in propertyslot.cpp (in the same order.)
+   enum PropertySlot {
+
+      // Entity
+      PROPERTY_SLOT_TITLE = 0,
+      PROPERTY_SLOT_LONG_DESC,
+      PROPERTY_SLOT_SHORT_DESC,
+
+      // Resource
+      PROPERTY_SLOT_REQ_INT_ALLOC,
+      PROPERTY_SLOT_AMT_AVAIL,
+      PROPERTY_SLOT_MAX_AMT_PER_DEPOSITOR,
+      PROPERTY_SLOT_PLURAL_NAME,
+      PROPERTY_SLOT_PLURAL_TITLE,
+
+      // Object
+      PROPERTY_SLOT_WEIGHT,
+      PROPERTY_SLOT_DAMAGE,
+
+      // Being
+      PROPERTY_SLOT_HEALTH,
+      PROPERTY_SLOT_MAX_HEALTH,
+      PROPERTY_SLOT_WOUND_RATE,
+      PROPERTY_SLOT_DAMAGE_BARE_HANDS,
+      PROPERTY_SLOT_RESPAWN_ENABLED,
+      PROPERTY_SLOT_RESPAWN_INTERVAL,
+      PROPERTY_SLOT_RESPAWN_LIVES,
+      PROPERTY_SLOT_INV_MAX_WEIGHT,
+
+      // Creature
+      PROPERTY_SLOT_ALLEGIANCE,
+      PROPERTY_SLOT_COUNTER_ATTACK,
+      PROPERTY_SLOT_AUTOATTACK_ENABLED,
+      PROPERTY_SLOT_AUTOATTACK_REPEAT,
+      PROPERTY_SLOT_AUTOATTACK_INTERVAL,
+      PROPERTY_SLOT_WANDER_ENABLED,
+      PROPERTY_SLOT_WANDER_INTERVAL,
+      PROPERTY_SLOT_WANDER_LUST,
+      PROPERTY_SLOT_WANDER_MODE,
+
+      // Not a slot; this is the total number of built-in properties
+      NUM_PROPERTY_SLOTS
+   };
+
+   /*
+      Returns the name of the built-in property stored in the given slot.
+
+      Input:
+         Slot (PropertySlot)
+
+      Output:
+         Property name (const char *)
+   */
+   const char *propertySlotToStr(PropertySlot slot);
+
+   /*
+      Returns the slot a property is stored in if it's built-in, or
+      std::nullopt if it's a custom property.
+
+      Input:
+         Property name (std::string_view)
+
+      Output:
+         std::optional<PropertySlot>
+   */
+   std::optional<PropertySlot> strToPropertySlot(std::string_view key);
+}
+
+
+#endif
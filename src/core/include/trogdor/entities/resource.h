@@ -2,7 +2,9 @@
 #define RESOURCE_H
 
 #include <cmath>
+#include <mutex>
 #include <memory>
+#include <vector>
 #include <optional>
 #include <unordered_map>
 
@@ -119,22 +121,82 @@ namespace trogdor::entity {
             std::unordered_map<std::string, std::string>
          > constTemplateParameters;
 
-         // Lock on this when we're transferring a resource allocation from one
-         // tangible entity to another.
-         std::mutex transferMutex;
+         // Keeps track of who holds the resource and how much. Allocations are
+         // stored contiguously so that they're cheap to walk, and
+         // depositorIndex maps each depositor to its entry. Removing an entry
+         // moves the last one into its place.
+         std::vector<std::pair<std::weak_ptr<Tangible>, double>> depositors;
 
-         // Keeps track of who holds the resource and how much
-         std::map<
-            std::weak_ptr<Tangible>,
-            double,
-            std::owner_less<std::weak_ptr<Tangible>>
-         > depositors;
+         // The address each entry in depositors was recorded under, kept in
+         // the same order so that moving an entry can update its index
+         std::vector<const Tangible *> depositorKeys;
+         std::unordered_map<const Tangible *, size_t> depositorIndex;
 
          // Total amount of the resource that's currently allocated
          double totalAmountAllocated = 0;
 
+         /*
+            Returns the index of a Tangible's entry in depositors. If the entry
+            recorded at the Tangible's address belonged to an entity that's
+            since been destroyed, it's discarded. Assumes the Resource is
+            locked.
+
+            Input:
+               Tangible entity (const std::shared_ptr<Tangible> &)
+
+            Output:
+               Index into depositors (std::optional<size_t>)
+         */
+         std::optional<size_t> findDepositor(const std::shared_ptr<Tangible> &entity);
+
+         /*
+            Removes an entry from depositors without updating its Tangible's
+            records. Assumes the Resource is locked.
+
+            Input:
+               Index into depositors (size_t)
+
+            Output:
+               (none)
+         */
+         void removeDepositor(size_t index);
+
+         /*
+            Adds some amount (which may be negative) to a Tangible's balance
+            and updates the Tangible's own records to match. Assumes both the
+            Resource and the Tangible are locked.
+
+            Input:
+               This Resource (const std::shared_ptr<Resource> &)
+               Tangible entity (const std::shared_ptr<Tangible> &)
+               Amount to add (double)
+
+            Output:
+               (none)
+         */
+         void adjustAllocation(
+            const std::shared_ptr<Resource> &self,
+            const std::shared_ptr<Tangible> &entity,
+            double amount
+         );
+
+         /*
+            Locks every given Tangible, always in the same order so that two
+            transfers running at once can't deadlock. Duplicates are only
+            locked once.
+
+            Input:
+               Entities to lock (std::vector<Tangible *>)
+
+            Output:
+               Locks that release the entities when destroyed
+         */
+         static std::vector<std::unique_lock<std::mutex>> lockDepositors(
+            std::vector<Tangible *> entities
+         );
+
          // Modify's a tangible entity's allocation without any checks. This is
-         // utilized by the public methods allocate(), free(), and transfer().
+         // utilized by the public methods allocate() and free().
          void allocateRaw(const std::shared_ptr<Tangible> &entity, double amount);
 
          /*
@@ -180,6 +242,13 @@ namespace trogdor::entity {
 
       public:
 
+         // A single transfer made as part of a call to transferMany()
+         struct Transfer {
+            std::shared_ptr<Tangible> depositor;
+            std::shared_ptr<Tangible> beneficiary;
+            double amount;
+         };
+
          /*
             Constructor for creating a new Resource.
 
@@ -256,7 +325,7 @@ namespace trogdor::entity {
          */
          inline bool isPlural(std::string name) const {
 
-            return 0 == getProperty<std::string>(PluralNameProperty).compare(name) ? true : false;
+            return 0 == getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_NAME).compare(name) ? true : false;
          }
 
          /*
@@ -312,10 +381,21 @@ namespace trogdor::entity {
                (none)
 
             Output:
-               An unordered_map of entity weak_ptrs -> allocated amount
+               A vector of (entity weak_ptr, allocated amount) pairs
          */
          inline const auto &getDepositors() const {return depositors;}
 
+         /*
+            Returns the amount of the resource a tangible entity holds.
+
+            Input:
+               Tangible entity (const std::shared_ptr<Tangible> &)
+
+            Output:
+               Allocated amount, or 0 if it doesn't hold any (double)
+         */
+         double getAllocation(const std::shared_ptr<Tangible> &entity);
+
          /*
             A helper function that takes as input some amount and returns,
             depending on the value of requireIntegerAllocations, an integer
@@ -329,7 +409,7 @@ namespace trogdor::entity {
          */
          inline std::string amountToString(double amount) const {
 
-            return getProperty<bool>(ReqIntAllocProperty) ?
+            return getProperty<bool>(PROPERTY_SLOT_REQ_INT_ALLOC) ?
                std::to_string(std::lround(amount)) : std::to_string(amount);
          }
 
@@ -346,8 +426,8 @@ namespace trogdor::entity {
          */
          inline std::string titleToString(double amount) const {
 
-            return getProperty<bool>(ReqIntAllocProperty) && 1 == std::lround(amount) ?
-               getProperty<std::string>(TitleProperty) : getProperty<std::string>(PluralTitleProperty);
+            return getProperty<bool>(PROPERTY_SLOT_REQ_INT_ALLOC) && 1 == std::lround(amount) ?
+               getPropertyRef<std::string>(PROPERTY_SLOT_TITLE) : getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_TITLE);
          }
 
          /*
@@ -381,15 +461,31 @@ namespace trogdor::entity {
          );
 
          /*
-            Transfers some amount of a resource from one entity to another.
+            Transfers some amount of a resource from one entity to another. The
+            transfer is atomic: the depositor's allocation and the
+            beneficiary's limit are checked and both balances are updated
+            while holding the locks, so either all of the amount changes hands
+            or none of it does. The beneficiary's allocation doesn't count
+            toward the total amount available, since nothing new is being
+            allocated.
 
             Input:
                Reference to tangible entity who possesses the resource
                   (const std::shared_ptr<Tangible> &)
                Reference to tangible entity who's to receive the resource
                   (const std::shared_ptr<Tangible> &)
-               The amount of the resource to transfer (double)
+               The amount of the resource to transfer (double -- 0 means to
+                  transfer everything)
                Whether or not to fire event triggers (bool: default = true)
+
+            Output:
+               Whether or not the transfer succeeded and why (AllocationStatus)
+
+            Events Triggered:
+               beforeTransferResource
+               transferResourceCantFree
+               transferResourceCantAllocate
+               afterTransferResource
          */
          AllocationStatus transfer(
             const std::shared_ptr<Tangible> &depositor,
@@ -397,6 +493,30 @@ namespace trogdor::entity {
             double amount,
             bool triggerEvents = true
          );
+
+         /*
+            Makes several transfers at once. Each depositor's and beneficiary's
+            net change is validated a single time and all of them are applied
+            under one set of locks, so either every transfer goes through or
+            none of them do. Unlike transfer(), an amount of 0 isn't a request
+            to transfer everything and is simply skipped. A single pair of
+            events is fired for the whole batch instead of one per transfer.
+
+            Input:
+               Transfers to make (const std::vector<Transfer> &)
+               Whether or not to fire event triggers (bool: default = true)
+
+            Output:
+               Whether or not the transfers succeeded and why (AllocationStatus)
+
+            Events Triggered:
+               beforeTransferResources
+               afterTransferResources
+         */
+         AllocationStatus transferMany(
+            const std::vector<Transfer> &transfers,
+            bool triggerEvents = true
+         );
    };
 }
 
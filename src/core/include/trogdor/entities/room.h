@@ -3,8 +3,9 @@
 
 
 #include <string>
+#include <vector>
 #include <memory>
-#include <unordered_map>
+#include <optional>
 
 #include <trogdor/vocabulary.h>
 #include <trogdor/exception/validationexception.h>
@@ -19,12 +20,38 @@ namespace trogdor::entity {
 
       protected:
 
-         // Maps directions to connected rooms
-         std::unordered_map<std::string, std::weak_ptr<Room>> connections;
+         struct Connection {
 
-         // Maps directions to optional connection descriptions
-         // TODO: should I allow these to be ordered?
-         std::unordered_map<std::string, std::string> connectionDescriptions;
+            // The Room the connection leads to
+            std::weak_ptr<Room> room;
+
+            // Optional description of the connection
+            std::string description;
+
+            // Whether or not there's a connection in this direction, and if
+            // so, where its direction ID is in connectedDirections
+            bool connected = false;
+            size_t position = 0;
+         };
+
+         // Connections indexed by direction ID (see Vocabulary::getDirectionId())
+         std::vector<Connection> connections;
+
+         // IDs of every direction that has a connection, in no particular
+         // order, so that one can be picked at random in constant time
+         std::vector<size_t> connectedDirections;
+
+         /*
+            Removes the connection in the specified direction, if there is one.
+            Assumes the Room is already locked.
+
+            Input:
+               Direction ID (size_t)
+
+            Output:
+               (none)
+         */
+         void removeConnectionUnlocked(size_t directionId);
 
          /*
             Outputs a description of each connection (if a description exists.)
@@ -110,26 +137,27 @@ namespace trogdor::entity {
             returned.
 
             Input:
-               Direction (std::tring)
+               Direction ID (size_t)
 
             Output:
                std::shared_ptr<Room>
          */
-         inline std::shared_ptr<Room> getConnection(std::string direction) {
+         std::shared_ptr<Room> getConnection(size_t directionId);
 
-            if (connections.find(direction) == connections.end()) {
-               return std::shared_ptr<Room>();
-            }
+         /*
+            Same as above, but takes the name of a direction or one of its
+            synonyms and looks up its ID in the game's vocabulary.
 
-            std::shared_ptr<Room> connection = connections[direction].lock();
+            Input:
+               Direction (std::tring)
 
-            if (!connection) {
-               mutex.lock();
-               connections.erase(direction);
-               mutex.unlock();
-            }
+            Output:
+               std::shared_ptr<Room>
+         */
+         inline std::shared_ptr<Room> getConnection(std::string direction) {
 
-            return connection;
+            std::optional<size_t> directionId = game->getVocabulary().getDirectionId(direction);
+            return directionId ? getConnection(*directionId) : std::shared_ptr<Room>();
          }
 
          /*
@@ -141,7 +169,22 @@ namespace trogdor::entity {
             Output:
                Number of connections (size_t)
          */
-         inline size_t getNumConnections() const {return connections.size();}
+         inline size_t getNumConnections() const {return connectedDirections.size();}
+
+         /*
+            Returns the IDs of every direction that has a connection. The order
+            is arbitrary and can change whenever a connection is removed.
+
+            Input:
+               (none)
+
+            Output:
+               const std::vector<size_t> &
+         */
+         inline const std::vector<size_t> &getConnectedDirections() const {
+
+            return connectedDirections;
+         }
 
          /*
             Serializes the Room.
@@ -155,10 +198,10 @@ namespace trogdor::entity {
          virtual std::shared_ptr<serial::Serializable> serialize();
 
          /*
-            Returns a connected room by numeric index (in so far as we iterate
-            through all values until we've counted index iterations and then
-            return the result.)  This, in conjunction with getNumConnections(),
-            is used primarily for the random selection of a connection.
+            Returns a connected room by numeric index. This, in conjunction with
+            getNumConnections(), is used primarily for the random selection of
+            a connection, which is useful specifically for Creatures that
+            wander.
 
             If index > getNumConnections() - 1, then the first connection will
             be returned (arbitrary decision.)
@@ -167,9 +210,6 @@ namespace trogdor::entity {
             connection refers to a pointer that's no longer valid, it will be
             removed.
 
-            This is very hokey, but ultimately allows us to get a random
-            connection, which is useful specifically for Creatures that wander.
-
             Input:
                index (size_t)
 
@@ -191,6 +231,22 @@ namespace trogdor::entity {
          */
          void setConnection(std::string direction, const std::shared_ptr<Room> &connectTo,
          std::optional<std::string> description = std::nullopt);
+
+         /*
+            Same as above, but takes a direction ID instead of a name. Throws
+            an instance of ValidationException if the ID doesn't belong to a
+            direction in the game's vocabulary.
+
+            Input:
+               Direction ID (size_t)
+               Room direction connects to (const std::shared_ptr<Room> &)
+               Optional description (std::optional<std::string>)
+
+            Output:
+               (none)
+         */
+         void setConnection(size_t directionId, const std::shared_ptr<Room> &connectTo,
+         std::optional<std::string> description = std::nullopt);
    };
 }
 
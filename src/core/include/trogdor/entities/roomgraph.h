@@ -0,0 +1,464 @@
+#ifndef ROOMGRAPH_H
+#define ROOMGRAPH_H
+
+
+#include <deque>
+#include <mutex>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+
+
+namespace trogdor {
+
+   class Game;
+}
+
+namespace trogdor::entity {
+
+
+   class Room;
+   class Thing;
+
+   /*
+      Index of the connections between a Game's Rooms, used to answer
+      questions like "how far is it from here to there?" and "which way should
+      I go to get there?" without walking every Room's connections by hand.
+
+      Each Room in the game is a node, and each connection is a directed edge
+      labelled with its direction ID (see Vocabulary::getDirectionId().) The
+      graph is built the first time it's queried. After that, changing a
+      Room's connections only updates that Room's edges, while inserting or
+      removing a Room marks the whole graph stale so that it's rebuilt on the
+      next query.
+
+      Shortest paths are computed one destination at a time: a breadth-first
+      search backward from the destination finds the distance from every Room
+      to it, along with the first step to take from each one. These rows are
+      computed when they're first needed and cached (up to a configurable
+      limit) until the graph changes. Connected components are computed and
+      cached the same way.
+
+      Rows can also be followed toward (or away from) a Thing that moves
+      around, like a Player. Each target remembers the row for the Room it
+      was in the last time it was asked about, so the search is only repeated
+      after the target moves to another Room or the graph changes, no matter
+      how many Creatures are chasing it. Every Creature after the first finds
+      its next step with a couple of lookups.
+
+      Every method is safe to call from multiple threads.
+   */
+   class RoomGraph {
+
+      public:
+
+         // Returned by getDistances() for Rooms that can't reach the destination
+         static constexpr size_t UNREACHABLE = std::numeric_limits<size_t>::max();
+
+         // Default maximum number of shortest path rows kept in the cache
+         static constexpr size_t DEFAULT_MAX_CACHED_ROWS = 64;
+
+         // A single step along a path: the direction to go in and the Room
+         // that direction leads to
+         struct Step {
+            size_t direction;
+            std::shared_ptr<Room> room;
+         };
+
+      private:
+
+         // A connection from one Room to another
+         struct Edge {
+            size_t direction;
+            size_t node;
+         };
+
+         struct Node {
+
+            std::weak_ptr<Room> room;
+
+            // Connections leading out of the Room and into it
+            std::vector<Edge> out;
+            std::vector<Edge> in;
+         };
+
+         // Shortest paths from every Room to a single destination. Rows are
+         // shared between the cache and any targets that are in the
+         // destination Room.
+         struct Row {
+
+            // Number of steps from each node to the destination
+            std::vector<size_t> distance;
+
+            // The first step to take from each node (only meaningful if the
+            // node's distance is neither 0 nor UNREACHABLE)
+            std::vector<Edge> next;
+         };
+
+         // The row leading to a target and the Room it was computed for
+         struct Target {
+            const Room *room = nullptr;
+            std::shared_ptr<const Row> row;
+         };
+
+         Game *game;
+
+         mutable std::mutex mutex;
+
+         // If true, the graph has to be rebuilt before it's queried
+         bool stale = true;
+
+         std::vector<Node> nodes;
+         std::unordered_map<const Room *, size_t> nodeIds;
+
+         // Cached rows by destination node, and the order they were computed
+         // in so that the oldest can be evicted first
+         std::unordered_map<size_t, std::shared_ptr<const Row>> rows;
+         std::deque<size_t> rowOrder;
+         size_t maxCachedRows = DEFAULT_MAX_CACHED_ROWS;
+
+         // Rows leading to targets that move around
+         std::unordered_map<const Thing *, Target> targets;
+
+         // Number of rows computed since the graph was created
+         size_t numSearches = 0;
+
+         // Weakly connected component of each node
+         bool componentsStale = true;
+         std::vector<size_t> components;
+         size_t numComponents = 0;
+
+         /*
+            Discards cached rows, targets and components. Assumes the graph is
+            already locked.
+
+            Input:
+               (none)
+
+            Output:
+               (none)
+         */
+         void clearCache();
+
+         /*
+            Rebuilds the graph from the Game's Rooms if it's stale. Assumes the
+            graph is already locked.
+
+            Input:
+               (none)
+
+            Output:
+               (none)
+         */
+         void refresh();
+
+         /*
+            Adds edges for each of a Room's connections, or removes the ones
+            that were added before. Assumes the graph is already locked.
+
+            Input:
+               Node (size_t)
+               Room (Room &, indexConnections() only)
+
+            Output:
+               (none)
+         */
+         void indexConnections(size_t node, Room &room);
+         void unindexConnections(size_t node);
+
+         /*
+            Returns the node representing a Room, rebuilding the graph first if
+            necessary. Assumes the graph is already locked.
+
+            Input:
+               Room (const Room *)
+
+            Output:
+               Node if the Room is in the game (std::optional<size_t>)
+         */
+         std::optional<size_t> findNode(const Room *room);
+
+         /*
+            Returns the shortest paths from every node to the destination,
+            computing them if they aren't already cached. Assumes the graph is
+            already locked and up to date.
+
+            Input:
+               Destination node (size_t)
+
+            Output:
+               std::shared_ptr<const Row>
+         */
+         std::shared_ptr<const Row> getRow(size_t destination);
+
+         /*
+            Returns the shortest paths from every node to the Room a target is
+            currently in, only searching again if the target has moved since
+            the last time it was asked about. Returns nullptr if the target
+            isn't in a Room that's part of the game. Assumes the graph is
+            already locked.
+
+            Input:
+               Target (const Thing *)
+
+            Output:
+               std::shared_ptr<const Row>
+         */
+         std::shared_ptr<const Row> getTargetRow(const Thing *target);
+
+         /*
+            Computes the weakly connected components if they aren't already
+            cached. Assumes the graph is already locked and up to date.
+
+            Input:
+               (none)
+
+            Output:
+               (none)
+         */
+         void refreshComponents();
+
+      public:
+
+         /*
+            Constructor. The graph isn't built until it's first queried.
+
+            Input:
+               Game whose Rooms are indexed (Game *)
+         */
+         inline RoomGraph(Game *g): game(g) {}
+
+         RoomGraph(const RoomGraph &) = delete;
+         RoomGraph &operator=(const RoomGraph &) = delete;
+
+         /*
+            Marks the graph stale so that it's rebuilt the next time it's
+            queried. Game calls this whenever a Room is inserted or removed.
+
+            Input:
+               (none)
+
+            Output:
+               (none)
+         */
+         void invalidate();
+
+         /*
+            Updates the edges leading out of a Room after its connections have
+            changed. Room::setConnection() calls this. Does nothing if the Room
+            isn't part of the game or the graph hasn't been built yet.
+
+            Input:
+               Room whose connections have changed (Room &)
+
+            Output:
+               (none)
+         */
+         void updateConnections(Room &room);
+
+         /*
+            Sets the maximum number of shortest path rows to cache. Each row
+            takes memory proportional to the number of Rooms in the game.
+
+            Input:
+               Maximum number of rows (size_t)
+
+            Output:
+               (none)
+         */
+         void setMaxCachedRows(size_t max);
+
+         /*
+            Returns the number of shortest path rows currently cached.
+
+            Input:
+               (none)
+
+            Output:
+               size_t
+         */
+         size_t getNumCachedRows() const;
+
+         /*
+            Returns the number of shortest path rows that have been computed
+            since the graph was created. Useful for making sure that rows are
+            being reused.
+
+            Input:
+               (none)
+
+            Output:
+               size_t
+         */
+         size_t getNumSearches() const;
+
+         /*
+            Returns the smallest number of steps it takes to get from one Room
+            to another, or std::nullopt if there's no way to get there (or if
+            either Room isn't part of the game.)
+
+            Input:
+               Starting Room (const Room *)
+               Destination (const Room *)
+
+            Output:
+               std::optional<size_t>
+         */
+         std::optional<size_t> getDistance(const Room *from, const Room *to);
+
+         /*
+            Returns the first step along a shortest path from one Room to
+            another, or std::nullopt if there's no such path or the two are the
+            same Room.
+
+            Input:
+               Starting Room (const Room *)
+               Destination (const Room *)
+
+            Output:
+               std::optional<Step>
+         */
+         std::optional<Step> getNextStep(const Room *from, const Room *to);
+
+         /*
+            Returns every step along a shortest path from one Room to another.
+            The path is empty if there's no such path or the two are the same
+            Room.
+
+            Input:
+               Starting Room (const Room *)
+               Destination (const Room *)
+
+            Output:
+               std::vector<Step>
+         */
+         std::vector<Step> getPath(const Room *from, const Room *to);
+
+         /*
+            Like getDistance() and getNextStep(), except that the destination is
+            whichever Room the target is in right now. Returns std::nullopt if
+            the target isn't in a Room or can't be reached.
+
+            Input:
+               Starting Room (const Room *)
+               Target (const Thing *)
+
+            Output:
+               std::optional<size_t> or std::optional<Step>
+         */
+         std::optional<size_t> getDistanceTo(const Room *from, const Thing *target);
+         std::optional<Step> getStepToward(const Room *from, const Thing *target);
+
+         /*
+            Returns the step that takes us farthest away from the target, or
+            std::nullopt if no step would increase the distance between us
+            (including when the target already can't reach us.) A step that
+            leads somewhere the target can't reach at all is always preferred.
+
+            Note that distances are measured from the Room we'd go to back to
+            the target, since a Thing running away is trying to stay out of the
+            target's reach.
+
+            Input:
+               Starting Room (const Room *)
+               Target (const Thing *)
+
+            Output:
+               std::optional<Step>
+         */
+         std::optional<Step> getStepAwayFrom(const Room *from, const Thing *target);
+
+         /*
+            Discards the row kept for a target. Game calls this when a Thing is
+            removed so that targets don't pile up.
+
+            Input:
+               Target (const Thing *)
+
+            Output:
+               (none)
+         */
+         void forgetTarget(const Thing *target);
+
+         /*
+            Calls a function once for every Room in the game with the number of
+            steps it takes to get from that Room to the destination and the
+            first step to take (if the Room can reach the destination and isn't
+            the destination itself.) Rooms that can't reach the destination
+            aren't visited. The graph is locked while the callback runs, so it
+            mustn't change any connections or insert or remove Rooms.
+
+            Input:
+               Destination (const Room *)
+               Callback (const Callback &)
+
+            Output:
+               (none)
+         */
+         template <typename Callback>
+         void forEachDistanceTo(const Room *to, const Callback &callback) {
+
+            std::lock_guard<std::mutex> lock(mutex);
+            std::optional<size_t> destination = findNode(to);
+
+            if (!destination) {
+               return;
+            }
+
+            std::shared_ptr<const Row> row = getRow(*destination);
+
+            for (size_t i = 0; i < nodes.size(); i++) {
+
+               if (UNREACHABLE == row->distance[i]) {
+                  continue;
+               }
+
+               auto room = nodes[i].room.lock();
+
+               if (!room) {
+                  continue;
+               }
+
+               std::optional<Step> step;
+
+               if (row->distance[i] > 0) {
+                  step = Step{row->next[i].direction, nodes[row->next[i].node].room.lock()};
+               }
+
+               callback(room, row->distance[i], step);
+            }
+         }
+
+         /*
+            Returns the weakly connected component a Room belongs to, meaning
+            that two Rooms are in the same component if there's a path between
+            them when connections are followed in either direction. Component
+            IDs are between 0 and getNumComponents() - 1, and are only valid
+            until the graph changes. Returns std::nullopt if the Room isn't part
+            of the game.
+
+            Input:
+               Room (const Room *)
+
+            Output:
+               std::optional<size_t>
+         */
+         std::optional<size_t> getComponent(const Room *room);
+
+         /*
+            Returns the number of weakly connected components in the game.
+
+            Input:
+               (none)
+
+            Output:
+               size_t
+         */
+         size_t getNumComponents();
+   };
+}
+
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef ENTITY_TAGSLOT_H
+#define ENTITY_TAGSLOT_H
+
+
+#include <optional>
+#include <string_view>
+
+namespace trogdor::entity {
+
+
+   // Every built-in tag (the ones with named constants like
+   // Being::AttackableTag) is interned into a fixed slot, so that Entities can
+   // store them as bits and check them without hashing the tag's name. Any
+   // tag that isn't listed here is a custom tag and is stored by name instead.
+   //
+   // If you add a new built-in tag, add it here and to the table of names in
+   // tagslot.cpp (in the same order.)
+   enum TagSlot {
+
+      // Resource
+      TAG_SLOT_STICKY = 0,
+      TAG_SLOT_EPHEMERAL,
+
+      // Object
+      TAG_SLOT_WEAPON,
+      TAG_SLOT_UNTAKEABLE,
+      TAG_SLOT_UNDROPPABLE,
+
+      // Being
+      TAG_SLOT_ATTACKABLE,
+
+      // Not a slot; this is the total number of built-in tags
+      NUM_TAG_SLOTS
+   };
+
+   /*
+      Returns the name of the built-in tag stored in the given slot.
+
+      Input:
+         Slot (TagSlot)
+
+      Output:
+         Tag name (const char *)
+   */
+   const char *tagSlotToStr(TagSlot slot);
+
+   /*
+      Returns the slot a tag is stored in if it's built-in, or std::nullopt
+      if it's a custom tag.
+
+      Input:
+         Tag name (std::string_view)
+
+      Output:
+         std::optional<TagSlot>
+   */
+   std::optional<TagSlot> strToTagSlot(std::string_view tag);
+}
+
+
+#endif
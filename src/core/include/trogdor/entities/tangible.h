@@ -1,7 +1,10 @@
 #ifndef TANGIBLE_H
 #define TANGIBLE_H
 
+#include <mutex>
 #include <memory>
+#include <optional>
+#include <vector>
 #include <unordered_map>
 
 #include <trogdor/entities/resource.h>
@@ -19,27 +22,66 @@ namespace trogdor::entity {
 
       private:
 
-         // maintains a list of all Beings that have glanced at but not fully
-         // observed the Entity (cannot use unordered_set here because you can't
-         // hash a weak_ptr.)
-         std::set<
-            std::weak_ptr<Being>,
-            std::owner_less<std::weak_ptr<Being>>
-         > glancedByMap;
-
-         // maintains a list of all Beings that have observed the Entity (cannot
-         // use unordered_set here because you can't hash a weak_ptr.)
-         std::set<
-            std::weak_ptr<Being>,
-            std::owner_less<std::weak_ptr<Being>>
-         > observedByMap;
-
-         // Keeps track of which resources the entity holds and how much
-         std::map<
-            std::weak_ptr<Resource>,
-            double,
-            std::owner_less<std::weak_ptr<Resource>>
-         > resources;
+         // Records that a Being has glanced at or fully observed the Entity
+         struct Observation {
+            EntityHandle being;
+            bool observed;       // false if the Being has only glanced
+         };
+
+         // Every Being that has glanced at or observed the Entity, sorted by
+         // handle index so that lookups are a binary search. A Being appears
+         // at most once, and Game removes it when the Being leaves the game.
+         // Since a handle's generation changes when its slot is reused, a
+         // Being that takes over a departed Being's slot is never mistaken
+         // for it.
+         std::vector<Observation> observations;
+         mutable std::mutex observationsMutex;
+
+         /*
+            Returns the position of the observation whose handle has the given
+            index, or the position where it would be inserted if there isn't
+            one. Assumes observationsMutex is already locked.
+
+            Input:
+               Handle index (uint32_t)
+
+            Output:
+               Position in observations (size_t)
+         */
+         size_t findObservation(uint32_t index) const;
+
+         /*
+            Records that a Being has glanced at or observed the Entity, and
+            tells the Being so that it knows which Tangibles to have forget it
+            when it leaves the game. Nothing is recorded unless both the Being
+            and the Entity are part of a game and therefore have handles.
+
+            Input:
+               Being (Being &)
+               Whether the Being fully observed the Entity (bool)
+
+            Output:
+               (none)
+         */
+         void recordObservation(Being &being, bool observed);
+
+         /*
+            Returns true if the Being has fully observed the Entity or, if
+            observed is false, if it has at least glanced at it.
+
+            Input:
+               Being (const Being &)
+               Whether to require a full observation (bool)
+
+            Output:
+               bool
+         */
+         bool hasObservation(const Being &being, bool observed) const;
+
+         // Keeps track of which resources the entity holds and how much. An
+         // entity rarely holds more than a few different resources, so a short
+         // vector that's searched from front to back beats a tree.
+         std::vector<std::pair<std::weak_ptr<Resource>, double>> resources;
 
          // A name-based index into the resources the entity possesses
          std::unordered_map<
@@ -47,9 +89,30 @@ namespace trogdor::entity {
             std::weak_ptr<Resource>
          > resourcesByName;
 
+         /*
+            Returns the index of the entity's allocation record for the given
+            resource, or resources.size() if there isn't one.
+
+            Input:
+               The resource (const std::shared_ptr<Resource> & or const std::weak_ptr<Resource> &)
+
+            Output:
+               Index into resources (size_t)
+         */
+         template <typename Ptr> inline size_t findResourceAllocation(const Ptr &resource) const {
+
+            for (size_t i = 0; i < resources.size(); i++) {
+               if (!resources[i].first.owner_before(resource) && !resource.owner_before(resources[i].first)) {
+                  return i;
+               }
+            }
+
+            return resources.size();
+         }
+
          /*
             Record the Entity's allocation of a specific resource. Mutex locking
-            is currently done by Resource::allocate().
+            is done by Resource.
 
             Input:
                Weak pointer to the resource
@@ -60,24 +123,36 @@ namespace trogdor::entity {
             double value
          ) {
 
-            resources[resource] = value;
+            size_t i = findResourceAllocation(resource);
+
+            if (i < resources.size()) {
+               resources[i].second = value;
+               return;
+            }
+
+            resources.push_back({resource, value});
             resourcesByName[resource->getName()] = resource;
-            resourcesByName[resource->getProperty<std::string>(Resource::PluralNameProperty)] = resource;
+            resourcesByName[resource->getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_NAME)] = resource;
          }
 
          /*
             Removes the Entity's allocation record for a specific resource.
-            Mutex locking is currently done by Resource::free().
+            Mutex locking is done by Resource.
 
             Input:
                Weak pointer to the resource
-               The current allocated value
          */
          inline void removeResourceAllocation(const std::shared_ptr<Resource> &resource) {
 
+            size_t i = findResourceAllocation(resource);
+
+            if (i < resources.size()) {
+               resources[i] = resources.back();
+               resources.pop_back();
+            }
+
             resourcesByName.erase(resource->getName());
-            resourcesByName.erase(resource->getProperty<std::string>(Resource::PluralNameProperty));
-            resources.erase(resource);
+            resourcesByName.erase(resource->getPropertyRef<std::string>(PROPERTY_SLOT_PLURAL_NAME));
          }
 
       public:
@@ -150,14 +225,7 @@ namespace trogdor::entity {
             Output:
                bool
          */
-         inline bool observedBy(const std::shared_ptr<Being> &b) {
-
-            if (observedByMap.find(b) == observedByMap.end()) {
-               return false;
-            }
-
-            return true;
-         }
+         bool observedBy(const std::shared_ptr<Being> &b) const;
 
          /*
             Returns whether or not a given Being has glanced at the Tangible. If
@@ -170,15 +238,58 @@ namespace trogdor::entity {
             Output:
                bool
          */
-         inline bool glancedBy(const std::shared_ptr<Being> &b) {
+         bool glancedBy(const std::shared_ptr<Being> &b) const;
 
-            if (observedByMap.find(b) == observedByMap.end() &&
-            glancedByMap.find(b) == glancedByMap.end()) {
-               return false;
-            }
+         /*
+            Forgets that a Being has glanced at or observed the Tangible. Game
+            calls this on every Tangible the Being has looked at when the Being
+            is removed (see Being::takeObservedTangibles().)
 
-            return true;
-         }
+            Input:
+               Handle of the Being (EntityHandle)
+
+            Output:
+               (none)
+         */
+         void forgetObserver(EntityHandle being);
+
+         /*
+            Forgets every Being that has glanced at or observed the Tangible.
+            Game calls this when the Tangible is removed, since it gets a new
+            handle if it's ever inserted again and the Beings that looked at
+            it would no longer be able to find it.
+
+            Input:
+               (none)
+
+            Output:
+               (none)
+         */
+         void forgetObservers();
+
+         /*
+            Returns the number of Beings that have glanced at or observed the
+            Tangible.
+
+            Input:
+               (none)
+
+            Output:
+               size_t
+         */
+         size_t getNumObservers() const;
+
+         /*
+            Returns the number of bytes reserved for keeping track of which
+            Beings have glanced at or observed the Tangible.
+
+            Input:
+               (none)
+
+            Output:
+               size_t
+         */
+         size_t getObserverMemoryUsage() const;
 
          /*
             Serializes the Tangible.
@@ -262,6 +373,22 @@ namespace trogdor::entity {
             return resources;
          }
 
+         /*
+            Returns the amount of the specified resource the entity holds, or
+            std::nullopt if it doesn't hold any.
+
+            Input:
+               The resource (const std::shared_ptr<Resource> &)
+
+            Output:
+               Allocated amount (std::optional<double>)
+         */
+         inline std::optional<double> getResourceAllocation(const std::shared_ptr<Resource> &resource) const {
+
+            size_t i = findResourceAllocation(resource);
+            return i < resources.size() ? std::optional<double>(resources[i].second) : std::nullopt;
+         }
+
          /*
             Returns the allocation record for the specified resource if one
             exists or a std::pair with an expired weak_ptr and 0 if one doesn't.
@@ -278,18 +405,20 @@ namespace trogdor::entity {
             std::string name
          ) const {
 
-            if (
-               resourcesByName.end() != resourcesByName.find(name) &&
-               resources.end() != resources.find(resourcesByName.find(name)->second)
-            ) {
-               return *resources.find(resourcesByName.find(name)->second);
+            auto resource = resourcesByName.find(name);
+
+            if (resourcesByName.end() != resource) {
+
+               size_t i = findResourceAllocation(resource->second);
+
+               if (i < resources.size()) {
+                  return resources[i];
+               }
             }
 
             // If an allocation of th requested resource isn't found, we return
             // a std::pair with an expired weak_ptr and a value of 0.
-            else {
-               return {};
-            }
+            return {};
          }
    };
 }
@@ -2,6 +2,7 @@
 #define THING_H
 
 
+#include <array>
 #include <vector>
 #include <memory>
 
@@ -19,12 +20,19 @@ namespace trogdor::entity {
          std::weak_ptr<Place> location;       // where the Thing is located
          std::vector<std::string>  aliases;   // list of aliases
 
-         friend void Place::insertPlayer(const std::shared_ptr<Player> &);
-         friend void Place::removePlayer(const std::shared_ptr<Player> &);
-         friend void Place::insertObject(const std::shared_ptr<Object> &);
-         friend void Place::removeObject(const std::shared_ptr<Object> &);
-         friend void Place::insertCreature(const std::shared_ptr<Creature> &);
-         friend void Place::removeCreature(const std::shared_ptr<Creature> &);
+         // The Thing's position in each of its location's containers, indexed
+         // by Place::ContentsSlot. Place uses this to remove the Thing without
+         // having to search for it.
+         size_t contentsIndex[Place::NUM_CONTENTS_SLOTS] = {};
+
+         // The Thing's position in the list for each of its aliases in each of
+         // its location's alias indices, in the same order as aliases and
+         // indexed by Place::ContentsSlot. Like contentsIndex, this lets Place
+         // remove the Thing from an alias it shares with hundreds of others
+         // without searching for it.
+         std::vector<std::array<size_t, Place::NUM_CONTENTS_SLOTS>> aliasIndex;
+
+         friend class Place;
 
          /*
             Overrides Tangible::display() and shows a Thing's description in the
@@ -137,9 +145,9 @@ namespace trogdor::entity {
                (none)
 
             Output:
-               std::vector<std::string>
+               const std::vector<std::string> &
          */
-         inline std::vector<std::string> const getAliases() const {return aliases;}
+         inline const std::vector<std::string> &getAliases() const {return aliases;}
 
          /*
             Serializes the Thing.
@@ -1,6 +1,9 @@
 #ifndef ENTITY_TYPE_H
 #define ENTITY_TYPE_H
 
+
+#include <cstdint>
+
 namespace trogdor::entity {
 
 
@@ -18,6 +21,80 @@ namespace trogdor::entity {
       ENTITY_TANGIBLE = 9,
       ENTITY_RESOURCE = 10
    };
+
+   // Number of values in enum EntityType (including ENTITY_UNDEFINED)
+   constexpr int NUM_ENTITY_TYPES = ENTITY_RESOURCE + 1;
+
+   // An Entity's type along with every type it inherits from, stored as a
+   // bitmask with one bit set for each (see entityTypeMask().)
+   typedef uint16_t EntityTypeMask;
+
+   /*
+      Returns the bit that represents a single type in an EntityTypeMask.
+
+      Input:
+         Entity type (enum EntityType)
+
+      Output:
+         Bit (EntityTypeMask)
+   */
+   constexpr EntityTypeMask entityTypeBit(enum EntityType type) {
+
+      return static_cast<EntityTypeMask>(1 << type);
+   }
+
+   /*
+      Returns the bitmask for the given type, which includes the bits for all
+      of its ancestors. This mirrors the class hierarchy, so if you add a new
+      type, make sure to update it here.
+
+      Input:
+         Entity type (enum EntityType)
+
+      Output:
+         Bitmask (EntityTypeMask)
+   */
+   constexpr EntityTypeMask entityTypeMask(enum EntityType type) {
+
+      switch (type) {
+
+         case ENTITY_ENTITY:
+            return entityTypeBit(ENTITY_ENTITY);
+
+         case ENTITY_RESOURCE:
+            return entityTypeBit(ENTITY_RESOURCE) | entityTypeMask(ENTITY_ENTITY);
+
+         case ENTITY_TANGIBLE:
+            return entityTypeBit(ENTITY_TANGIBLE) | entityTypeMask(ENTITY_ENTITY);
+
+         case ENTITY_PLACE:
+            return entityTypeBit(ENTITY_PLACE) | entityTypeMask(ENTITY_TANGIBLE);
+
+         case ENTITY_ROOM:
+            return entityTypeBit(ENTITY_ROOM) | entityTypeMask(ENTITY_PLACE);
+
+         case ENTITY_THING:
+            return entityTypeBit(ENTITY_THING) | entityTypeMask(ENTITY_TANGIBLE);
+
+         case ENTITY_OBJECT:
+            return entityTypeBit(ENTITY_OBJECT) | entityTypeMask(ENTITY_THING);
+
+         case ENTITY_BEING:
+            return entityTypeBit(ENTITY_BEING) | entityTypeMask(ENTITY_THING);
+
+         case ENTITY_PLAYER:
+            return entityTypeBit(ENTITY_PLAYER) | entityTypeMask(ENTITY_BEING);
+
+         case ENTITY_CREATURE:
+            return entityTypeBit(ENTITY_CREATURE) | entityTypeMask(ENTITY_BEING);
+
+         default:
+            return 0;
+      }
+   }
+
+   static_assert(entityTypeMask(ENTITY_CREATURE) & entityTypeBit(ENTITY_TANGIBLE));
+   static_assert(!(entityTypeMask(ENTITY_ROOM) & entityTypeBit(ENTITY_THING)));
 };
 
 #endif
\ No newline at end of file
@@ -62,9 +62,9 @@ namespace trogdor::event {
                (none)
 
             Output:
-               Event listeners (std::vector<EventArgument>)
+               Event arguments (const std::vector<EventArgument> &)
          */
-         inline const std::vector<EventArgument> getArguments() const {return arguments;}
+         inline const std::vector<EventArgument> &getArguments() const {return arguments;}
 
          /*
             Prepend an event listener to the beginning of the listeners list.
@@ -27,12 +27,13 @@ namespace trogdor::event {
 
          /*
             Constructors for the EventListener class. In the deserialization
-            constructor, the Lua state passed is the Lua state we set for any
-            serialized instances of LuaEventTrigger.
+            constructor, any serialized instances of LuaEventTrigger are given
+            the Game's Lua state. The state is only requested (and therefore
+            created) if at least one such trigger exists.
          */
          EventListener();
          EventListener(const EventListener &original);
-         EventListener(const serial::Serializable &data, const std::shared_ptr<LuaState> &L);
+         EventListener(const serial::Serializable &data, Game *game);
          // TODO: assignment operator that does same thing as copy constructor
 
          /*
@@ -3,6 +3,8 @@
 
 
 #include <any>
+#include <array>
+#include <chrono>
 #include <memory>
 #include <iostream>
 #include <functional>
@@ -10,6 +12,8 @@
 #include <string>
 #include <cstdlib>
 #include <optional>
+#include <unordered_set>
+#include <vector>
 
 #include <thread>
 #include <mutex>
@@ -20,6 +24,10 @@
 #include <trogdor/event/eventlistener.h>
 #include <trogdor/instantiator/instantiators/runtime.h>
 #include <trogdor/serial/serializable.h>
+#include <trogdor/entities/entitypool.h>
+#include <trogdor/entities/entityhandle.h>
+#include <trogdor/entities/entityview.h>
+#include <trogdor/entities/roomgraph.h>
 
 #include <trogdor/iostream/trogout.h>
 #include <trogdor/iostream/trogerr.h>
@@ -111,9 +119,17 @@ namespace trogdor {
          // Global EventListener for the entire game
          std::unique_ptr<event::EventListener> eventListener;
 
-         // Global Lua state for the game
+         // Global Lua state for the game. Most games never load a script, so
+         // this isn't created until it's needed (see getLuaState().)
          std::shared_ptr<LuaState> L;
 
+         // Guards the lazy creation of L (and luaGCConfig below)
+         std::mutex luaStateMutex;
+
+         // Garbage collector settings for L. Kept here so they can be set
+         // before L exists and applied once it's created.
+         LuaGCConfig luaGCConfig;
+
          // Defines if and how a player is presented with an introduction when
          // they're first added to the game
          struct {
@@ -134,17 +150,88 @@ namespace trogdor {
          // Player object representing default settings for all new players
          std::unique_ptr<entity::Player> defaultPlayer;
 
-         // Hash table of all entities in the game
+         // Allocates the game's Entities (see entitypool.h.) Declared before
+         // the entities themselves so that it outlives them.
+         std::shared_ptr<entity::EntityPool> entityPool = std::make_shared<entity::EntityPool>();
+
+         // Hash table of all entities in the game. Every Entity is stored here
+         // exactly once, regardless of its type.
          std::unordered_map<std::string, std::shared_ptr<entity::Entity>> entities;
-         std::unordered_map<std::string, std::shared_ptr<entity::Resource>> resources;
-         std::unordered_map<std::string, std::shared_ptr<entity::Tangible>> tangibles;
-         std::unordered_map<std::string, std::shared_ptr<entity::Place>> places;
-         std::unordered_map<std::string, std::shared_ptr<entity::Thing>> things;
-         std::unordered_map<std::string, std::shared_ptr<entity::Room>> rooms;
-         std::unordered_map<std::string, std::shared_ptr<entity::Being>> beings;
-         std::unordered_map<std::string, std::shared_ptr<entity::Player>> players;
-         std::unordered_map<std::string, std::shared_ptr<entity::Creature>> creatures;
-         std::unordered_map<std::string, std::shared_ptr<entity::Object>> objects;
+
+         // Prototypes of the Entity classes defined in the game, by class
+         // name. Instances of a class are copies of its prototype.
+         std::unordered_map<std::string, std::shared_ptr<entity::Entity>> entityClasses;
+
+         // The entities of each type (including inherited types), so that the
+         // views below only have to visit the entities they're interested in
+         std::array<entity::EntityTypeIndex, entity::NUM_ENTITY_TYPES> typeIndices;
+
+         // Type-filtered views of the entities above
+         entity::EntityView<entity::Resource> resources{entities, entity::ENTITY_RESOURCE, typeIndices[entity::ENTITY_RESOURCE]};
+         entity::EntityView<entity::Tangible> tangibles{entities, entity::ENTITY_TANGIBLE, typeIndices[entity::ENTITY_TANGIBLE]};
+         entity::EntityView<entity::Place> places{entities, entity::ENTITY_PLACE, typeIndices[entity::ENTITY_PLACE]};
+         entity::EntityView<entity::Thing> things{entities, entity::ENTITY_THING, typeIndices[entity::ENTITY_THING]};
+         entity::EntityView<entity::Room> rooms{entities, entity::ENTITY_ROOM, typeIndices[entity::ENTITY_ROOM]};
+         entity::EntityView<entity::Being> beings{entities, entity::ENTITY_BEING, typeIndices[entity::ENTITY_BEING]};
+         entity::EntityView<entity::Player> players{entities, entity::ENTITY_PLAYER, typeIndices[entity::ENTITY_PLAYER]};
+         entity::EntityView<entity::Creature> creatures{entities, entity::ENTITY_CREATURE, typeIndices[entity::ENTITY_CREATURE]};
+         entity::EntityView<entity::Object> objects{entities, entity::ENTITY_OBJECT, typeIndices[entity::ENTITY_OBJECT]};
+
+         /*
+            Adds an Entity to the registry, or removes it, and updates the
+            index of each of its types.
+
+            Input:
+               Entity's name (const std::string &)
+               Entity (std::shared_ptr<entity::Entity>, registerEntity() only)
+
+            Output:
+               (none)
+         */
+         void registerEntity(const std::string &name, std::shared_ptr<entity::Entity> entity);
+         void unregisterEntity(const std::string &name);
+
+         // Issues a handle to every Entity in the game (see entityhandle.h)
+         entity::EntityHandleTable handles;
+
+         // Maps each tag to the Entities in the game that have it set, so that
+         // finding every Entity with a tag only visits the ones that match
+         std::unordered_map<std::string, std::unordered_set<entity::Entity *>> tagIndex;
+
+         // Entities can set and remove tags without locking the game, so the
+         // index has its own lock. Changes to handles are made while holding
+         // it too, so that tags are never indexed for an Entity that isn't
+         // (or is no longer) in the game. Entities update the index while
+         // holding their own lock, and the game holds an Entity's lock while
+         // walking its tags, so that lock is always acquired first.
+         std::mutex tagIndexMutex;
+
+         // Index of the connections between the game's Rooms (see roomgraph.h)
+         entity::RoomGraph roomGraph{this};
+
+         // Every Player and Room in the game, kept up to date alongside the
+         // registry. Code that runs without holding the game's lock, like a
+         // wandering Creature on the timer thread or the RoomGraph rebuilding
+         // itself, copies these instead of iterating the registry while
+         // another thread changes it. The lock is never held while acquiring
+         // another.
+         mutable std::mutex snapshotMutex;
+         std::vector<std::shared_ptr<entity::Player>> playerList;
+         std::vector<std::shared_ptr<entity::Room>> roomList;
+
+         /*
+            Removes an Entity from the index of a single tag, dropping the tag
+            from the index entirely once nothing has it. Assumes the caller
+            holds tagIndexMutex.
+
+            Input:
+               Entity (entity::Entity *)
+               Tag (const std::string &)
+
+            Output:
+               (none)
+         */
+         void eraseFromTagIndex(entity::Entity *entity, const std::string &tag);
 
          /*
             Called by initialize().  This initializes event handling in the game.
@@ -254,7 +341,10 @@ namespace trogdor {
          std::unique_ptr<Runtime> makeInstantiator();
 
          /*
-            Returns a reference to Game instance's LuaState object.
+            Returns a reference to Game instance's LuaState object. The state
+            is created the first time this is called, so games that never use
+            Lua don't pay for it. Use hasLuaState() if you need to know whether
+            it exists without creating it.
 
             I'm returning a const reference to a shared_ptr per this advice:
             "Use a const shared_ptr& as a parameter only if you're not sure
@@ -268,7 +358,23 @@ namespace trogdor {
             Output:
                Game's Lua State (const &LuaState)
          */
-         const std::shared_ptr<LuaState> &getLuaState() {return L;}
+         const std::shared_ptr<LuaState> &getLuaState();
+
+         /*
+            Returns true if the Game's LuaState has been created and false if
+            not.
+
+            Input:
+               (none)
+
+            Output:
+               Whether or not the Lua state exists (bool)
+         */
+         inline bool hasLuaState() {
+
+            std::lock_guard<std::mutex> lock(luaStateMutex);
+            return L ? true : false;
+         }
 
          /*
             Returns a pointer to Game instance's EventListener.
@@ -459,10 +565,7 @@ namespace trogdor {
             Output:
                True if the player is in the game and false if not
          */
-         inline bool playerIsInGame(const std::string name) const {
-
-            return players.find(name) == players.end() ? false : true;
-         }
+         bool playerIsInGame(const std::string name) const;
 
         /*
             Returns the Entity associated with the specified name.
@@ -485,7 +588,64 @@ namespace trogdor {
          }
 
          /*
-            Returns a read-only unordered_map of all entities
+            Returns the Entity a handle refers to, or nullptr if it's been
+            removed from the game. This is cheaper than looking an Entity up
+            by name or locking a weak_ptr.
+
+            Input:
+               Handle (entity::EntityHandle)
+
+            Output:
+               entity::Entity *
+         */
+         inline entity::Entity *getEntity(entity::EntityHandle handle) const {
+
+            return handles.resolve(handle);
+         }
+
+         /*
+            Returns every Entity in the game that has the given tag set, in no
+            particular order. Only Entities that match are visited.
+
+            Input:
+               Tag (const std::string &)
+
+            Output:
+               std::vector<std::shared_ptr<entity::Entity>>
+         */
+         std::vector<std::shared_ptr<entity::Entity>> getEntitiesWithTag(const std::string &tag);
+
+         /*
+            Returns the number of Entities in the game that have the given tag
+            set.
+
+            Input:
+               Tag (const std::string &)
+
+            Output:
+               Number of Entities (size_t)
+         */
+         size_t countEntitiesWithTag(const std::string &tag);
+
+         /*
+            Adds an Entity to, or removes it from, the game's index of Entities
+            with a given tag. Entity::setTag() and Entity::removeTag() call
+            these while holding the Entity's lock, so there should be no need
+            to call them directly. Does nothing if the Entity isn't in the
+            game.
+
+            Input:
+               Entity (entity::Entity *)
+               Tag (const std::string &)
+
+            Output:
+               (none)
+         */
+         void indexTag(entity::Entity *entity, const std::string &tag);
+         void unindexTag(entity::Entity *entity, const std::string &tag);
+
+         /*
+            Returns a read-only view of all entities
             (shared_ptr<Entity>) in the game.
 
             Input:
@@ -503,28 +663,19 @@ namespace trogdor {
                Name of Resource (std::string)
 
             Output:
-               const shared_ptr<Resource> &
+               shared_ptr<Resource> (nullptr if it doesn't exist)
          */
-         inline const std::shared_ptr<entity::Resource> &getResource(const std::string name) {
-
-            static std::shared_ptr<entity::Resource> nullResource(nullptr);
-
-            if (resources.find(name) == resources.end()) {
-               return nullResource;
-            }
-
-            return resources[name];
-         }
+         std::shared_ptr<entity::Resource> getResource(const std::string name) const;
 
          /*
-            Returns a read-only unordered_map of all resources
+            Returns a read-only view of all resources
             (shared_ptr<Resource>) in the game.
 
             Input:
                (none)
 
             Output:
-               const unordered_map<string, shared_ptr<Resource>> &
+               const EntityView<Resource> & (iterates like an unordered_map<string, shared_ptr<Resource>>)
          */
          inline const auto &getResources() const {return resources;}
 
@@ -535,28 +686,19 @@ namespace trogdor {
                Name of Tangible (std::string)
 
             Output:
-               const shared_ptr<Tangible> &
+               shared_ptr<Tangible> (nullptr if it doesn't exist)
          */
-         inline const std::shared_ptr<entity::Tangible> &getTangible(const std::string name) {
-
-            static std::shared_ptr<entity::Tangible> nullTangible(nullptr);
-
-            if (tangibles.find(name) == tangibles.end()) {
-               return nullTangible;
-            }
-
-            return tangibles[name];
-         }
+         std::shared_ptr<entity::Tangible> getTangible(const std::string name) const;
 
          /*
-            Returns a read-only unordered_map of all tangibles
+            Returns a read-only view of all tangibles
             (shared_ptr<Tangible>) in the game.
 
             Input:
                (none)
 
             Output:
-               const unordered_map<string, shared_ptr<Tangible>> &
+               const EntityView<Tangible> & (iterates like an unordered_map<string, shared_ptr<Tangible>>)
          */
          inline const auto &getTangibles() const {return tangibles;}
 
@@ -567,28 +709,19 @@ namespace trogdor {
                Name of Place (std::string)
 
             Output:
-               Place *
+               shared_ptr<Place> (nullptr if it doesn't exist)
          */
-         inline const std::shared_ptr<entity::Place> &getPlace(const std::string name) {
-
-            static std::shared_ptr<entity::Place> nullPlace(nullptr);
-
-            if (places.find(name) == places.end()) {
-               return nullPlace;
-            }
-
-            return places[name];
-         }
+         std::shared_ptr<entity::Place> getPlace(const std::string name) const;
 
          /*
-            Returns a read-only unordered_map of all places (shared_ptr<Place>)
+            Returns a read-only view of all places (shared_ptr<Place>)
             in the game.
 
             Input:
                (none)
 
             Output:
-               const unordered_map<string, shared_ptr<Room>> &
+               const EntityView<Place> & (iterates like an unordered_map<string, shared_ptr<Place>>)
          */
          inline const auto &getPlaces() const {return places;}
 
@@ -599,28 +732,19 @@ namespace trogdor {
                Name of Thing (std::string)
 
             Output:
-               Thing *
+               shared_ptr<Thing> (nullptr if it doesn't exist)
          */
-         inline const std::shared_ptr<entity::Thing> &getThing(const std::string name) {
-
-            static std::shared_ptr<entity::Thing> nullThing(nullptr);
-
-            if (things.find(name) == things.end()) {
-               return nullThing;
-            }
-
-            return things[name];
-         }
+         std::shared_ptr<entity::Thing> getThing(const std::string name) const;
 
          /*
-            Returns a read-only unordered_map of all things (shared_ptr<Thing>)
+            Returns a read-only view of all things (shared_ptr<Thing>)
             in the game.
 
             Input:
                (none)
 
             Output:
-               const unordered_map<string, shared_ptr<Thing>> &
+               const EntityView<Thing> & (iterates like an unordered_map<string, shared_ptr<Thing>>)
          */
          inline const auto &getThings() const {return things;}
 
@@ -631,28 +755,19 @@ namespace trogdor {
                Name of being (std::string)
 
             Output:
-               Being *
+               shared_ptr<Being> (nullptr if it doesn't exist)
          */
-         inline const std::shared_ptr<entity::Being> &getBeing(const std::string name) {
-
-            static std::shared_ptr<entity::Being> nullBeing(nullptr);
-
-            if (beings.find(name) == beings.end()) {
-               return nullBeing;
-            }
-
-            return beings[name];
-         }
+         std::shared_ptr<entity::Being> getBeing(const std::string name) const;
 
          /*
-            Returns a read-only unordered_map of all beings (shared_ptr<Being>)
+            Returns a read-only view of all beings (shared_ptr<Being>)
             in the game.
 
             Input:
                (none)
 
             Output:
-               const unordered_map<string, shared_ptr<Being>> &
+               const EntityView<Being> & (iterates like an unordered_map<string, shared_ptr<Being>>)
          */
          inline const auto &getBeings() const {return beings;}
 
@@ -663,60 +778,55 @@ namespace trogdor {
                Name of player (std::string)
 
             Output:
-               Player *
+               shared_ptr<Player> (nullptr if it doesn't exist)
          */
-         inline const std::shared_ptr<entity::Player> &getPlayer(const std::string name) {
-
-            static std::shared_ptr<entity::Player> nullPlayer(nullptr);
-
-            if (players.find(name) == players.end()) {
-               return nullPlayer;
-            }
-
-            return players[name];
-         }
+         std::shared_ptr<entity::Player> getPlayer(const std::string name) const;
 
          /*
-            Returns a read-only unordered_map of all players (shared_ptr<Player>)
+            Returns a read-only view of all players (shared_ptr<Player>)
             in the game.
 
             Input:
                (none)
 
             Output:
-               const unordered_map<string, shared_ptr<Player>> &
+               const EntityView<Player> & (iterates like an unordered_map<string, shared_ptr<Player>>)
          */
          inline const auto &getPlayers() const {return players;}
 
          /*
-            Returns the Creature object associated with the specified name.
+            Returns a copy of the list of Players in the game. Unlike
+            getPlayers(), this is safe to call from a thread that doesn't hold
+            the game's lock, and only visits Players.
 
             Input:
-               Name of creature (std::string)
+               (none)
 
             Output:
-               Creature *
+               std::vector<std::shared_ptr<entity::Player>>
          */
-         inline const std::shared_ptr<entity::Creature> &getCreature(const std::string name) {
+         std::vector<std::shared_ptr<entity::Player>> getPlayerSnapshot() const;
 
-            static std::shared_ptr<entity::Creature> nullCreature(nullptr);
+         /*
+            Returns the Creature object associated with the specified name.
 
-            if (creatures.find(name) == creatures.end()) {
-               return nullCreature;
-            }
+            Input:
+               Name of creature (std::string)
 
-            return creatures[name];
-         }
+            Output:
+               shared_ptr<Creature> (nullptr if it doesn't exist)
+         */
+         std::shared_ptr<entity::Creature> getCreature(const std::string name) const;
 
          /*
-            Returns a read-only unordered_map of all creatures
+            Returns a read-only view of all creatures
             (shared_ptr<Creature>) in the game.
 
             Input:
                (none)
 
             Output:
-               const unordered_map<string, shared_ptr<Creature>> &
+               const EntityView<Creature> & (iterates like an unordered_map<string, shared_ptr<Creature>>)
          */
          inline const auto &getCreatures() const {return creatures;}
 
@@ -727,28 +837,19 @@ namespace trogdor {
                Name of Object (std::string)
 
             Output:
-               Object *
+               shared_ptr<Object> (nullptr if it doesn't exist)
          */
-         inline const std::shared_ptr<entity::Object> &getObject(const std::string name) {
-
-            static std::shared_ptr<entity::Object> nullObject(nullptr);
-
-            if (objects.find(name) == objects.end()) {
-               return nullObject;
-            }
-
-            return objects[name];
-         }
+         std::shared_ptr<entity::Object> getObject(const std::string name) const;
 
          /*
-            Returns a read-only unordered_map of all objects (shared_ptr<Object>)
+            Returns a read-only view of all objects (shared_ptr<Object>)
             in the game.
 
             Input:
                (none)
 
             Output:
-               const unordered_map<string, shared_ptr<Object>> &
+               const EntityView<Object> & (iterates like an unordered_map<string, shared_ptr<Object>>)
          */
          inline const auto &getObjects() const {return objects;}
 
@@ -759,30 +860,46 @@ namespace trogdor {
                Name of Room (std::string)
 
             Output:
-               Room *
+               shared_ptr<Room> (nullptr if it doesn't exist)
          */
-         inline const std::shared_ptr<entity::Room> &getRoom(const std::string name) {
+         std::shared_ptr<entity::Room> getRoom(const std::string name) const;
 
-            static std::shared_ptr<entity::Room> nullRoom(nullptr);
+         /*
+            Returns a read-only view of all rooms (shared_ptr<Room>) in
+            the game.
 
-            if (rooms.find(name) == rooms.end()) {
-               return nullRoom;
-            }
+            Input:
+               (none)
 
-            return rooms[name];
-         }
+            Output:
+               const EntityView<Room> & (iterates like an unordered_map<string, shared_ptr<Room>>)
+         */
+         inline const auto &getRooms() const {return rooms;}
 
          /*
-            Returns a read-only unordered_map of all rooms (shared_ptr<Room>) in
-            the game.
+            Returns a copy of the list of Rooms in the game. Like
+            getPlayerSnapshot(), this is safe to call without holding the
+            game's lock.
 
             Input:
                (none)
 
             Output:
-               const unordered_map<string, shared_ptr<Room>> &
+               std::vector<std::shared_ptr<entity::Room>>
          */
-         inline const auto &getRooms() const {return rooms;}
+         std::vector<std::shared_ptr<entity::Room>> getRoomSnapshot() const;
+
+         /*
+            Returns the index of connections between the game's Rooms, which
+            answers shortest path and connectivity queries (see roomgraph.h.)
+
+            Input:
+               (none)
+
+            Output:
+               entity::RoomGraph &
+         */
+         inline entity::RoomGraph &getRoomGraph() {return roomGraph;}
 
          /*
             Inserts an entity into the game.
@@ -795,6 +912,76 @@ namespace trogdor {
          */
          void insertEntity(std::string name, std::shared_ptr<entity::Entity> entity);
 
+         /*
+            Inserts the prototype of an Entity class into the game, replacing
+            any existing class of the same name. Instances of the class are
+            created by copying its prototype. The prototype itself is never
+            inserted into the game as an Entity.
+
+            Input:
+               Class name (std::string)
+               Prototype (std::shared_ptr<entity::Entity>)
+
+            Output:
+               (none)
+         */
+         void insertEntityClass(std::string className, std::shared_ptr<entity::Entity> prototype);
+
+         /*
+            Returns the prototype of the specified Entity class.
+
+            Input:
+               Class name (const std::string &)
+
+            Output:
+               shared_ptr<Entity> (nullptr if the class doesn't exist)
+         */
+         std::shared_ptr<entity::Entity> getEntityClass(const std::string &className) const;
+
+         /*
+            Creates count new instances of an Object or Creature class,
+            inserts them into the game and, if a Place is given, puts them
+            there. This does the same thing as creating, inserting and placing
+            each instance one at a time, but it reserves room for all of them
+            up front and takes the game's and the Place's locks only once, so
+            it's the way to populate an area with a large number of identical
+            Things (waves of enemies, world resets, etc.)
+
+            Instances are named by replacing "{}" in namePattern with a
+            number, or by appending the number if namePattern doesn't contain
+            "{}". Numbering starts at 1, and numbers that would produce the
+            name of an existing Entity are skipped, so spawning more
+            instances later with the same pattern continues where the last
+            batch left off. If namePattern is empty, the class name is used.
+
+            If triggerEvents is true, a single "afterSpawnMany" event is
+            triggered once every instance has been inserted, with the game,
+            the Place (or nullptr), the class name and the number of
+            instances as arguments.
+
+            Throws an instance of UndefinedException if the class doesn't
+            exist or isn't a class of Objects or Creatures, and an instance of
+            ValidationException if namePattern doesn't produce valid names. In
+            either case, nothing is inserted.
+
+            Input:
+               Class name (const std::string &)
+               Number of instances to create (size_t)
+               Place to put them in (const std::shared_ptr<entity::Place> &, default: nullptr)
+               Pattern for their names (std::string, default: class name)
+               Whether or not to trigger an event (bool, default: true)
+
+            Output:
+               The new instances (std::vector<std::shared_ptr<entity::Thing>>)
+         */
+         std::vector<std::shared_ptr<entity::Thing>> spawnMany(
+            const std::string &className,
+            size_t count,
+            const std::shared_ptr<entity::Place> &place = nullptr,
+            std::string namePattern = "",
+            bool triggerEvents = true
+         );
+
          /*
             Removes the Entity referenced by name from the game and throws an
             instance of EntityException or UndefinedException.
@@ -884,16 +1071,24 @@ namespace trogdor {
          */
          inline void clearEntities() {
 
+            tagIndexMutex.lock();
+            tagIndex.clear();
+            handles.clear();
+            tagIndexMutex.unlock();
+
+            snapshotMutex.lock();
+            playerList.clear();
+            roomList.clear();
+            snapshotMutex.unlock();
+
             entities.clear();
-            resources.clear();
-            tangibles.clear();
-            places.clear();
-            rooms.clear();
-            things.clear();
-            objects.clear();
-            beings.clear();
-            creatures.clear();
-            players.clear();
+
+            for (auto &index: typeIndices) {
+               index.entities.clear();
+               index.positions.clear();
+            }
+
+            roomGraph.invalidate();
          }
 
          /*
@@ -1064,6 +1259,157 @@ namespace trogdor {
          void removeTimerJob(std::shared_ptr<TimerJob> j);
          void setTickInterval(size_t period);
 
+         /*
+            Wraps around the Lua state's sampling profiler. Unlike calling the
+            LuaState methods directly, these lock the state first, so they can
+            safely be called while the game is running to profile just this
+            game's scripts. dumpLuaProfile() returns the collected samples in
+            folded stack format. See luastate.h for documentation.
+         */
+         void startLuaProfiler(std::optional<int> interval = std::nullopt);
+         void stopLuaProfiler();
+         void resetLuaProfiler();
+         std::string dumpLuaProfile();
+
+         /*
+            Resumes any Lua coroutines that are ready to run at the given time.
+            Called by the timer on every tick, and does nothing if the game's
+            Lua state hasn't been created. See luascheduler.h for
+            documentation.
+
+            Input:
+               Current game time (size_t)
+
+            Output:
+               (none)
+         */
+         void resumeLuaCoroutines(size_t time);
+
+         /*
+            Sets the maximum amount of time the timer should spend resuming
+            Lua coroutines on each tick. See luascheduler.h for documentation.
+
+            Input:
+               Budget (std::chrono::microseconds)
+
+            Output:
+               (none)
+         */
+         void setLuaCoroutineBudget(std::chrono::microseconds budget);
+
+         /*
+            Configures the garbage collector for the game's Lua state. If the
+            state hasn't been created yet, the settings are applied when it is.
+            Throws an instance of LuaException if the settings are invalid or
+            unsupported. See luagcconfig.h for documentation.
+
+            Input:
+               Garbage collector settings (const LuaGCConfig &)
+
+            Output:
+               (none)
+         */
+         void configureLuaGC(const LuaGCConfig &config);
+
+         /*
+            Returns the garbage collector settings for the game's Lua state.
+
+            Input:
+               (none)
+
+            Output:
+               LuaGCConfig
+         */
+         inline LuaGCConfig getLuaGCConfig() {
+
+            std::lock_guard<std::mutex> lock(luaStateMutex);
+            return luaGCConfig;
+         }
+
+         /*
+            If idle stepping is enabled, steps the Lua garbage collector for up
+            to the given amount of time. Called by the timer between ticks.
+            Does nothing if Lua was never used or if the Lua state is busy, so
+            it never delays anything else.
+
+            Input:
+               Maximum amount of time to spend (std::chrono::microseconds)
+
+            Output:
+               Amount of time actually spent (std::chrono::microseconds)
+         */
+         std::chrono::microseconds collectLuaGarbage(std::chrono::microseconds limit);
+
+         /*
+            Returns the pool the game's Entities are allocated from. Lua
+            scripts allocate from the same pool.
+
+            Input:
+               (none)
+
+            Output:
+               const std::shared_ptr<entity::EntityPool> &
+         */
+         inline const std::shared_ptr<entity::EntityPool> &getEntityPool() const {
+
+            return entityPool;
+         }
+
+         /*
+            Constructs a new Entity in the game's pool. Arguments are
+            forwarded to the Entity's constructor. The Entity still has to be
+            inserted into the game with insertEntity().
+
+            Template arguments:
+               Entity type (Room, Object, Creature or Resource)
+               Constructor argument types
+
+            Input:
+               Constructor arguments
+
+            Output:
+               std::shared_ptr<T>
+         */
+         template <typename T, typename... Args>
+         inline std::shared_ptr<T> makeEntity(Args&&... args) {
+
+            return entity::EntityPool::make<T>(entityPool, std::forward<Args>(args)...);
+         }
+
+         /*
+            Returns usage statistics for the pool the game's Entities are
+            allocated from, keyed by Entity type. Useful for deciding how many
+            blocks to reserve up front. See entitypool.h for documentation.
+
+            Input:
+               (none)
+
+            Output:
+               std::unordered_map<entity::EntityType, entity::EntityPool::Occupancy, std::hash<int>>
+         */
+         inline std::unordered_map<entity::EntityType, entity::EntityPool::Occupancy, std::hash<int>>
+         getEntityPoolOccupancy() {
+
+            return entityPool->getOccupancy();
+         }
+
+         /*
+            Returns the number of bytes occupied by the game's Entities and
+            the number of bytes reserved for them by the pool. This doesn't
+            include memory owned by the Entities themselves (their messages,
+            properties, etc.)
+
+            Input:
+               (none)
+
+            Output:
+               entity::EntityPool::MemoryUsage
+         */
+         inline entity::EntityPool::MemoryUsage getEntityMemoryUsage() {
+
+            return entityPool->getMemoryUsage();
+         }
+
          /*
             Gets the current game time (in seconds.)  Note that I can't inline
             this due to forward declaration stuff.  F*#@ me!
@@ -1093,6 +1439,11 @@ namespace trogdor {
          */
          inline bool event(event::Event e) {
 
+            // Wake up any Lua coroutines that are waiting on this event
+            if (hasLuaState()) {
+               L->getScheduler()->signalEvent(e.getName());
+            }
+
             // make sure global EventListener is always listening
             e.prependListener(eventListener.get());
             return events.dispatch(e);
@@ -30,9 +30,6 @@ namespace trogdor {
          // Pointer to the game we're populating
          Game *game;
 
-         // User defined Entity classes
-         std::unordered_map<std::string, std::unique_ptr<entity::Entity>> typeClasses;
-
          // A hash mapping of entity type -> property name -> setter function
          std::unordered_map<std::string, std::unordered_map<std::string, propSetterFunc>> propSetters;
 
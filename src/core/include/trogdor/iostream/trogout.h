@@ -3,6 +3,7 @@
 
 
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <sstream>
 #include <memory>
@@ -107,6 +108,7 @@ namespace trogdor {
 
          // character and string output operators
          inline Trogout& operator<< (std::string val) {buffer << val; return *this;}
+         inline Trogout& operator<< (std::string_view val) {buffer << val; return *this;}
          inline Trogout& operator<< (char const *val) {buffer << val; return *this;}
          inline Trogout& operator<< (char val) {buffer << val; return *this;}
 
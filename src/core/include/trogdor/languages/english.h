@@ -2,6 +2,7 @@
 #define ENGLISH_H
 
 
+#include <regex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,10 +15,12 @@ using namespace std;
 namespace trogdor {
 
 
-   // Represents a regex replacement rule for pluralization
+   // Represents a regex replacement rule for pluralization. The pattern is
+   // compiled once, when the rule is added, rather than on every use.
    struct RegexReplacement {
       string regex;
       string replacement;
+      std::regex compiled;
    };
 
    /**************************************************************************/
@@ -303,6 +303,20 @@ namespace trogdor::entity {
                (none)
          */
          static int setShortDesc(lua_State *L);
+
+         /*
+            Returns several of the Entity's properties in a single table keyed
+            by property name, so that scripts don't have to make a separate
+            call for each one. Properties that aren't set are left out of the
+            table. If no argument is given, all properties are returned.
+
+            Lua input:
+               Array of property names (optional)
+
+            Lua output:
+               Table of property values
+         */
+         static int getProperties(lua_State *L);
    };
 }
 
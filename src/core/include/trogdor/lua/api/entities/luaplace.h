@@ -106,6 +106,40 @@ namespace trogdor::entity {
                (none)
          */
          static int removeThing(lua_State *L);
+
+         /*
+            Returns all Things in the Place as an array. This is much cheaper
+            than looking up each Thing individually by name.
+
+            Lua input:
+               (none)
+
+            Lua output:
+               Array of Things
+         */
+         static int getThings(lua_State *L);
+
+         /*
+            Returns all Beings in the Place as an array.
+
+            Lua input:
+               (none)
+
+            Lua output:
+               Array of Beings
+         */
+         static int getBeings(lua_State *L);
+
+         /*
+            Returns all Objects in the Place as an array.
+
+            Lua input:
+               (none)
+
+            Lua output:
+               Array of Objects
+         */
+         static int getObjects(lua_State *L);
    };
 }
 
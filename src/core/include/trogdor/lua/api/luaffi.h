@@ -0,0 +1,122 @@
+#ifndef LUAFFI_H
+#define LUAFFI_H
+
+
+extern "C" {
+   #include <lua.h>
+}
+
+
+/*
+   Plain C accessors for frequently read Entity data. These exist so that
+   scripts running under LuaJIT can read entities through the FFI instead of
+   going through a lua_CFunction on every access, which prevents JIT
+   compilation of the calling trace. Each function takes as its first argument
+   a raw pointer to an Entity (the same pointer that's stored in an Entity's
+   Lua userdata.) No type checking is performed, so passing in anything other
+   than a valid Entity results in undefined behavior.
+*/
+extern "C" {
+
+   /*
+      Returns the Entity's name. The pointer remains valid for the lifetime of
+      the Entity.
+
+      Input:
+         Entity *
+
+      Output:
+         Name (const char *)
+   */
+   const char *trogdor_entity_get_name(const void *entity);
+
+   /*
+      Returns the Entity's most specific type as an integer corresponding to
+      enum EntityType.
+
+      Input:
+         Entity *
+
+      Output:
+         Type (int)
+   */
+   int trogdor_entity_get_type(const void *entity);
+
+   /*
+      Returns 1 if the Entity is of the given type (enum EntityType) and 0 if
+      not.
+
+      Input:
+         Entity *
+         Type (int)
+
+      Output:
+         int
+   */
+   int trogdor_entity_is_type(const void *entity, int type);
+
+   /*
+      Returns 1 if the tag is set on the Entity and 0 if not.
+
+      Input:
+         Entity *
+         Tag (const char *)
+
+      Output:
+         int
+   */
+   int trogdor_entity_is_tag_set(const void *entity, const char *tag);
+
+   /*
+      If the given property is set and is numeric, writes it to value and
+      returns 1. Otherwise, returns 0 and leaves value untouched.
+
+      Input:
+         Entity *
+         Property name (const char *)
+         Where to write the value (double *)
+
+      Output:
+         int
+   */
+   int trogdor_entity_get_number(const void *entity, const char *key, double *value);
+}
+
+
+namespace trogdor {
+
+
+   class LuaFFI {
+
+      public:
+
+         // This is the variable name of the global table that exposes the FFI
+         // accessors to scripts
+         static const char *globalName;
+
+         /*
+            When the library is built against LuaJIT with ENABLE_LUAJIT_FFI
+            turned on, this defines a global table (EntityFFI) with the
+            following functions, each of which is backed by one of the C
+            accessors above:
+
+               EntityFFI.getName(entity)
+               EntityFFI.getType(entity)
+               EntityFFI.isType(entity, typeName)
+               EntityFFI.isTagSet(entity, tag)
+               EntityFFI.getNumber(entity, property)
+
+            Otherwise, this does nothing.
+
+            Input:
+               Lua state
+
+            Output:
+               (none)
+         */
+         static void registerLuaType(lua_State *L);
+   };
+}
+
+
+#endif
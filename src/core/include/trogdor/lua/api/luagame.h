@@ -12,6 +12,10 @@ namespace trogdor {
    // Forward declaration of Game
    class Game;
 
+   namespace entity {
+      class Room;
+   }
+
 
    class LuaGame {
 
@@ -41,6 +45,21 @@ namespace trogdor {
          */
          static const luaL_Reg *getMethods();
 
+         /*
+            Returns the Room at the specified location on the Lua stack, which
+            can either be a Room or the name of one. Raises a Lua error if it's
+            neither or if no Room by that name exists.
+
+            Input:
+               Lua State
+               Game (Game *)
+               Index on stack
+
+            Output:
+               entity::Room *
+         */
+         static entity::Room *checkRoomArgument(lua_State *L, Game *g, int i);
+
       public:
 
          // The name of the metatable that represents our global Lua Game object
@@ -140,6 +159,82 @@ namespace trogdor {
                True if the game is started and false if it's stopped (Boolean)
          */
          static int inProgress(lua_State *L);
+
+         /*
+            Returns an array of every Entity in the game that matches all of
+            the given filters. Filters are passed in as a table with the
+            following optional keys:
+
+               type:  only return Entities of this type (string)
+               tag:   only return Entities with this tag set (string)
+               place: only return Things inside this Place (Place or name)
+
+            Lookups are done against the game's type-specific indexes (or, if
+            place is given, the Place's), so a query only visits Entities that
+            could possibly match its type. Queries by tag that aren't limited
+            to a Place use the game's tag index instead and only visit
+            Entities that have the tag.
+
+            Lua input:
+               Table of filters (optional)
+
+            Lua output:
+               Array of Entities
+         */
+         static int query(lua_State *L);
+
+         /*
+            Lua binding to Game->spawnMany(). Creates count instances of an
+            Object or Creature class at once and returns them. If a Place is
+            given, the instances are put there. Names are generated from the
+            pattern as described in game.h (by default, the class name
+            followed by a number.) Raises an error if the class doesn't exist
+            or the pattern doesn't produce valid names.
+
+            Lua input:
+               Class name (string)
+               Number of instances (integer)
+               Place to put them in (Place or name, optional)
+               Pattern for their names (string, optional)
+
+            Lua output:
+               Array of Entities
+         */
+         static int spawnMany(lua_State *L);
+
+         /*
+            Lua bindings to the game's RoomGraph (see entities/roomgraph.h.)
+            Rooms can be passed either as Room objects or by name.
+
+            game:getDistance(from, to) returns the smallest number of steps it
+            takes to get from one Room to another, or nil if there's no way.
+
+            game:getNextStep(from, to) returns the next Room along a shortest
+            path and the direction that leads to it, or nil if there's no path
+            or the Rooms are the same.
+
+            game:getPath(from, to) returns an array of every Room along a
+            shortest path (not including the starting Room) and an array of
+            the directions taken to get to each one. Both are empty if there's
+            no path.
+
+            game:getRoomComponent(room) returns an integer identifying the
+            group of Rooms the Room is connected to (counting connections in
+            either direction), between 1 and game:getNumRoomComponents(). It's
+            only valid until the game's Rooms or connections change.
+
+            Lua input:
+               Starting Room (Room or name)
+               Destination (Room or name)
+
+            Lua output:
+               (see above)
+         */
+         static int getDistance(lua_State *L);
+         static int getNextStep(lua_State *L);
+         static int getPath(lua_State *L);
+         static int getRoomComponent(lua_State *L);
+         static int getNumRoomComponents(lua_State *L);
    };
 }
 
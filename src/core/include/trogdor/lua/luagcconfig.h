@@ -0,0 +1,43 @@
+#ifndef LUAGCCONFIG_H
+#define LUAGCCONFIG_H
+
+
+namespace trogdor {
+
+
+   // Garbage collector modes. Generational mode is only available when built
+   // against a version of Lua that supports it (see
+   // LuaState::supportsGenerationalGC().)
+   enum LuaGCMode {
+      LUA_GC_MODE_INCREMENTAL,
+      LUA_GC_MODE_GENERATIONAL
+   };
+
+   // Garbage collector settings for a single game's Lua state. The defaults
+   // match Lua's own.
+   struct LuaGCConfig {
+
+      // Incremental or generational collection
+      LuaGCMode mode = LUA_GC_MODE_INCREMENTAL;
+
+      // How long the collector waits before starting a new cycle, as a
+      // percentage of memory in use after the last one (LUA_GCSETPAUSE)
+      int pause = 200;
+
+      // Speed of the collector relative to memory allocation, as a
+      // percentage (LUA_GCSETSTEPMUL)
+      int stepMultiplier = 200;
+
+      // If true, the timer runs small garbage collection steps in the idle
+      // time between ticks so that less of the work lands in the middle of a
+      // command
+      bool idleStepping = false;
+
+      // Size of each idle step (the data argument to LUA_GCSTEP.) 0 performs
+      // one basic step at a time.
+      int idleStepSize = 0;
+   };
+}
+
+
+#endif
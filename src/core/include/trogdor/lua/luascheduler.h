@@ -0,0 +1,292 @@
+#ifndef LUASCHEDULER_H
+#define LUASCHEDULER_H
+
+
+#include <mutex>
+#include <deque>
+#include <queue>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+
+extern "C" {
+   #include <lua.h>
+   #include <lauxlib.h>
+}
+
+
+namespace trogdor {
+
+
+   class Game;
+
+   /*
+      Cooperative scheduler for Lua coroutines. Each LuaState owns one, and it's
+      driven by the game's timer, which calls resume() once per tick.
+
+      Scripts start a coroutine by calling spawn(function, ...), and from
+      inside that coroutine can call wait(ticks) to sleep for a number of
+      clock ticks or waitEvent(name) to sleep until the game fires the named
+      event (waitEvent() returns the event's name.) Any other yield, including
+      coroutine.yield() with arguments, resumes on the next tick. Since a
+      waiting coroutine is nothing more than a Lua thread and a few bytes of
+      bookkeeping, thousands of scripted behaviors can share a single Lua
+      state without each needing its own TimerJob.
+
+      The amount of time spent resuming coroutines on each tick is bounded by
+      a budget. Coroutines that are ready to run when the budget runs out are
+      resumed first on the next tick. At least one coroutine is resumed on
+      every tick, however small the budget.
+
+      Coroutines live only in memory and are not preserved when a game is
+      serialized.
+   */
+   class LuaScheduler {
+
+      public:
+
+         // Default amount of time to spend resuming coroutines on each tick
+         static constexpr std::chrono::microseconds DEFAULT_TICK_BUDGET =
+            std::chrono::microseconds(5000);
+
+      private:
+
+         // Registered Lua functions
+         static const luaL_Reg functions[];
+
+         // A single scheduled coroutine
+         struct Coroutine {
+            lua_State *thread;  // The coroutine's Lua thread
+            int ref;            // Keeps the thread from being garbage collected
+            int nArgs;          // Arguments waiting on the thread's stack for the first resume
+         };
+
+         // Lua state the coroutines belong to
+         lua_State *L;
+
+         // Game the Lua state belongs to (used for reporting errors)
+         Game *game;
+
+         // Maximum amount of time to spend in resume() (0 means no limit)
+         std::chrono::microseconds budget;
+
+         // Used to assign a unique id to every coroutine
+         size_t nextId;
+
+         // All coroutines that haven't yet finished, indexed by id. Like the
+         // sleeping queue below, this is only ever touched by code that has
+         // locked the LuaState.
+         std::unordered_map<size_t, Coroutine> coroutines;
+
+         // Coroutines waiting on the clock, ordered by the tick at which they
+         // should wake up
+         std::priority_queue<
+            std::pair<size_t, size_t>,
+            std::vector<std::pair<size_t, size_t>>,
+            std::greater<std::pair<size_t, size_t>>
+         > sleeping;
+
+         // Events can be signaled from any thread, so anything they touch is
+         // guarded by a separate lock rather than the LuaState's
+         std::mutex mutex;
+
+         // Coroutines to resume on the next call to resume(), along with the
+         // name of the event that woke them up (or an empty string if they
+         // weren't waiting on an event)
+         std::deque<std::pair<size_t, std::string>> ready;
+
+         // Ids of coroutines waiting on each event
+         std::unordered_map<std::string, std::vector<size_t>> waiting;
+
+         // Debug hook installed on every coroutine (see setHook())
+         lua_Hook hook = nullptr;
+         int hookMask = 0;
+         int hookCount = 0;
+
+         /*
+            Creates a new coroutine from the function and arguments on top of
+            the given Lua stack and queues it to run on the next tick.
+
+            Input:
+               Lua thread where the function and its arguments were pushed
+               Number of arguments pushed after the function (int)
+
+            Output:
+               Coroutine id (size_t)
+         */
+         size_t spawn(lua_State *from, int nArgs);
+
+         /*
+            Wraps around lua_resume, whose signature differs between versions.
+
+            Input:
+               Coroutine's Lua thread
+               Number of arguments on the thread's stack (int)
+
+            Output:
+               Status returned by lua_resume (int)
+         */
+         int resumeThread(lua_State *thread, int nArgs);
+
+      public:
+
+         /*
+            Registers spawn(), wait() and waitEvent() as global functions.
+
+            Input:
+               Lua state
+
+            Output:
+               (none)
+         */
+         static void registerLuaFunctions(lua_State *L);
+
+         /*
+            Lua input:
+               Function to run as a coroutine
+               Any arguments that should be passed to it (optional)
+
+            Lua output:
+               Coroutine id (number)
+         */
+         static int spawnCoroutine(lua_State *L);
+
+         /*
+            Lua input:
+               Number of clock ticks to wait (number)
+
+            Lua output:
+               (none)
+         */
+         static int wait(lua_State *L);
+
+         /*
+            Lua input:
+               Name of the event to wait for (string)
+
+            Lua output:
+               Name of the event (string)
+         */
+         static int waitEvent(lua_State *L);
+
+         /*
+            Constructor.
+         */
+         LuaScheduler() = delete;
+         LuaScheduler(const LuaScheduler &) = delete;
+         LuaScheduler &operator=(const LuaScheduler &) = delete;
+         inline LuaScheduler(lua_State *L, Game *game): L(L), game(game),
+         budget(DEFAULT_TICK_BUDGET), nextId(1) {}
+
+         /*
+            Starts the global function with the given name as a coroutine. It
+            will first run on the next tick. Throws an instance of
+            LuaException if the function doesn't exist.
+
+            Input:
+               Name of global Lua function (const std::string &)
+
+            Output:
+               Coroutine id (size_t)
+         */
+         size_t spawn(const std::string &function);
+
+         /*
+            Removes a coroutine from the scheduler. It won't be resumed again.
+            Does nothing if the coroutine has already finished.
+
+            Input:
+               Coroutine id (size_t)
+
+            Output:
+               (none)
+         */
+         void cancel(size_t id);
+
+         /*
+            Resumes every coroutine that's ready to run at the given time,
+            stopping early if the budget runs out. Errors raised by a coroutine
+            are written to the game's error stream and end that coroutine.
+            Called by the timer on every tick.
+
+            Input:
+               Current game time (size_t)
+
+            Output:
+               (none)
+         */
+         void resume(size_t time);
+
+         /*
+            Wakes up every coroutine that's waiting on the named event. They'll
+            be resumed on the next tick. Safe to call from any thread.
+
+            Input:
+               Event name (const std::string &)
+
+            Output:
+               (none)
+         */
+         void signalEvent(const std::string &event);
+
+         /*
+            Installs a debug hook on every coroutine that hasn't finished and on
+            every one spawned from now on, replacing any hook it already had. A
+            null hook removes it. Used by the profiler, since Lua hooks are set
+            per thread.
+
+            Input:
+               Hook (lua_Hook)
+               Events the hook should be called for (int)
+               Instruction count for LUA_MASKCOUNT (int)
+
+            Output:
+               (none)
+         */
+         void setHook(lua_Hook newHook, int mask, int count);
+
+         /*
+            Sets the maximum amount of time to spend resuming coroutines on
+            each tick. A budget of 0 means no limit.
+
+            Input:
+               Budget (std::chrono::microseconds)
+
+            Output:
+               (none)
+         */
+         inline void setBudget(std::chrono::microseconds newBudget) {
+
+            budget = newBudget;
+         }
+
+         /*
+            Returns the maximum amount of time to spend resuming coroutines on
+            each tick.
+
+            Input:
+               (none)
+
+            Output:
+               Budget (std::chrono::microseconds)
+         */
+         inline std::chrono::microseconds getBudget() const {return budget;}
+
+         /*
+            Returns the number of coroutines that haven't yet finished.
+
+            Input:
+               (none)
+
+            Output:
+               Number of coroutines (size_t)
+         */
+         inline size_t size() const {return coroutines.size();}
+   };
+}
+
+
+#endif
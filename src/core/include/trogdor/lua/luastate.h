@@ -3,7 +3,11 @@
 
 
 #include <mutex>
+#include <memory>
+#include <chrono>
 #include <string>
+#include <ostream>
+#include <unordered_map>
 
 extern "C" {
    #include <lua.h>
@@ -12,9 +16,15 @@ extern "C" {
 }
 
 #include <trogdor/lua/luatype.h>
+#include <trogdor/lua/luagcconfig.h>
 #include <trogdor/lua/luatable.h>
+#include <trogdor/lua/luatablebuilder.h>
+#include <trogdor/lua/luascheduler.h>
+
+#include <trogdor/entities/entitypool.h>
 
 #include <trogdor/lua/api/luagame.h>
+#include <trogdor/lua/api/luaffi.h>
 
 #include <trogdor/lua/api/entities/luaentity.h>
 #include <trogdor/lua/api/entities/luaresource.h>
@@ -73,6 +83,74 @@ namespace trogdor {
          // Pointer to the Game object this Lua state is a part of
          Game *game;
 
+         // Whether or not the sampling profiler is currently running
+         bool profiling;
+
+         // Number of Lua VM instructions between each profiler sample
+         int profilerInterval;
+
+         // Number of times each unique call stack was sampled, keyed by the
+         // stack in folded format (see dumpProfile())
+         std::unordered_map<std::string, size_t> profilerSamples;
+
+         /*
+            Count hook installed by startProfiler(). Each time it's invoked,
+            the current call stack is recorded as a single sample.
+
+            Input:
+               Lua state (the main thread or a coroutine)
+               Debug info for the currently running function (unused)
+
+            Output:
+               (none)
+         */
+         static void profilerHook(lua_State *L, lua_Debug *);
+
+         // Allocates Entities created by Lua scripts. This is the Game's pool
+         // (or a private one if the state doesn't belong to a Game.) Shared so
+         // that Entities handed off to the game can return their memory even
+         // after the LuaState is gone.
+         std::shared_ptr<entity::EntityPool> entityPool;
+
+         /*
+            Points entityPool at the Game's pool, or creates a private one if
+            there's no Game.
+
+            Input:
+               (none)
+
+            Output:
+               (none)
+         */
+         void initEntityPool();
+
+         // Runs coroutines started by scripts (see luascheduler.h)
+         std::unique_ptr<LuaScheduler> scheduler;
+
+         // Garbage collector settings, applied whenever L is (re)created
+         LuaGCConfig gcConfig;
+
+         // Whether stepGC() is partway through a collection cycle, and how
+         // much memory (in KB) was in use when it last finished one. An idle
+         // state doesn't start another cycle until its memory use has grown
+         // past this by the pause percentage, same as Lua's own collector.
+         bool gcCycleInProgress = false;
+         int gcBaseline = 0;
+
+         // Number of incremental steps taken by stepGC()
+         size_t numGCSteps = 0;
+
+         /*
+            Applies gcConfig to L.
+
+            Input:
+               (none)
+
+            Output:
+               (none)
+         */
+         void applyGCConfig();
+
       protected:
 
          // number of function arguments pushed onto the Lua stack
@@ -118,7 +196,25 @@ namespace trogdor {
             parsedScriptData = "";
             lastErrorMsg = "";
 
+            profiling = false;
+            profilerInterval = DEFAULT_PROFILER_INTERVAL;
+            profilerSamples.clear();
+
+            gcCycleInProgress = false;
+            gcBaseline = 0;
+            numGCSteps = 0;
+
             L = luaL_newstate();
+            scheduler = std::make_unique<LuaScheduler>(L, game);
+
+            initEntityPool();
+
+            applyGCConfig();
+
+            // Lets static callbacks (like the profiler hook) find their way
+            // back to the LuaState that owns L
+            lua_pushlightuserdata(L, this);
+            lua_setfield(L, LUA_REGISTRYINDEX, RegistryKey);
          }
 
          /*
@@ -154,6 +250,12 @@ namespace trogdor {
             entity::LuaBeing::registerLuaType(L);
             entity::LuaCreature::registerLuaType(L);
             entity::LuaPlayer::registerLuaType(L);
+
+            // Only does anything when built against LuaJIT with FFI support
+            LuaFFI::registerLuaType(L);
+
+            // spawn(), wait() and waitEvent()
+            LuaScheduler::registerLuaFunctions(L);
          }
 
          /*
@@ -167,10 +269,58 @@ namespace trogdor {
             Output:
                (none)
          */
-         static void pushLuaValue(LuaValue v, lua_State *L);
+         static void pushLuaValue(const LuaValue &v, lua_State *L);
 
       public:
 
+         // Key in the Lua registry where a pointer to the owning LuaState is
+         // stored
+         static const char *RegistryKey;
+
+         // Default number of Lua VM instructions between profiler samples
+         static constexpr int DEFAULT_PROFILER_INTERVAL = 1000;
+
+         /*
+            Returns the LuaState that owns the given lua_State, or nullptr if
+            the lua_State wasn't created by an instance of LuaState.
+
+            Input:
+               Lua state
+
+            Output:
+               LuaState *
+         */
+         static LuaState *getInstance(lua_State *L);
+
+         /*
+            Returns the pool that Entities created by Lua scripts are
+            allocated from.
+
+            Input:
+               (none)
+
+            Output:
+               const std::shared_ptr<entity::EntityPool> &
+         */
+         inline const std::shared_ptr<entity::EntityPool> &getEntityPool() const {
+
+            return entityPool;
+         }
+
+         /*
+            Returns the scheduler that runs coroutines started by Lua scripts.
+            Like everything else that touches the Lua state, the scheduler
+            should only be used while the state is locked (with the exception
+            of LuaScheduler::signalEvent(), which is thread-safe.)
+
+            Input:
+               (none)
+
+            Output:
+               LuaScheduler *
+         */
+         inline LuaScheduler *getScheduler() const {return scheduler.get();}
+
          /*
             Returns the version of Lua this class was built against in the
             format "5.x.x".
@@ -213,6 +363,106 @@ namespace trogdor {
          inline void lock() {mutex.lock();}
          inline void unlock() {mutex.unlock();}
 
+         /*
+            Like lock(), but returns false immediately instead of blocking if
+            the state is already locked. Used for opportunistic work (like
+            stepping the garbage collector between ticks) that should never
+            hold anything else up.
+
+            Input:
+               (none)
+
+            Output:
+               Whether or not the lock was acquired (bool)
+         */
+         inline bool tryLock() {return mutex.try_lock();}
+
+         /*
+            Returns true if the version of Lua we were built against supports
+            generational garbage collection and false if not.
+
+            Input:
+               (none)
+
+            Output:
+               bool
+         */
+         inline static constexpr bool supportsGenerationalGC() {
+
+            #ifdef LUA_GCGEN
+               return true;
+            #else
+               return false;
+            #endif
+         }
+
+         /*
+            Throws an instance of LuaException if the given garbage collector
+            settings are invalid or not supported by the version of Lua we were
+            built against.
+
+            Input:
+               Garbage collector settings (const LuaGCConfig &)
+
+            Output:
+               (none)
+         */
+         static void validateGCConfig(const LuaGCConfig &config);
+
+         /*
+            Configures the garbage collector. Throws an instance of
+            LuaException if the settings are invalid.
+
+            Input:
+               Garbage collector settings (const LuaGCConfig &)
+
+            Output:
+               (none)
+         */
+         void configureGC(const LuaGCConfig &config);
+
+         /*
+            Returns the garbage collector's current settings.
+
+            Input:
+               (none)
+
+            Output:
+               const LuaGCConfig &
+         */
+         inline const LuaGCConfig &getGCConfig() const {return gcConfig;}
+
+         /*
+            Performs incremental garbage collection steps until either the
+            current collection cycle finishes or the time limit is reached,
+            whichever comes first. The step size is taken from
+            LuaGCConfig::idleStepSize. Note that a single step can't be
+            interrupted, so the limit may be overshot by up to one step.
+
+            A new cycle is only started once memory use has grown past what
+            it was at the end of the last one by LuaGCConfig::pause percent,
+            so a state that's sitting idle isn't collected over and over.
+
+            Input:
+               Maximum amount of time to spend (std::chrono::microseconds)
+
+            Output:
+               Amount of time actually spent (std::chrono::microseconds)
+         */
+         std::chrono::microseconds stepGC(std::chrono::microseconds limit);
+
+         /*
+            Returns the number of incremental steps stepGC() has taken since
+            the state was created.
+
+            Input:
+               (none)
+
+            Output:
+               Number of steps (size_t)
+         */
+         inline size_t getNumGCSteps() const {return numGCSteps;}
+
          /*
             Returns the Game that the Lua state operates on.
 
@@ -386,6 +636,37 @@ namespace trogdor {
          */
          static void pushEntity(lua_State *L, entity::Entity *e);
 
+         /*
+            Pushes an array of Entities onto a Lua stack. The container may
+            hold either raw or shared pointers to any type of Entity, which
+            lets callers push the contents of Place, Game, etc. directly
+            without first building a LuaArray.
+
+            Template arguments:
+               Container type
+
+            Input:
+               Lua state
+               Container of Entity pointers (const Container &)
+
+            Output:
+               (none)
+         */
+         template<typename Container> static void pushEntityArray(
+            lua_State *L,
+            const Container &entities
+         ) {
+
+            int i = 1;
+
+            lua_createtable(L, static_cast<int>(entities.size()), 0);
+
+            for (const auto &e: entities) {
+               pushEntity(L, &*e);
+               lua_rawseti(L, -2, i++);
+            }
+         }
+
          /*
             Pushes an array onto a Lua stack. Static access allows for both
             Lua-to-C and C-to-Lua.
@@ -397,7 +678,7 @@ namespace trogdor {
             Output:
                (none)
          */
-         static void pushArray(lua_State *L, LuaArray &arg);
+         static void pushArray(lua_State *L, const LuaArray &arg);
 
          /*
             Pushes a table onto a Lua stack. Static access allows for both
@@ -410,7 +691,7 @@ namespace trogdor {
             Output:
                (none)
          */
-         static void pushTable(lua_State *L, LuaTable &arg);
+         static void pushTable(lua_State *L, const LuaTable &arg);
 
          /*
             Constructor for the LuaState object (requires a pointer to the
@@ -426,7 +707,7 @@ namespace trogdor {
          /*
             Copy Constructor for the LuaState object.
          */
-         inline LuaState(const LuaState &LSrc): game(LSrc.game) {
+         inline LuaState(const LuaState &LSrc): game(LSrc.game), gcConfig(LSrc.gcConfig) {
 
             initState();
             initLibs();
@@ -461,6 +742,7 @@ namespace trogdor {
             if (this != &rhs) {
                lua_close(L);
                game = rhs.game;
+               gcConfig = rhs.gcConfig;
                initState();
                initLibs();
                loadScriptFromString(rhs.parsedScriptData);
@@ -527,9 +809,9 @@ namespace trogdor {
             nArgs++;
          }
 
-         inline void pushArgument(std::string arg) {
+         inline void pushArgument(const std::string &arg) {
 
-            lua_pushstring(L, arg.c_str());
+            lua_pushlstring(L, arg.c_str(), arg.length());
             nArgs++;
          }
 
@@ -545,18 +827,36 @@ namespace trogdor {
             nArgs++;
          }
 
-         inline void pushArgument(LuaArray &arg) {
+         inline void pushArgument(const LuaArray &arg) {
 
             nArgs++;
             pushArray(L, arg);
          }
 
-         inline void pushArgument(LuaTable &arg) {
+         inline void pushArgument(const LuaTable &arg) {
 
             nArgs++;
             pushTable(L, arg);
          }
 
+         /*
+            Pushes an empty table argument onto the stack and returns a builder
+            that writes fields directly into it. This avoids assembling a
+            LuaTable on the C++ side first. See luatablebuilder.h.
+
+            Input:
+               Expected number of array elements (int)
+               Expected number of non-array fields (int)
+
+            Output:
+               LuaTableBuilder
+         */
+         inline LuaTableBuilder pushTableArgument(int nArray = 0, int nRecords = 0) {
+
+            nArgs++;
+            return LuaTableBuilder(L, nArray, nRecords);
+         }
+
          void pushArgument(entity::Entity *e);
 
          /*
@@ -630,6 +930,92 @@ namespace trogdor {
                (none)
          */
          void execute(int nReturnVals = 0);
+
+         /*
+            Starts the sampling profiler. Every interval Lua VM instructions, a
+            count hook records the current call stack, with each frame
+            identified by its function name, source and the line on which the
+            function was defined, so that every sample taken inside a function
+            is counted toward the same frame. The hook is installed on the main
+            thread and on every coroutine run by the scheduler. Samples
+            accumulate until resetProfiler() is called, so the profiler can be
+            stopped and started again without losing data. Like every other
+            operation, this requires the caller to hold the lock.
+
+            Profiler data isn't copied or serialized along with the state.
+            When built against LuaJIT, hooks aren't invoked from inside
+            JIT-compiled traces, so time spent in compiled code won't be
+            sampled.
+
+            Input:
+               Number of instructions between samples (int)
+
+            Output:
+               (none)
+         */
+         void startProfiler(int interval = DEFAULT_PROFILER_INTERVAL);
+
+         /*
+            Stops the sampling profiler. Samples collected so far are kept.
+
+            Input:
+               (none)
+
+            Output:
+               (none)
+         */
+         void stopProfiler();
+
+         /*
+            Discards all samples collected by the profiler.
+
+            Input:
+               (none)
+
+            Output:
+               (none)
+         */
+         inline void resetProfiler() {profilerSamples.clear();}
+
+         /*
+            Returns true if the sampling profiler is running and false if not.
+
+            Input:
+               (none)
+
+            Output:
+               bool
+         */
+         inline bool isProfiling() const {return profiling;}
+
+         /*
+            Returns the total number of samples collected by the profiler.
+
+            Input:
+               (none)
+
+            Output:
+               size_t
+         */
+         size_t getProfilerSampleCount() const;
+
+         /*
+            Writes the profiler's samples in folded stack format, which can be
+            fed directly into flamegraph.pl and compatible tools. Each line
+            contains the frames of a unique call stack, outermost first,
+            separated by semicolons, followed by a space and the number of
+            times that stack was sampled. Whitespace and semicolons inside
+            frame names are replaced with underscores. For example:
+
+            main chunk@script.lua:12;attack@combat.lua:40 17
+
+            Input:
+               Output stream (std::ostream &)
+
+            Output:
+               (none)
+         */
+         void dumpProfile(std::ostream &out) const;
    };
 }
 
@@ -2,6 +2,8 @@
 #define LUATABLE_H
 
 
+#include <string>
+#include <utility>
 #include <iterator>
 #include <unordered_map>
 
@@ -33,7 +35,21 @@ namespace trogdor {
       public:
 
          /*
-            setField() sets a value for the specified key.
+            Reserves space for the given number of fields so that building
+            large tables doesn't trigger repeated rehashing.
+
+            Input:
+               Number of fields (size_t)
+
+            Output:
+               (none)
+         */
+         inline void reserve(size_t n) {values.reserve(n);}
+
+         /*
+            setField() sets a value for the specified key. Keys and string
+            values are moved into the table rather than copied whenever the
+            caller passes in a temporary.
 
             Input:
                key (name of the field -- std::string)
@@ -41,84 +57,47 @@ namespace trogdor {
          */
          inline void setField(std::string key, const char *value) {
 
-            LuaValue v;
-            v.type = LUA_TYPE_STRING;
-            std::string s = value;
-            v.value = s;
-
-            values[key] = v;
+            values.insert_or_assign(std::move(key), LuaValue{LUA_TYPE_STRING, std::string(value)});
          }
 
          inline void setField(std::string key, std::string value) {
 
-            LuaValue v;
-            v.type = LUA_TYPE_STRING;
-            v.value = value;
-
-            values[key] = v;
+            values.insert_or_assign(std::move(key), LuaValue{LUA_TYPE_STRING, std::move(value)});
          }
 
          inline void setField(std::string key, int value) {
 
-            LuaValue v;
-            v.type = LUA_TYPE_NUMBER;
-            v.value = (double)value;
-
-            values[key] = v;
+            values.insert_or_assign(std::move(key), LuaValue{LUA_TYPE_NUMBER, static_cast<double>(value)});
          }
 
          inline void setField(std::string key, double value) {
 
-            LuaValue v;
-            v.type = LUA_TYPE_NUMBER;
-            v.value = value;
-
-            values[key] = v;
+            values.insert_or_assign(std::move(key), LuaValue{LUA_TYPE_NUMBER, value});
          }
 
          inline void setField(std::string key, bool value) {
 
-            LuaValue v;
-            v.type = LUA_TYPE_BOOLEAN;
-            v.value = value;
-
-            values[key] = v;
+            values.insert_or_assign(std::move(key), LuaValue{LUA_TYPE_BOOLEAN, value});
          }
 
          inline void setField(std::string key, LuaArray &value) {
 
-            LuaValue v;
-            v.type = LUA_TYPE_ARRAY;
-            v.value = &value;
-
-            values[key] = v;
+            values.insert_or_assign(std::move(key), LuaValue{LUA_TYPE_ARRAY, &value});
          }
 
          inline void setField(std::string key, LuaTable &value) {
 
-            LuaValue v;
-            v.type = LUA_TYPE_TABLE;
-            v.value = &value;
-
-            values[key] = v;
+            values.insert_or_assign(std::move(key), LuaValue{LUA_TYPE_TABLE, &value});
          }
 
          inline void setFieldFunction(std::string key, const char *func) {
 
-            LuaValue v;
-            v.type = LUA_TYPE_FUNCTION;
-            v.value = func;
-
-            values[key] = v;
+            values.insert_or_assign(std::move(key), LuaValue{LUA_TYPE_FUNCTION, std::string(func)});
          }
 
          inline void setFieldFunction(std::string key, std::string func) {
 
-            LuaValue v;
-            v.type = LUA_TYPE_FUNCTION;
-            v.value = func;
-
-            values[key] = v;
+            values.insert_or_assign(std::move(key), LuaValue{LUA_TYPE_FUNCTION, std::move(func)});
          }
 
          /*
@@ -0,0 +1,171 @@
+#ifndef LUATABLEBUILDER_H
+#define LUATABLEBUILDER_H
+
+
+#include <string>
+
+extern "C" {
+   #include <lua.h>
+}
+
+#include <trogdor/lua/luatype.h>
+
+
+namespace trogdor {
+
+
+   class LuaTable;
+
+   namespace entity {
+      class Entity;
+   }
+
+   /*
+      LuaTableBuilder writes values directly into a table that lives on the Lua
+      stack. Unlike LuaTable and LuaArray, which are assembled on the C++ side
+      and then copied into Lua by LuaState::pushTable() and
+      LuaState::pushArray(), nothing is duplicated along the way, and the table
+      can be pre-sized if the number of fields is known in advance. This makes
+      it the better choice for large payloads like inventory listings. A
+      typical workflow might look something like this:
+
+      L.call("onInventory");
+
+      LuaTableBuilder args = L.pushTableArgument(0, 2);
+      args.setField("owner", player);
+
+      LuaTableBuilder items = args.beginTable("items", numItems);
+
+      for (const auto &item: inventory) {
+         items.append(item->getName());
+      }
+
+      items.end();
+      L.execute();
+
+      Values are always written to the table at the top of the stack, so a
+      nested table must be ended before any more values are written to its
+      parent.
+   */
+   class LuaTableBuilder {
+
+      private:
+
+         // Lua state the table lives in
+         lua_State *L;
+
+         // Index that append() will write to next
+         lua_Integer nextIndex;
+
+         // If this is a nested table, end() stores it in its parent under
+         // either parentIndex or (if parentIndex is 0) parentKey
+         bool nested;
+         std::string parentKey;
+         lua_Integer parentIndex;
+
+         /*
+            Constructor for nested tables (see beginTable() and appendTable().)
+         */
+         LuaTableBuilder(
+            lua_State *L,
+            int nArray,
+            int nRecords,
+            std::string key,
+            lua_Integer index
+         );
+
+         /*
+            Pops the value at the top of the stack into the table, either
+            under the given key or (if key is nullptr) at the next array index.
+
+            Input:
+               Key (const char * or nullptr)
+
+            Output:
+               (none)
+         */
+         void store(const char *key);
+
+      public:
+
+         /*
+            Creates a new table at the top of the stack. The table remains on
+            the stack after the builder is done with it. nArray and nRecords
+            are hints for how many array elements and non-array fields the
+            table will contain.
+         */
+         LuaTableBuilder() = delete;
+         LuaTableBuilder(lua_State *L, int nArray = 0, int nRecords = 0);
+
+         /*
+            Sets a field on the table.
+
+            Input:
+               Key (const char *)
+               Value (varied type)
+
+            Output:
+               (none)
+         */
+         void setField(const char *key, const char *value);
+         void setField(const char *key, const std::string &value);
+         void setField(const char *key, double value);
+         void setField(const char *key, int value);
+         void setField(const char *key, size_t value);
+         void setField(const char *key, bool value);
+         void setField(const char *key, entity::Entity *value);
+         void setField(const char *key, const LuaArray &value);
+         void setField(const char *key, const LuaTable &value);
+
+         /*
+            Appends a value to the table's array part.
+
+            Input:
+               Value (varied type)
+
+            Output:
+               (none)
+         */
+         void append(const char *value);
+         void append(const std::string &value);
+         void append(double value);
+         void append(int value);
+         void append(size_t value);
+         void append(bool value);
+         void append(entity::Entity *value);
+         void append(const LuaArray &value);
+         void append(const LuaTable &value);
+
+         /*
+            Starts a nested table that will be stored under the given key (or,
+            in the case of appendTable(), at the next array index) once end()
+            is called on it.
+
+            Input:
+               Key (const char *, beginTable() only)
+               Expected number of array elements (int)
+               Expected number of non-array fields (int)
+
+            Output:
+               Builder for the nested table (LuaTableBuilder)
+         */
+         LuaTableBuilder beginTable(const char *key, int nArray = 0, int nRecords = 0);
+         LuaTableBuilder appendTable(int nArray = 0, int nRecords = 0);
+
+         /*
+            Finishes a nested table by moving it from the top of the stack into
+            its parent. Does nothing for a top-level table, which stays on the
+            stack.
+
+            Input:
+               (none)
+
+            Output:
+               (none)
+         */
+         void end();
+   };
+}
+
+
+#endif
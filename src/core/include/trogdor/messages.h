@@ -3,8 +3,11 @@
 
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
+#include <trogdor/stringpool.h>
+
 
 namespace trogdor {
 
@@ -12,8 +15,9 @@ namespace trogdor {
 
       private:
 
-         // Hash table mapping message names to messages
-         std::unordered_map<std::string, std::string> messageTable;
+         // Hash table mapping message names to messages. Messages are pooled,
+         // since the same ones tend to be set on many Entities.
+         std::unordered_map<std::string, PooledString> messageTable;
 
       public:
 
@@ -39,13 +43,13 @@ namespace trogdor {
 
          /*
             Returns constant iterators to the internal message table (this
-            won't work with for-range loops.)
+            won't work with for-range loops.) Each message is a PooledString.
 
             Input: (none)
             Output: Constant iterator
          */
-         inline auto cbegin() {return messageTable.cbegin();}
-         inline auto cend() {return messageTable.cend();}
+         inline auto cbegin() const {return messageTable.cbegin();}
+         inline auto cend() const {return messageTable.cend();}
 
          /*
             Clears all messages.
@@ -57,21 +61,22 @@ namespace trogdor {
 
          /*
             Gets a message by name.  If it doesn't exist, an empty string is
-            returned.
+            returned. The view remains valid until the message is next set or
+            the table is cleared.
 
             Input: string & (name)
-            Output: string (message)
+            Output: string_view (message)
          */
-         std::string get(const std::string &name) const;
+         std::string_view get(const std::string &name) const;
 
          /*
             Sets a message.  If the message already exists, it will be
             overwritten.
 
-            Input: string (message name), string (message)
+            Input: string (message name), string_view (message)
             Output: (none)
          */
-         void set(std::string name, std::string message);
+         void set(std::string name, std::string_view message);
 
          /*
             Displays a message.  If it doesn't exist, nothing is displayed.
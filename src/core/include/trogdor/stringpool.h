@@ -0,0 +1,154 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+
+namespace trogdor {
+
+
+   class StringPool;
+
+   /*
+      An immutable, reference-counted handle to a string stored in the
+      process-wide StringPool. Every PooledString with the same contents
+      points to the same copy of that string, so storing the same message
+      or description in many Entities only stores it once, and copying a
+      PooledString never copies the text. When the last handle to a string
+      is destroyed, the string is removed from the pool.
+
+      A default constructed PooledString is empty and doesn't touch the pool.
+   */
+   class PooledString {
+
+      private:
+
+         std::shared_ptr<const std::string> value;
+
+         inline explicit PooledString(std::shared_ptr<const std::string> v): value(std::move(v)) {}
+
+         friend class StringPool;
+
+      public:
+
+         /*
+            Constructors. Constructing a PooledString from text interns it in
+            the process-wide pool (see StringPool::intern().)
+         */
+         PooledString() = default;
+         PooledString(std::string_view text);
+
+         /*
+            Returns the string.
+
+            Input:
+               (none)
+
+            Output:
+               const std::string & (valid for as long as this handle is)
+         */
+         inline const std::string &str() const {
+
+            static const std::string empty;
+            return value ? *value : empty;
+         }
+
+         /*
+            Returns a view of the string.
+
+            Input:
+               (none)
+
+            Output:
+               std::string_view (valid for as long as this handle is)
+         */
+         inline std::string_view view() const {return value ? std::string_view(*value) : std::string_view();}
+         inline operator std::string_view() const {return view();}
+
+         inline bool empty() const {return !value || value->empty();}
+         inline size_t length() const {return value ? value->length() : 0;}
+
+         /*
+            Since equal strings are pooled together, two handles are equal if
+            and only if they point to the same string.
+         */
+         inline bool operator==(const PooledString &rhs) const {
+
+            return value == rhs.value || (empty() && rhs.empty());
+         }
+
+         inline bool operator!=(const PooledString &rhs) const {return !(*this == rhs);}
+   };
+
+   /*
+      Deduplicates immutable strings (messages, descriptions, etc.) that are
+      likely to be repeated across many Entities. There's one pool per
+      process, shared by every Game, and it's safe to use from multiple
+      threads. Strings are only stored for as long as at least one
+      PooledString refers to them.
+   */
+   class StringPool {
+
+      private:
+
+         mutable std::mutex mutex;
+
+         // Each key is a view of the string its value points to
+         std::unordered_map<std::string_view, std::weak_ptr<const std::string>> strings;
+
+         // Removes a string from the pool once its last handle is gone
+         void release(const std::string *string);
+
+         StringPool() = default;
+
+      public:
+
+         StringPool(const StringPool &) = delete;
+         StringPool &operator=(const StringPool &) = delete;
+
+         /*
+            Returns the process-wide pool. It's never destroyed, so that
+            PooledStrings owned by static objects can outlive everything else.
+
+            Input:
+               (none)
+
+            Output:
+               StringPool &
+         */
+         static StringPool &get();
+
+         /*
+            Returns a handle to the pooled copy of a string, adding it to the
+            pool if it isn't already there.
+
+            Input:
+               String (std::string_view)
+
+            Output:
+               PooledString
+         */
+         PooledString intern(std::string_view text);
+
+         /*
+            Returns the number of distinct strings in the pool and the number
+            of bytes they take up (not counting the pool's own overhead.)
+
+            Input:
+               (none)
+
+            Output:
+               size_t
+         */
+         size_t size() const;
+         size_t bytes() const;
+   };
+}
+
+
+#endif
@@ -2,7 +2,6 @@
 #define TOKENIZER_H
 
 #include <string>
-#include <regex>
 #include <vector>
 
 namespace trogdor {
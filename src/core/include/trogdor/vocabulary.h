@@ -3,7 +3,9 @@
 
 
 #include <string>
+#include <vector>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -23,6 +25,14 @@ namespace trogdor {
          // Built-in directions
          std::unordered_set<std::string> directions;
 
+         // Each direction is also assigned a small integer ID, which is its
+         // index in this vector, so that Rooms can store their connections
+         // in an array rather than a hash table
+         std::vector<std::string> directionNames;
+
+         // Maps directions to their IDs
+         std::unordered_map<std::string, size_t> directionIds;
+
          // Words that we ignore during parsing
          std::unordered_set<std::string> fillerWords;
 
@@ -61,6 +71,18 @@ namespace trogdor {
          */
          void initBuiltinDirections();
 
+         /*
+            Adds a direction and assigns it the next available ID if it
+            doesn't already exist.
+
+            Input:
+               Direction (std::string)
+
+            Output:
+               (none)
+         */
+         void addDirection(std::string dir);
+
          /*
             Setup prepositions that the engine recognizes by default.
 
@@ -160,7 +182,7 @@ namespace trogdor {
          */
          inline void insertDirection(std::string dir) {
 
-            directions.insert(dir);
+            addDirection(dir);
             insertVerbSynonym(dir, "move");
          }
 
@@ -211,6 +233,61 @@ namespace trogdor {
             }
          }
 
+         /*
+            Returns the ID of the direction referenced either by its name or by
+            one of its synonyms. IDs are assigned in the order directions are
+            inserted and never change for the lifetime of the Vocabulary.
+
+            Input:
+               Direction or Direction synonym (const std::string &)
+
+            Output:
+               Direction ID if one exists or std::nullopt if not (std::optional<size_t>)
+         */
+         inline std::optional<size_t> getDirectionId(const std::string &dirOrSyn) const {
+
+            auto id = directionIds.find(dirOrSyn);
+
+            if (directionIds.end() != id) {
+               return id->second;
+            }
+
+            auto synonym = directionSynonyms.find(dirOrSyn);
+
+            if (directionSynonyms.end() != synonym) {
+               return directionIds.find(synonym->second)->second;
+            }
+
+            return std::nullopt;
+         }
+
+         /*
+            Returns the name of the direction with the specified ID. Throws an
+            instance of std::out_of_range if the ID doesn't exist.
+
+            Input:
+               Direction ID (size_t)
+
+            Output:
+               Direction (const std::string &)
+         */
+         inline const std::string &getDirectionName(size_t id) const {
+
+            return directionNames.at(id);
+         }
+
+         /*
+            Returns the number of directions, which is also one more than the
+            largest direction ID.
+
+            Input:
+               (none)
+
+            Output:
+               size_t
+         */
+         inline size_t getNumDirections() const {return directionNames.size();}
+
          /*
             Returns true if the specified word is a filler word and false if
             it's not.
@@ -910,6 +910,20 @@ namespace trogdor {
       // considers moving
       entityPropValidators["creature"]["wandering.wanderlust"] = assertProbability;
 
+      // How a Creature chooses which Room to wander into (random, pursue, or
+      // flee)
+      entityPropValidators["creature"]["wandering.mode"] = [](const Vocabulary &vocabulary,
+      std::string value) {
+
+         if (
+            0 != value.compare("random") &&
+            0 != value.compare("pursue") &&
+            0 != value.compare("flee")
+         ) {
+            throw ValidationException("wandering mode should be one of 'random', 'pursue', or 'flee.'");
+         }
+      };
+
       // An Object's weight
       entityPropValidators["object"]["weight"] = assertInt;
 
@@ -40,14 +40,14 @@ namespace trogdor {
 
       // For each creature, check if wandering was enabled, and if so, insert a
       // timer job for it
-      for (auto &creature: game->getCreatures()) {
+      for (const auto &creature: game->getCreatures()) {
 
-         if (creature.second->getProperty<bool>(entity::Creature::WanderEnabledProperty)) {
+         if (creature.second->getProperty<bool>(entity::PROPERTY_SLOT_WANDER_ENABLED)) {
             game->insertTimerJob(std::make_shared<WanderTimerJob>(
                game,
-               creature.second->getProperty<int>(entity::Creature::WanderIntervalProperty),
+               creature.second->getProperty<int>(entity::PROPERTY_SLOT_WANDER_INTERVAL),
                -1,
-               creature.second->getProperty<int>(entity::Creature::WanderIntervalProperty),
+               creature.second->getProperty<int>(entity::PROPERTY_SLOT_WANDER_INTERVAL),
                creature.second.get())
             );
          }
@@ -117,7 +117,7 @@ namespace trogdor {
                   0 == className.compare("") ||
                   0 == className.compare(Entity::typeToStr(entity::ENTITY_RESOURCE))
                ) {
-                  entity = std::make_shared<entity::Resource>(
+                  entity = game->makeEntity<entity::Resource>(
                      game,
                      entityName,
                      std::nullopt,
@@ -129,8 +129,8 @@ namespace trogdor {
 
                // Entity has a class, so copy the class's prototype
                else {
-                  entity = std::make_shared<entity::Resource>(
-                     *(dynamic_cast<entity::Resource *>(typeClasses[className].get())),
+                  entity = game->makeEntity<entity::Resource>(
+                     *(dynamic_cast<entity::Resource *>(game->getEntityClass(className).get())),
                      entityName,
                      plural
                   );
@@ -145,15 +145,15 @@ namespace trogdor {
                   0 == className.compare("") ||
                   0 == className.compare(Entity::typeToStr(entity::ENTITY_ROOM))
                ) {
-                  entity = std::make_shared<entity::Room>(
+                  entity = game->makeEntity<entity::Room>(
                      game, entityName, std::make_unique<PlaceOut>(), game->err().copy()
                  );
                }
 
                // Entity has a class, so copy the class's prototype
                else {
-                  entity = std::make_shared<entity::Room>(
-                     *(dynamic_cast<entity::Room *>(typeClasses[className].get())),
+                  entity = game->makeEntity<entity::Room>(
+                     *(dynamic_cast<entity::Room *>(game->getEntityClass(className).get())),
                      entityName
                   );
                }
@@ -166,14 +166,14 @@ namespace trogdor {
                   0 == className.compare("") ||
                   0 == className.compare(Entity::typeToStr(entity::ENTITY_OBJECT))
                ) {
-                  entity = std::make_shared<entity::Object>(
+                  entity = game->makeEntity<entity::Object>(
                      game, entityName, std::make_unique<NullOut>(), game->err().copy()
                   );
                }
 
                else {
-                  entity = std::make_shared<entity::Object>(
-                     *(dynamic_cast<entity::Object *>(typeClasses[className].get())),
+                  entity = game->makeEntity<entity::Object>(
+                     *(dynamic_cast<entity::Object *>(game->getEntityClass(className).get())),
                      entityName
                   );
                }
@@ -187,14 +187,14 @@ namespace trogdor {
                   0 == className.compare(Entity::typeToStr(entity::ENTITY_CREATURE))
                ) {
                   // TODO: should Creatures have some kind of special input stream?
-                  entity = std::make_shared<entity::Creature>(
+                  entity = game->makeEntity<entity::Creature>(
                      game, entityName, std::make_unique<NullOut>(), game->err().copy()
                   );
                }
 
                else {
-                  entity = std::make_shared<entity::Creature>(
-                     *(dynamic_cast<entity::Creature *>(typeClasses[className].get())),
+                  entity = game->makeEntity<entity::Creature>(
+                     *(dynamic_cast<entity::Creature *>(game->getEntityClass(className).get())),
                      entityName
                   );
                }
@@ -261,7 +261,7 @@ namespace trogdor {
          entity->setClass(className);
          entity->setProperty("title", className);
 
-         typeClasses[className] = std::move(entity);
+         game->insertEntityClass(className, std::move(entity));
       });
 
       /**********/
@@ -280,7 +280,7 @@ namespace trogdor {
          }
 
          else if (0 == targetType.compare("class")) {
-            typeClasses[operation->getChildren()[3]->getValue()]->setMessage(messageName, message);
+            game->getEntityClass(operation->getChildren()[3]->getValue())->setMessage(messageName, message);
          }
 
          else {
@@ -303,7 +303,7 @@ namespace trogdor {
          }
 
          else if (0 == targetType.compare("class")) {
-            typeClasses[operation->getChildren()[2]->getValue()]->setTag(tag);
+            game->getEntityClass(operation->getChildren()[2]->getValue())->setTag(tag);
          }
 
          else {
@@ -326,7 +326,7 @@ namespace trogdor {
          }
 
          else if (0 == targetType.compare("class")) {
-            typeClasses[operation->getChildren()[2]->getValue()]->removeTag(tag);
+            game->getEntityClass(operation->getChildren()[2]->getValue())->removeTag(tag);
          }
 
          else {
@@ -373,7 +373,7 @@ namespace trogdor {
 
          else if (0 == targetType.compare("class")) {
 
-            entity::Entity *entityClass = typeClasses[operation->getChildren()[3]->getValue()].get();
+            entity::Entity *entityClass = game->getEntityClass(operation->getChildren()[3]->getValue()).get();
 
             // TODO: the problem here is that, once we instantiate an entity
             // based on the class, we have to update the lua state so that the
@@ -416,7 +416,7 @@ namespace trogdor {
          }
 
          else {
-            thing = typeClasses[operation->getChildren()[2]->getValue()].get();
+            thing = game->getEntityClass(operation->getChildren()[2]->getValue()).get();
          }
 
          if (thing) {
@@ -442,7 +442,7 @@ namespace trogdor {
          }
 
          else if (0 == targetType.compare("class")) {
-            typeClasses[operation->getChildren()[3]->getValue()]->setMeta(
+            game->getEntityClass(operation->getChildren()[3]->getValue())->setMeta(
                metaKey, metaValue
             );
          }
@@ -470,7 +470,7 @@ namespace trogdor {
          }
 
          else if (0 == targetType.compare("class")) {
-            being = typeClasses[operation->getChildren()[3]->getValue()].get();
+            being = game->getEntityClass(operation->getChildren()[3]->getValue()).get();
          }
 
          else {
@@ -504,7 +504,7 @@ namespace trogdor {
          }
 
          else if (0 == targetType.compare("class")) {
-            entity = typeClasses[operation->getChildren()[3]->getValue()].get();
+            entity = game->getEntityClass(operation->getChildren()[3]->getValue()).get();
             propSetters[entity->getTypeName()][property](game, entity, value);
          }
 
@@ -559,7 +559,7 @@ namespace trogdor {
          }
 
          else {
-            room = dynamic_cast<Room *>(typeClasses[sourceRoomOrClass].get());
+            room = dynamic_cast<Room *>(game->getEntityClass(sourceRoomOrClass).get());
          }
 
          if (5 == operation->size()) {
@@ -711,7 +711,7 @@ namespace trogdor {
       propSetters["player"]["health"] = [](Game *game, entity::Entity *being,
       std::string value) {
          dynamic_cast<entity::Being *>(being)->setProperty(
-            entity::Being::HealthProperty,
+            entity::PROPERTY_SLOT_HEALTH,
             stoi(value)
          );
       };
@@ -723,7 +723,7 @@ namespace trogdor {
       propSetters["player"]["maxhealth"] = [](Game *game, entity::Entity *being,
       std::string value) {
          dynamic_cast<entity::Being *>(being)->setProperty(
-            entity::Being::MaxHealthProperty,
+            entity::PROPERTY_SLOT_MAX_HEALTH,
             stoi(value)
          );
       };
@@ -735,7 +735,7 @@ namespace trogdor {
       propSetters["player"]["woundrate"] = [](Game *game, entity::Entity *being,
       std::string value) {
          dynamic_cast<entity::Being *>(being)->setProperty(
-            entity::Being::WoundRateProperty,
+            entity::PROPERTY_SLOT_WOUND_RATE,
             stod(value)
          );
       };
@@ -748,7 +748,7 @@ namespace trogdor {
       propSetters["player"]["damagebarehands"] = [](Game *game, entity::Entity *being,
       std::string value) {
          dynamic_cast<entity::Being *>(being)->setProperty(
-            entity::Being::DamageBareHandsProperty,
+            entity::PROPERTY_SLOT_DAMAGE_BARE_HANDS,
             stoi(value)
          );
       };
@@ -760,7 +760,7 @@ namespace trogdor {
       propSetters["player"]["respawn.enabled"] = [](Game *game, entity::Entity *being,
       std::string value) {
          dynamic_cast<entity::Being *>(being)->setProperty(
-            entity::Being::RespawnEnabledProperty,
+            entity::PROPERTY_SLOT_RESPAWN_ENABLED,
             static_cast<bool>(stoi(value))
          );
       };
@@ -772,7 +772,7 @@ namespace trogdor {
       propSetters["player"]["respawn.interval"] = [](Game *game, entity::Entity *being,
       std::string value) {
          dynamic_cast<entity::Being *>(being)->setProperty(
-            entity::Being::RespawnIntervalProperty,
+            entity::PROPERTY_SLOT_RESPAWN_INTERVAL,
             stoi(value)
          );
       };
@@ -784,7 +784,7 @@ namespace trogdor {
       propSetters["player"]["respawn.lives"] = [](Game *game, entity::Entity *being,
       std::string value) {
          dynamic_cast<entity::Being *>(being)->setProperty(
-            entity::Being::RespawnLivesProperty,
+            entity::PROPERTY_SLOT_RESPAWN_LIVES,
             stoi(value)
          );
       };
@@ -796,7 +796,7 @@ namespace trogdor {
       propSetters["player"]["inventory.weight"] = [](Game *game, entity::Entity *being,
       std::string value) {
          dynamic_cast<entity::Being *>(being)->setProperty(
-            entity::Being::InvMaxWeightProperty,
+            entity::PROPERTY_SLOT_INV_MAX_WEIGHT,
             stoi(value)
          );
       };
@@ -807,7 +807,7 @@ namespace trogdor {
       propSetters["creature"]["counterattack"] = [](Game *game, entity::Entity *creature,
       std::string value) {
          dynamic_cast<entity::Creature *>(creature)->setProperty(
-            entity::Creature::CounterAttackProperty,
+            entity::PROPERTY_SLOT_COUNTER_ATTACK,
             static_cast<bool>(stoi(value))
          );
       };
@@ -828,19 +828,19 @@ namespace trogdor {
          // By default, Creatures with neutral or enemy allegiances will
          // automatically retaliate when attacked
          switch (dynamic_cast<entity::Creature *>(creature)->getProperty<int>(
-            entity::Creature::AllegianceProperty)
+            entity::PROPERTY_SLOT_ALLEGIANCE)
          ) {
 
             case entity::Creature::FRIEND:
                dynamic_cast<entity::Creature *>(creature)->setProperty(
-                  entity::Creature::CounterAttackProperty,
+                  entity::PROPERTY_SLOT_COUNTER_ATTACK,
                   false
                );
                break;
 
             default:
                dynamic_cast<entity::Creature *>(creature)->setProperty(
-                  entity::Creature::CounterAttackProperty,
+                  entity::PROPERTY_SLOT_COUNTER_ATTACK,
                   true
                );
                break;
@@ -872,7 +872,7 @@ namespace trogdor {
          }
 
          dynamic_cast<entity::Creature *>(creature)->setProperty(
-            entity::Creature::AllegianceProperty,
+            entity::PROPERTY_SLOT_ALLEGIANCE,
             static_cast<entity::Creature::AllegianceType>(allegiance)
          );
       };
@@ -883,7 +883,7 @@ namespace trogdor {
       propSetters["creature"]["autoattack.enabled"] = [](Game *game, entity::Entity *creature,
       std::string value) {
          dynamic_cast<entity::Creature *>(creature)->setProperty(
-            entity::Creature::AutoAttackEnabledProperty,
+            entity::PROPERTY_SLOT_AUTOATTACK_ENABLED,
             static_cast<bool>(stoi(value))
          );
       };
@@ -894,7 +894,7 @@ namespace trogdor {
       propSetters["creature"]["autoattack.repeat"] = [](Game *game, entity::Entity *creature,
       std::string value) {
          dynamic_cast<entity::Creature *>(creature)->setProperty(
-            entity::Creature::AutoAttackRepeatProperty,
+            entity::PROPERTY_SLOT_AUTOATTACK_REPEAT,
             static_cast<bool>(stoi(value))
          );
       };
@@ -906,7 +906,7 @@ namespace trogdor {
       propSetters["creature"]["autoattack.interval"] = [](Game *game, entity::Entity *creature,
       std::string value) {
          dynamic_cast<entity::Creature *>(creature)->setProperty(
-            entity::Creature::AutoAttackIntervalProperty,
+            entity::PROPERTY_SLOT_AUTOATTACK_INTERVAL,
             stoi(value)
          );
       };
@@ -917,7 +917,7 @@ namespace trogdor {
       propSetters["creature"]["wandering.enabled"] = [](Game *game, entity::Entity *creature,
       std::string value) {
          dynamic_cast<entity::Creature *>(creature)->setProperty(
-            entity::Creature::WanderEnabledProperty,
+            entity::PROPERTY_SLOT_WANDER_ENABLED,
             static_cast<bool>(stoi(value))
          );
       };
@@ -929,7 +929,7 @@ namespace trogdor {
       std::string value) {
 
          int status = dynamic_cast<entity::Creature *>(creature)->setProperty(
-            entity::Creature::WanderIntervalProperty,
+            entity::PROPERTY_SLOT_WANDER_INTERVAL,
             stoi(value)
          );
 
@@ -950,7 +950,7 @@ namespace trogdor {
       std::string value) {
 
          int status = dynamic_cast<entity::Creature *>(creature)->setProperty(
-            entity::Creature::WanderLustProperty,
+            entity::PROPERTY_SLOT_WANDER_LUST,
             stod(value)
          );
 
@@ -965,11 +965,41 @@ namespace trogdor {
 
       /**********/
 
+      // How a Creature chooses which Room to wander into
+      propSetters["creature"]["wandering.mode"] = [](Game *game, entity::Entity *creature,
+      std::string value) {
+
+         entity::Creature::WanderMode mode = entity::Creature::DEFAULT_WANDER_MODE;
+
+         if (0 == value.compare("random")) {
+            mode = entity::Creature::WANDER_RANDOM;
+         }
+
+         else if (0 == value.compare("pursue")) {
+            mode = entity::Creature::WANDER_PURSUE;
+         }
+
+         else if (0 == value.compare("flee")) {
+            mode = entity::Creature::WANDER_FLEE;
+         }
+
+         else {
+            throw ValidationException("wandering mode must be 'random', 'pursue' or 'flee'");
+         }
+
+         dynamic_cast<entity::Creature *>(creature)->setProperty(
+            entity::PROPERTY_SLOT_WANDER_MODE,
+            static_cast<int>(mode)
+         );
+      };
+
+      /**********/
+
       // Set Object's weight
       propSetters["object"]["weight"] = [](Game *game, entity::Entity *object,
       std::string value) {
          dynamic_cast<entity::Object *>(object)->setProperty(
-            entity::Object::WeightProperty,
+            entity::PROPERTY_SLOT_WEIGHT,
             stoi(value)
          );
       };
@@ -980,7 +1010,7 @@ namespace trogdor {
       propSetters["object"]["damage"] = [](Game *game, entity::Entity *object,
       std::string value) {
          dynamic_cast<entity::Object *>(object)->setProperty(
-            entity::Object::DamageProperty,
+            entity::PROPERTY_SLOT_DAMAGE,
             stoi(value)
          );
       };
@@ -991,7 +1021,7 @@ namespace trogdor {
       std::string value) {
 
          if (Entity::PROPERTY_VALID != dynamic_cast<entity::Resource *>(resource)->setProperty(
-            entity::Resource::AmtAvailProperty,
+            entity::PROPERTY_SLOT_AMT_AVAIL,
             stod(value)
          )) {
             throw ValidationException(
@@ -1007,7 +1037,7 @@ namespace trogdor {
       std::string value) {
 
          dynamic_cast<entity::Resource *>(resource)->setProperty(
-            entity::Resource::ReqIntAllocProperty,
+            entity::PROPERTY_SLOT_REQ_INT_ALLOC,
             static_cast<bool>(stoi(value))
          );
       };
@@ -1018,7 +1048,7 @@ namespace trogdor {
       std::string value) {
 
          dynamic_cast<entity::Resource *>(resource)->setProperty(
-            entity::Resource::MaxAmtPerDepositorProperty,
+            entity::PROPERTY_SLOT_MAX_AMT_PER_DEPOSITOR,
             stod(value)
          );
       };
@@ -1029,7 +1059,7 @@ namespace trogdor {
       std::string value) {
 
          dynamic_cast<entity::Resource *>(resource)->setProperty(
-            entity::Resource::PluralTitleProperty,
+            entity::PROPERTY_SLOT_PLURAL_TITLE,
             value
          );
       };
@@ -262,6 +262,10 @@ namespace trogdor {
       regexReplacements.push_back(RegexReplacement({"([aeiou])y$", "$1ys"}));
       regexReplacements.push_back(RegexReplacement({"([^aeiou])y$", "$1ies"}));
       regexReplacements.push_back(RegexReplacement({"([^aeiou])o$", "$1oes"}));
+
+      for (auto &rule: regexReplacements) {
+         rule.compiled = regex(rule.regex);
+      }
    }
 
    /**************************************************************************/
@@ -279,10 +283,8 @@ namespace trogdor {
       for (auto transform = regexReplacements.begin();
       regexReplacements.end() != transform; transform++) {
 
-         regex r(transform->regex);
-
-         if (regex_search(noun, r)) {
-            return regex_replace(noun, r, transform->replacement);
+         if (regex_search(noun, transform->compiled)) {
+            return regex_replace(noun, transform->compiled, transform->replacement);
          }
       }
 
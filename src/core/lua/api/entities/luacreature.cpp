@@ -95,7 +95,9 @@ namespace trogdor::entity {
       Game *g = LuaGame::checkGame(L, -1);
 
       // Creature does not exist in the game unless it's manually inserted
-      Creature *c = new Creature(nullptr, name, std::make_unique<NullOut>(), g->err().copy());
+      Creature *c = LuaState::getInstance(L)->getEntityPool()->create<Creature>(
+         nullptr, name, std::make_unique<NullOut>(), g->err().copy()
+      );
       c->setManagedByLua(true);
 
       // TODO: replace if necessary with actual class name once I support that
@@ -119,7 +121,7 @@ namespace trogdor::entity {
       std::string name = luaL_checkstring(L, -1);
 
       // Creature will not exist in the game unless it's manually inserted
-      Creature *c = new Creature(*prototype, name);
+      Creature *c = LuaState::getInstance(L)->getEntityPool()->create<Creature>(*prototype, name);
       c->setManagedByLua(true);
 
       LuaState::pushEntity(L, c);
@@ -60,6 +60,7 @@ namespace trogdor::entity {
       {"setLongDesc",  LuaEntity::setLongDesc},
       {"getShortDesc", LuaEntity::getShortDesc},
       {"setShortDesc", LuaEntity::setShortDesc},
+      {"getProperties", LuaEntity::getProperties},
       {"__tostring",   LuaEntity::getName},
       {"__gc",         LuaEntity::gcEntity},
       {0, 0}
@@ -67,6 +68,64 @@ namespace trogdor::entity {
 
    /***************************************************************************/
 
+   // Returns the string held by a property value, whether it's one that was
+   // passed around (PropertyValue) or the form it's stored in
+   // (StoredPropertyValue)
+   static inline const std::string &getPropertyString(const Entity::PropertyValue &value) {
+
+      return std::get<std::string>(value);
+   }
+
+   static inline const std::string &getPropertyString(const Entity::StoredPropertyValue &value) {
+
+      return std::get<PooledString>(value).str();
+   }
+
+   /***************************************************************************/
+
+   // Pushes a property value onto the Lua stack as the closest native Lua type
+   template <typename Value>
+   static void pushPropertyValue(lua_State *L, const Value &value) {
+
+      switch (value.index()) {
+
+         case 0: // size_t
+
+            // Lua 5.3 introduced an integer type
+            #if LUA_VERSION_NUM > 502
+               lua_pushinteger(L, std::get<size_t>(value));
+            #else
+               lua_pushnumber(L, std::get<size_t>(value));
+            #endif
+
+            break;
+
+         case 1: // int
+
+            #if LUA_VERSION_NUM > 502
+               lua_pushinteger(L, std::get<int>(value));
+            #else
+               lua_pushnumber(L, std::get<int>(value));
+            #endif
+
+            break;
+
+         case 2: // double
+            lua_pushnumber(L, std::get<double>(value));
+            break;
+
+         case 3: // bool
+            lua_pushboolean(L, std::get<bool>(value));
+            break;
+
+         default: // std::string
+            lua_pushstring(L, getPropertyString(value).c_str());
+            break;
+      }
+   }
+
+   /***************************************************************************/
+
    const luaL_Reg *LuaEntity::getFunctions() {
 
       return functions;
@@ -108,33 +167,11 @@ namespace trogdor::entity {
       Entity *e = checkEntity(L, -1);
 
       // Entity has not been assigned to a Game, so its allocation is managed
-      // solely by Lua and should be garbage collected.
+      // solely by Lua and should be garbage collected. Entities created by
+      // Lua are allocated from the LuaState's pool, so that's where they go
+      // back to.
       if (e->isManagedByLua()) {
-
-         // Make sure to call the appropriate destructor
-         switch (e->getType()) {
-
-            case ENTITY_ROOM:
-               delete static_cast<Room *>(e);
-               break;
-
-            case ENTITY_OBJECT:
-               delete static_cast<Object *>(e);
-               break;
-
-            case ENTITY_PLAYER:
-               delete static_cast<Player *>(e);
-               break;
-
-            case ENTITY_CREATURE:
-               delete static_cast<Creature *>(e);
-               break;
-
-            // TODO: we shouldn't ever get here, but if we do, should I display
-            // some kind of warning? I don't think it should be a fatal error.
-            default:
-               break;
-         }
+         LuaState::getInstance(L)->getEntityPool()->destroy(e);
       }
 
       return 0;
@@ -350,7 +387,9 @@ namespace trogdor::entity {
          return luaL_error(L, "not an Entity!");
       }
 
-      lua_pushstring(L, e->getMessage(luaL_checkstring(L, -1)).c_str());
+      std::string_view message = e->getMessage(luaL_checkstring(L, -1));
+
+      lua_pushlstring(L, message.data(), message.length());
       return 1;
    }
 
@@ -453,7 +492,7 @@ namespace trogdor::entity {
          return luaL_error(L, "not an Entity!");
       }
 
-      lua_pushstring(L, e->getProperty<std::string>(Entity::TitleProperty).c_str());
+      lua_pushstring(L, e->getProperty<std::string>(PROPERTY_SLOT_TITLE).c_str());
       return 1;
    }
 
@@ -499,8 +538,8 @@ namespace trogdor::entity {
 
       lua_pushstring(
          L,
-         e->isPropertySet(Entity::LongDescProperty) ?
-            e->getProperty<std::string>(Entity::LongDescProperty).c_str() : ""
+         e->isPropertySet(PROPERTY_SLOT_LONG_DESC) ?
+            e->getProperty<std::string>(PROPERTY_SLOT_LONG_DESC).c_str() : ""
       );
 
       return 1;
@@ -548,8 +587,8 @@ namespace trogdor::entity {
 
       lua_pushstring(
          L,
-         e->isPropertySet(Entity::ShortDescProperty) ?
-            e->getProperty<std::string>(Entity::ShortDescProperty).c_str() : ""
+         e->isPropertySet(PROPERTY_SLOT_SHORT_DESC) ?
+            e->getProperty<std::string>(PROPERTY_SLOT_SHORT_DESC).c_str() : ""
       );
 
       return 1;
@@ -577,4 +616,64 @@ namespace trogdor::entity {
 
       return 0;
    }
+
+   /***************************************************************************/
+
+   int LuaEntity::getProperties(lua_State *L) {
+
+      int n = lua_gettop(L);
+
+      if (n < 1 || n > 2) {
+         return luaL_error(L, "takes at most one argument, an array of property names");
+      }
+
+      Entity *e = checkEntity(L, 1);
+
+      if (nullptr == e) {
+         return luaL_error(L, "not an Entity!");
+      }
+
+      if (1 == n) {
+
+         lua_createtable(L, 0, static_cast<int>(e->getPropertyCount()));
+
+         e->forEachProperty([&](const std::string &key, const Entity::PropertyValue &value) {
+            pushPropertyValue(L, value);
+            lua_setfield(L, -2, key.c_str());
+         });
+
+         return 1;
+      }
+
+      luaL_checktype(L, 2, LUA_TTABLE);
+
+      #if LUA_VERSION_NUM > 501
+         int nKeys = static_cast<int>(lua_rawlen(L, 2));
+      #else
+         int nKeys = static_cast<int>(lua_objlen(L, 2));
+      #endif
+
+      lua_createtable(L, 0, nKeys);
+
+      for (int i = 1; i <= nKeys; i++) {
+
+         lua_rawgeti(L, 2, i);
+
+         if (LUA_TSTRING != lua_type(L, -1)) {
+            return luaL_error(L, "property names must be strings");
+         }
+
+         const char *key = lua_tostring(L, -1);
+
+         if (const Entity::StoredPropertyValue *property = e->findProperty(key)) {
+            pushPropertyValue(L, *property);
+            lua_setfield(L, 3, key);
+         }
+
+         // Pop the property name
+         lua_pop(L, 1);
+      }
+
+      return 1;
+   }
 }
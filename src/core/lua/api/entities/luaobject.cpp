@@ -94,7 +94,9 @@ namespace trogdor::entity {
       Game *g = LuaGame::checkGame(L, -1);
 
       // Object will not exist in the game unless it's manually inserted
-      Object *o = new Object(nullptr, name, std::make_unique<NullOut>(), g->err().copy());
+      Object *o = LuaState::getInstance(L)->getEntityPool()->create<Object>(
+         nullptr, name, std::make_unique<NullOut>(), g->err().copy()
+      );
       o->setManagedByLua(true);
 
       // TODO: replace with class name once I support that
@@ -118,7 +120,7 @@ namespace trogdor::entity {
       std::string name = luaL_checkstring(L, -1);
 
       // Object will not exist in the game unless it's manually inserted
-      Object *o = new Object(*prototype, name);
+      Object *o = LuaState::getInstance(L)->getEntityPool()->create<Object>(*prototype, name);
       o->setManagedByLua(true);
 
       LuaState::pushEntity(L, o);
@@ -37,6 +37,9 @@ namespace trogdor::entity {
    static const luaL_Reg methods[] = {
       {"insertThing", LuaPlace::insertThing},
       {"removeThing", LuaPlace::removeThing},
+      {"getThings",   LuaPlace::getThings},
+      {"getBeings",   LuaPlace::getBeings},
+      {"getObjects",  LuaPlace::getObjects},
       {0, 0}
    };
 
@@ -161,4 +164,64 @@ namespace trogdor::entity {
       p->removeThing(t->getShared());
       return 0;
    }
+
+   /***************************************************************************/
+
+   int LuaPlace::getThings(lua_State *L) {
+
+      int n = lua_gettop(L);
+
+      if (1 != n) {
+         return luaL_error(L, "takes no arguments");
+      }
+
+      Place *p = checkPlace(L, -1);
+
+      if (nullptr == p) {
+         return luaL_error(L, "not a Place!");
+      }
+
+      LuaState::pushEntityArray(L, p->getThings());
+      return 1;
+   }
+
+   /***************************************************************************/
+
+   int LuaPlace::getBeings(lua_State *L) {
+
+      int n = lua_gettop(L);
+
+      if (1 != n) {
+         return luaL_error(L, "takes no arguments");
+      }
+
+      Place *p = checkPlace(L, -1);
+
+      if (nullptr == p) {
+         return luaL_error(L, "not a Place!");
+      }
+
+      LuaState::pushEntityArray(L, p->getBeings());
+      return 1;
+   }
+
+   /***************************************************************************/
+
+   int LuaPlace::getObjects(lua_State *L) {
+
+      int n = lua_gettop(L);
+
+      if (1 != n) {
+         return luaL_error(L, "takes no arguments");
+      }
+
+      Place *p = checkPlace(L, -1);
+
+      if (nullptr == p) {
+         return luaL_error(L, "not a Place!");
+      }
+
+      LuaState::pushEntityArray(L, p->getObjects());
+      return 1;
+   }
 }
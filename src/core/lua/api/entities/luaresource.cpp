@@ -94,7 +94,7 @@ namespace trogdor::entity {
       lua_getglobal(L, LuaGame::globalName);
 
       // Resource does not exist in the game unless it's manually inserted
-      Resource *c = new Resource(nullptr, name);
+      Resource *c = LuaState::getInstance(L)->getEntityPool()->create<Resource>(nullptr, name);
       c->setManagedByLua(true);
 
       // TODO: replace if necessary with actual class name once I support that
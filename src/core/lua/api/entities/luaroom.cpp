@@ -94,7 +94,9 @@ namespace trogdor::entity {
       Game *g = LuaGame::checkGame(L, -1);
 
       // Room does not exist in the game unless it's manually inserted
-      Room *r = new Room(nullptr, name, std::make_unique<PlaceOut>(), g->err().copy());
+      Room *r = LuaState::getInstance(L)->getEntityPool()->create<Room>(
+         nullptr, name, std::make_unique<PlaceOut>(), g->err().copy()
+      );
       r->setManagedByLua(true);
 
       // TODO: replace with class name once I support that
@@ -118,7 +120,7 @@ namespace trogdor::entity {
       std::string name = luaL_checkstring(L, -1);
 
       // Room will not exist in the game unless it's manually inserted
-      Room *r = new Room(*prototype, name);
+      Room *r = LuaState::getInstance(L)->getEntityPool()->create<Room>(*prototype, name);
       r->setManagedByLua(true);
 
       LuaState::pushEntity(L, r);
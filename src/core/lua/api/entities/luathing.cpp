@@ -123,20 +123,13 @@ namespace trogdor::entity {
          return luaL_error(L, "not a Thing!");
       }
 
-      LuaArray luaAliases;
-      std::vector<std::string> aliases = t->getAliases();
+      const std::vector<std::string> &aliases = t->getAliases();
+      LuaTableBuilder luaAliases(L, static_cast<int>(aliases.size()));
 
-      for (auto &alias: aliases) {
-
-         LuaValue v;
-
-         v.type = LUA_TYPE_STRING;
-         v.value = alias;
-
-         luaAliases.insert(luaAliases.end(), v);
+      for (const auto &alias: aliases) {
+         luaAliases.append(alias);
       }
 
-      LuaState::pushArray(L, luaAliases);
       return 1;
    }
 
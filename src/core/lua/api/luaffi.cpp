@@ -0,0 +1,157 @@
+#include <trogdor/entities/entity.h>
+#include <trogdor/lua/api/luaffi.h>
+
+#include <trogdor/exception/luaexception.h>
+
+extern "C" {
+   #include <lauxlib.h>
+}
+
+using namespace trogdor;
+
+
+const char *trogdor_entity_get_name(const void *entity) {
+
+   return static_cast<const entity::Entity *>(entity)->getName().c_str();
+}
+
+/******************************************************************************/
+
+int trogdor_entity_get_type(const void *entity) {
+
+   return static_cast<const entity::Entity *>(entity)->getType();
+}
+
+/******************************************************************************/
+
+int trogdor_entity_is_type(const void *entity, int type) {
+
+   if (type < entity::ENTITY_UNDEFINED || type > entity::ENTITY_RESOURCE) {
+      return 0;
+   }
+
+   return static_cast<const entity::Entity *>(entity)->isType(
+      static_cast<entity::EntityType>(type)
+   ) ? 1 : 0;
+}
+
+/******************************************************************************/
+
+int trogdor_entity_is_tag_set(const void *entity, const char *tag) {
+
+   return static_cast<const entity::Entity *>(entity)->isTagSet(tag) ? 1 : 0;
+}
+
+/******************************************************************************/
+
+int trogdor_entity_get_number(const void *entity, const char *key, double *value) {
+
+   const entity::Entity::StoredPropertyValue *property =
+      static_cast<const entity::Entity *>(entity)->findProperty(key);
+
+   if (!property) {
+      return 0;
+   }
+
+   switch (property->index()) {
+
+      case 0: // size_t
+         *value = static_cast<double>(std::get<size_t>(*property));
+         return 1;
+
+      case 1: // int
+         *value = static_cast<double>(std::get<int>(*property));
+         return 1;
+
+      case 2: // double
+         *value = std::get<double>(*property);
+         return 1;
+
+      default:
+         return 0;
+   }
+}
+
+/******************************************************************************/
+
+namespace trogdor {
+
+
+   // This is the variable name of the global table that exposes the FFI
+   // accessors to scripts
+   const char *LuaFFI::globalName = "EntityFFI";
+
+   #ifdef ENABLE_LUAJIT_FFI
+
+      // Builds the EntityFFI table. Receives as arguments a table of function
+      // pointers (as light userdata), a table mapping type ids to names, and
+      // the name of the global to define. Entity userdata store a pointer to
+      // the Entity, which is what the C accessors expect.
+      static const char *ffiPrelude =
+         "local fns, typeNames, globalName = ...\n"
+         "local ffi = require('ffi')\n"
+         "local getName = ffi.cast('const char *(*)(const void *)', fns.getName)\n"
+         "local getType = ffi.cast('int (*)(const void *)', fns.getType)\n"
+         "local isType = ffi.cast('int (*)(const void *, int)', fns.isType)\n"
+         "local isTagSet = ffi.cast('int (*)(const void *, const char *)', fns.isTagSet)\n"
+         "local getNumber = ffi.cast('int (*)(const void *, const char *, double *)', fns.getNumber)\n"
+         "local number = ffi.new('double[1]')\n"
+         "local typeIds = {}\n"
+         "for id, name in pairs(typeNames) do typeIds[name] = id end\n"
+         "local function entity(e) return ffi.cast('void **', ffi.cast('void *', e))[0] end\n"
+         "_G[globalName] = {\n"
+         "   getName = function(e) return ffi.string(getName(entity(e))) end,\n"
+         "   getType = function(e) return typeNames[getType(entity(e))] end,\n"
+         "   isType = function(e, t) return 0 ~= isType(entity(e), typeIds[t] or -1) end,\n"
+         "   isTagSet = function(e, tag) return 0 ~= isTagSet(entity(e), tag) end,\n"
+         "   getNumber = function(e, key)\n"
+         "      if 0 ~= getNumber(entity(e), key, number) then return number[0] end\n"
+         "      return nil\n"
+         "   end\n"
+         "}\n";
+
+   #endif
+
+   /***************************************************************************/
+
+   void LuaFFI::registerLuaType(lua_State *L) {
+
+      #ifdef ENABLE_LUAJIT_FFI
+
+         if (luaL_loadstring(L, ffiPrelude)) {
+            throw LuaException(std::string("error: ") + lua_tostring(L, -1));
+         }
+
+         lua_newtable(L);
+
+         lua_pushlightuserdata(L, reinterpret_cast<void *>(trogdor_entity_get_name));
+         lua_setfield(L, -2, "getName");
+
+         lua_pushlightuserdata(L, reinterpret_cast<void *>(trogdor_entity_get_type));
+         lua_setfield(L, -2, "getType");
+
+         lua_pushlightuserdata(L, reinterpret_cast<void *>(trogdor_entity_is_type));
+         lua_setfield(L, -2, "isType");
+
+         lua_pushlightuserdata(L, reinterpret_cast<void *>(trogdor_entity_is_tag_set));
+         lua_setfield(L, -2, "isTagSet");
+
+         lua_pushlightuserdata(L, reinterpret_cast<void *>(trogdor_entity_get_number));
+         lua_setfield(L, -2, "getNumber");
+
+         lua_newtable(L);
+
+         for (int type = entity::ENTITY_ENTITY; type <= entity::ENTITY_RESOURCE; type++) {
+            lua_pushstring(L, entity::Entity::typeToStr(static_cast<entity::EntityType>(type)).c_str());
+            lua_rawseti(L, -2, type);
+         }
+
+         lua_pushstring(L, globalName);
+
+         if (lua_pcall(L, 3, 0, 0)) {
+            throw LuaException(std::string("error: ") + lua_tostring(L, -1));
+         }
+
+      #endif
+   }
+}
@@ -1,10 +1,24 @@
 #include <memory>
+#include <vector>
 
 #include <trogdor/game.h>
 #include <trogdor/entities/entity.h>
+#include <trogdor/entities/resource.h>
+#include <trogdor/entities/tangible.h>
+#include <trogdor/entities/place.h>
+#include <trogdor/entities/room.h>
+#include <trogdor/entities/thing.h>
+#include <trogdor/entities/being.h>
+#include <trogdor/entities/player.h>
+#include <trogdor/entities/creature.h>
+#include <trogdor/entities/object.h>
+
 #include <trogdor/lua/api/luagame.h>
+#include <trogdor/lua/api/entities/luaplace.h>
+#include <trogdor/lua/api/entities/luaroom.h>
 
 #include <trogdor/exception/entityexception.h>
+#include <trogdor/exception/exception.h>
 
 namespace trogdor {
 
@@ -35,6 +49,13 @@ namespace trogdor {
       {"start", LuaGame::start},
       {"stop", LuaGame::stop},
       {"inProgress", LuaGame::inProgress},
+      {"query", LuaGame::query},
+      {"spawnMany", LuaGame::spawnMany},
+      {"getDistance", LuaGame::getDistance},
+      {"getNextStep", LuaGame::getNextStep},
+      {"getPath", LuaGame::getPath},
+      {"getRoomComponent", LuaGame::getRoomComponent},
+      {"getNumRoomComponents", LuaGame::getNumRoomComponents},
       {0, 0}
    };
 
@@ -76,6 +97,24 @@ namespace trogdor {
 
    /***************************************************************************/
 
+   entity::Room *LuaGame::checkRoomArgument(lua_State *L, Game *g, int i) {
+
+      if (LUA_TSTRING == lua_type(L, i)) {
+
+         entity::Room *room = g->getRoom(lua_tostring(L, i)).get();
+
+         if (!room) {
+            luaL_error(L, "room doesn't exist");
+         }
+
+         return room;
+      }
+
+      return entity::LuaRoom::checkRoom(L, i);
+   }
+
+   /***************************************************************************/
+
    int LuaGame::insertEntity(lua_State *L) {
 
       int n = lua_gettop(L);
@@ -88,7 +127,33 @@ namespace trogdor {
       entity::Entity *e = entity::LuaEntity::checkEntity(L, -1);
 
       try {
-         g->insertEntity(e->getName(), std::shared_ptr<entity::Entity>(e));
+
+         // Entities created by Lua scripts are handed off to the game via a
+         // shared_ptr that returns their memory to the pool they were
+         // allocated from. Since that shared_ptr would destroy the Entity out
+         // from under Lua if insertion failed, we have to check first.
+         if (e->isManagedByLua()) {
+
+            if (g->getEntity(e->getName())) {
+               throw entity::EntityException(std::string("Entity '") + e->getName() + "' already exists");
+            }
+
+            g->insertEntity(
+               e->getName(),
+               entity::EntityPool::share(LuaState::getInstance(L)->getEntityPool(), e)
+            );
+
+            // From now on, the game owns the Entity, so Lua's garbage
+            // collector has to leave it alone
+            e->setManagedByLua(false);
+         }
+
+         // Entity is already owned by something else (probably a game), so
+         // we have to share ownership rather than take it
+         else {
+            g->insertEntity(e->getName(), e->getShared());
+         }
+
          lua_pushboolean(L, 1);
       }
 
@@ -218,4 +283,378 @@ namespace trogdor {
       lua_pushboolean(L, g->inProgress());
       return 1;
    }
+
+   /***************************************************************************/
+
+   int LuaGame::query(lua_State *L) {
+
+      int n = lua_gettop(L);
+
+      if (n < 1 || n > 2) {
+         return luaL_error(L, "takes at most one argument, a table of filters");
+      }
+
+      Game *g = checkGame(L, 1);
+
+      if (nullptr == g) {
+         return luaL_error(L, "Game object is nil");
+      }
+
+      entity::EntityType type = entity::ENTITY_ENTITY;
+      const char *tag = nullptr;
+      entity::Place *place = nullptr;
+
+      if (2 == n) {
+
+         luaL_checktype(L, 2, LUA_TTABLE);
+
+         lua_getfield(L, 2, "type");
+
+         if (!lua_isnil(L, -1)) {
+
+            type = entity::Entity::strToType(luaL_checkstring(L, -1));
+
+            if (entity::ENTITY_UNDEFINED == type) {
+               return luaL_error(L, "invalid entity type");
+            }
+         }
+
+         lua_getfield(L, 2, "tag");
+
+         if (!lua_isnil(L, -1)) {
+            tag = luaL_checkstring(L, -1);
+         }
+
+         lua_getfield(L, 2, "place");
+
+         if (LUA_TSTRING == lua_type(L, -1)) {
+
+            place = g->getPlace(lua_tostring(L, -1)).get();
+
+            // A Place that doesn't exist can't contain anything
+            if (!place) {
+               lua_newtable(L);
+               return 1;
+            }
+         }
+
+         else if (!lua_isnil(L, -1)) {
+            place = entity::LuaPlace::checkPlace(L, -1);
+         }
+      }
+
+      std::vector<entity::Entity *> results;
+
+      auto filter = [&](entity::Entity *e) {
+         if (e->isType(type) && (!tag || e->isTagSet(tag))) {
+            results.push_back(e);
+         }
+      };
+
+      auto filterList = [&](const auto &entities) {
+         for (const auto &e: entities) {
+            filter(e.get());
+         }
+      };
+
+      auto filterMap = [&](const auto &entities) {
+         for (const auto &e: entities) {
+            filter(e.second.get());
+         }
+      };
+
+      // Views hand out raw pointers through their iterators, which saves
+      // making a shared_ptr for every Entity we look at
+      auto filterView = [&](const auto &entities) {
+         for (auto e = entities.begin(); e != entities.end(); e++) {
+            filter(e.get());
+         }
+      };
+
+      if (place) {
+
+         switch (type) {
+
+            case entity::ENTITY_BEING:
+               filterList(place->getBeings());
+               break;
+
+            case entity::ENTITY_PLAYER:
+               filterList(place->getPlayers());
+               break;
+
+            case entity::ENTITY_CREATURE:
+               filterList(place->getCreatures());
+               break;
+
+            case entity::ENTITY_OBJECT:
+               filterList(place->getObjects());
+               break;
+
+            default:
+               filterList(place->getThings());
+               break;
+         }
+      }
+
+      // The tag index only contains Entities that match, which is nearly
+      // always fewer than there are Entities of any given type
+      else if (tag) {
+         filterList(g->getEntitiesWithTag(tag));
+      }
+
+      else {
+
+         switch (type) {
+
+            case entity::ENTITY_RESOURCE:
+               filterView(g->getResources());
+               break;
+
+            case entity::ENTITY_TANGIBLE:
+               filterView(g->getTangibles());
+               break;
+
+            case entity::ENTITY_PLACE:
+               filterView(g->getPlaces());
+               break;
+
+            case entity::ENTITY_ROOM:
+               filterView(g->getRooms());
+               break;
+
+            case entity::ENTITY_THING:
+               filterView(g->getThings());
+               break;
+
+            case entity::ENTITY_BEING:
+               filterView(g->getBeings());
+               break;
+
+            case entity::ENTITY_PLAYER:
+               filterView(g->getPlayers());
+               break;
+
+            case entity::ENTITY_CREATURE:
+               filterView(g->getCreatures());
+               break;
+
+            case entity::ENTITY_OBJECT:
+               filterView(g->getObjects());
+               break;
+
+            default:
+               filterMap(g->getEntities());
+               break;
+         }
+      }
+
+      LuaState::pushEntityArray(L, results);
+      return 1;
+   }
+
+   /***************************************************************************/
+
+   int LuaGame::spawnMany(lua_State *L) {
+
+      int n = lua_gettop(L);
+
+      if (n < 3 || n > 5) {
+         return luaL_error(L, "takes between two and four arguments");
+      }
+
+      Game *g = checkGame(L, 1);
+
+      if (nullptr == g) {
+         return luaL_error(L, "Game object is nil");
+      }
+
+      std::string className = luaL_checkstring(L, 2);
+      lua_Integer count = luaL_checkinteger(L, 3);
+      std::shared_ptr<entity::Place> place;
+      std::string namePattern;
+
+      if (count < 0) {
+         return luaL_error(L, "count can't be negative");
+      }
+
+      if (n > 3) {
+
+         if (LUA_TSTRING == lua_type(L, 4)) {
+
+            place = g->getPlace(lua_tostring(L, 4));
+
+            if (!place) {
+               return luaL_error(L, "place doesn't exist");
+            }
+         }
+
+         else if (!lua_isnil(L, 4)) {
+
+            entity::Place *p = entity::LuaPlace::checkPlace(L, 4);
+
+            // Things can only be put in a Place that's part of the game
+            if (p->isManagedByLua()) {
+               return luaL_error(L, "place hasn't been inserted into the game");
+            }
+
+            place = p->getShared();
+         }
+      }
+
+      if (n > 4) {
+         namePattern = luaL_checkstring(L, 5);
+      }
+
+      try {
+
+         std::vector<entity::Entity *> spawned;
+
+         for (const auto &thing: g->spawnMany(className, count, place, namePattern)) {
+            spawned.push_back(thing.get());
+         }
+
+         LuaState::pushEntityArray(L, spawned);
+         return 1;
+      }
+
+      catch (const Exception &e) {
+         return luaL_error(L, e.what());
+      }
+   }
+
+   /***************************************************************************/
+
+   int LuaGame::getDistance(lua_State *L) {
+
+      if (3 != lua_gettop(L)) {
+         return luaL_error(L, "takes two arguments");
+      }
+
+      Game *g = checkGame(L, 1);
+
+      if (nullptr == g) {
+         return luaL_error(L, "Game object is nil");
+      }
+
+      entity::Room *from = checkRoomArgument(L, g, 2);
+      entity::Room *to = checkRoomArgument(L, g, 3);
+
+      if (auto distance = g->getRoomGraph().getDistance(from, to)) {
+         lua_pushinteger(L, *distance);
+      } else {
+         lua_pushnil(L);
+      }
+
+      return 1;
+   }
+
+   /***************************************************************************/
+
+   int LuaGame::getNextStep(lua_State *L) {
+
+      if (3 != lua_gettop(L)) {
+         return luaL_error(L, "takes two arguments");
+      }
+
+      Game *g = checkGame(L, 1);
+
+      if (nullptr == g) {
+         return luaL_error(L, "Game object is nil");
+      }
+
+      entity::Room *from = checkRoomArgument(L, g, 2);
+      entity::Room *to = checkRoomArgument(L, g, 3);
+
+      auto step = g->getRoomGraph().getNextStep(from, to);
+
+      if (!step || !step->room) {
+         lua_pushnil(L);
+         return 1;
+      }
+
+      LuaState::pushEntity(L, step->room.get());
+      lua_pushstring(L, g->getVocabulary().getDirectionName(step->direction).c_str());
+
+      return 2;
+   }
+
+   /***************************************************************************/
+
+   int LuaGame::getPath(lua_State *L) {
+
+      if (3 != lua_gettop(L)) {
+         return luaL_error(L, "takes two arguments");
+      }
+
+      Game *g = checkGame(L, 1);
+
+      if (nullptr == g) {
+         return luaL_error(L, "Game object is nil");
+      }
+
+      entity::Room *from = checkRoomArgument(L, g, 2);
+      entity::Room *to = checkRoomArgument(L, g, 3);
+
+      std::vector<entity::Entity *> rooms;
+      std::vector<std::string> directions;
+
+      for (const auto &step: g->getRoomGraph().getPath(from, to)) {
+         rooms.push_back(step.room.get());
+         directions.push_back(g->getVocabulary().getDirectionName(step.direction));
+      }
+
+      LuaState::pushEntityArray(L, rooms);
+      lua_createtable(L, static_cast<int>(directions.size()), 0);
+
+      for (size_t i = 0; i < directions.size(); i++) {
+         lua_pushstring(L, directions[i].c_str());
+         lua_rawseti(L, -2, i + 1);
+      }
+
+      return 2;
+   }
+
+   /***************************************************************************/
+
+   int LuaGame::getRoomComponent(lua_State *L) {
+
+      if (2 != lua_gettop(L)) {
+         return luaL_error(L, "takes one argument");
+      }
+
+      Game *g = checkGame(L, 1);
+
+      if (nullptr == g) {
+         return luaL_error(L, "Game object is nil");
+      }
+
+      entity::Room *room = checkRoomArgument(L, g, 2);
+
+      if (auto component = g->getRoomGraph().getComponent(room)) {
+         lua_pushinteger(L, *component + 1);
+      } else {
+         lua_pushnil(L);
+      }
+
+      return 1;
+   }
+
+   /***************************************************************************/
+
+   int LuaGame::getNumRoomComponents(lua_State *L) {
+
+      if (1 != lua_gettop(L)) {
+         return luaL_error(L, "takes no arguments");
+      }
+
+      Game *g = checkGame(L, 1);
+
+      if (nullptr == g) {
+         return luaL_error(L, "Game object is nil");
+      }
+
+      lua_pushinteger(L, g->getRoomGraph().getNumComponents());
+      return 1;
+   }
 }
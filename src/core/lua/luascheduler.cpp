@@ -0,0 +1,298 @@
+#include <trogdor/game.h>
+#include <trogdor/lua/luastate.h>
+#include <trogdor/lua/luascheduler.h>
+
+#include <trogdor/exception/luaexception.h>
+
+namespace trogdor {
+
+
+   const luaL_Reg LuaScheduler::functions[] = {
+      {"spawn",     LuaScheduler::spawnCoroutine},
+      {"wait",      LuaScheduler::wait},
+      {"waitEvent", LuaScheduler::waitEvent},
+      {0, 0}
+   };
+
+   /***************************************************************************/
+
+   void LuaScheduler::registerLuaFunctions(lua_State *L) {
+
+      for (const luaL_Reg *function = functions; function->name; function++) {
+         lua_pushcfunction(L, function->func);
+         lua_setglobal(L, function->name);
+      }
+   }
+
+   /***************************************************************************/
+
+   // wait() and waitEvent() yield the address of one of these ahead of their
+   // argument so that resume() can tell them apart from a plain
+   // coroutine.yield(), whatever values the script happens to pass to it
+   static char waitMarker;
+   static char waitEventMarker;
+
+   /***************************************************************************/
+
+   // Returns true if L is the main thread rather than a coroutine, in which
+   // case yielding would be an error
+   static bool isMainThread(lua_State *L) {
+
+      bool isMain = lua_pushthread(L);
+
+      lua_pop(L, 1);
+      return isMain;
+   }
+
+   /***************************************************************************/
+
+   int LuaScheduler::spawnCoroutine(lua_State *L) {
+
+      int n = lua_gettop(L);
+
+      if (n < 1) {
+         return luaL_error(L, "function required");
+      }
+
+      luaL_checktype(L, 1, LUA_TFUNCTION);
+
+      size_t id = LuaState::getInstance(L)->getScheduler()->spawn(L, n - 1);
+
+      lua_pushnumber(L, static_cast<lua_Number>(id));
+      return 1;
+   }
+
+   /***************************************************************************/
+
+   int LuaScheduler::wait(lua_State *L) {
+
+      int n = lua_gettop(L);
+
+      if (1 != n) {
+         return luaL_error(L, "requires number of ticks");
+      }
+
+      luaL_checknumber(L, 1);
+
+      if (isMainThread(L)) {
+         return luaL_error(L, "wait() can only be called from a coroutine started by spawn()");
+      }
+
+      lua_pushlightuserdata(L, &waitMarker);
+      lua_insert(L, 1);
+
+      return lua_yield(L, 2);
+   }
+
+   /***************************************************************************/
+
+   int LuaScheduler::waitEvent(lua_State *L) {
+
+      int n = lua_gettop(L);
+
+      if (1 != n) {
+         return luaL_error(L, "requires event name");
+      }
+
+      luaL_checkstring(L, 1);
+
+      if (isMainThread(L)) {
+         return luaL_error(L, "waitEvent() can only be called from a coroutine started by spawn()");
+      }
+
+      lua_pushlightuserdata(L, &waitEventMarker);
+      lua_insert(L, 1);
+
+      return lua_yield(L, 2);
+   }
+
+   /***************************************************************************/
+
+   size_t LuaScheduler::spawn(lua_State *from, int nArgs) {
+
+      size_t id = nextId++;
+      lua_State *thread = lua_newthread(from);
+
+      // A new thread inherits whatever hook the thread that created it has,
+      // which isn't necessarily the one we want
+      lua_sethook(thread, hook, hookMask, hookCount);
+
+      // Pops the thread and anchors it in the registry until it finishes
+      int ref = luaL_ref(from, LUA_REGISTRYINDEX);
+
+      // Moves the function and its arguments onto the new thread's stack
+      lua_xmove(from, thread, nArgs + 1);
+
+      coroutines[id] = {thread, ref, nArgs};
+
+      mutex.lock();
+      ready.push_back({id, ""});
+      mutex.unlock();
+
+      return id;
+   }
+
+   /***************************************************************************/
+
+   size_t LuaScheduler::spawn(const std::string &function) {
+
+      lua_getglobal(L, function.c_str());
+
+      if (!lua_isfunction(L, -1)) {
+         lua_pop(L, 1);
+         throw LuaException("function '" + function + "' does not exist");
+      }
+
+      return spawn(L, 0);
+   }
+
+   /***************************************************************************/
+
+   void LuaScheduler::cancel(size_t id) {
+
+      // Any references left behind in the ready, sleeping, or waiting queues
+      // are skipped when they're encountered
+      if (auto coroutine = coroutines.find(id); coroutine != coroutines.end()) {
+         luaL_unref(L, LUA_REGISTRYINDEX, coroutine->second.ref);
+         coroutines.erase(coroutine);
+      }
+   }
+
+   /***************************************************************************/
+
+   void LuaScheduler::setHook(lua_Hook newHook, int mask, int count) {
+
+      hook = newHook;
+      hookMask = mask;
+      hookCount = count;
+
+      for (const auto &coroutine: coroutines) {
+         lua_sethook(coroutine.second.thread, hook, hookMask, hookCount);
+      }
+   }
+
+   /***************************************************************************/
+
+   int LuaScheduler::resumeThread(lua_State *thread, int nArgs) {
+
+      #if LUA_VERSION_NUM > 501
+         return lua_resume(thread, L, nArgs);
+      #else
+         return lua_resume(thread, nArgs);
+      #endif
+   }
+
+   /***************************************************************************/
+
+   void LuaScheduler::resume(size_t time) {
+
+      auto start = std::chrono::steady_clock::now();
+
+      mutex.lock();
+
+      while (!sleeping.empty() && sleeping.top().first <= time) {
+         ready.push_back({sleeping.top().second, ""});
+         sleeping.pop();
+      }
+
+      // Coroutines that yield during this call are queued up again behind the
+      // ones we're about to resume, so they won't run until the next tick
+      size_t nReady = ready.size();
+
+      mutex.unlock();
+
+      for (size_t i = 0; i < nReady; i++) {
+
+         // At least one coroutine always runs, so that a budget that's too
+         // small can't stall the scheduler completely
+         if (i && budget.count() && std::chrono::steady_clock::now() - start >= budget) {
+            break;
+         }
+
+         mutex.lock();
+         std::pair<size_t, std::string> next = std::move(ready.front());
+         ready.pop_front();
+         mutex.unlock();
+
+         auto coroutine = coroutines.find(next.first);
+
+         // Coroutine was cancelled
+         if (coroutines.end() == coroutine) {
+            continue;
+         }
+
+         lua_State *thread = coroutine->second.thread;
+         int nArgs = coroutine->second.nArgs;
+
+         coroutine->second.nArgs = 0;
+
+         if (next.second.length()) {
+            lua_pushlstring(thread, next.second.c_str(), next.second.length());
+            nArgs++;
+         }
+
+         int status = resumeThread(thread, nArgs);
+
+         if (LUA_YIELD == status) {
+
+            void *marker = lua_gettop(thread) >= 2 && LUA_TLIGHTUSERDATA == lua_type(thread, 1) ?
+               lua_touserdata(thread, 1) : nullptr;
+
+            // wait(ticks)
+            if (&waitMarker == marker) {
+
+               lua_Number ticks = lua_tonumber(thread, 2);
+               sleeping.push({time + (ticks < 1 ? 1 : static_cast<size_t>(ticks)), next.first});
+            }
+
+            // waitEvent(name)
+            else if (&waitEventMarker == marker) {
+
+               mutex.lock();
+               waiting[lua_tostring(thread, 2)].push_back(next.first);
+               mutex.unlock();
+            }
+
+            // Anything else, including coroutine.yield() with arguments,
+            // just waits for the next tick
+            else {
+               mutex.lock();
+               ready.push_back({next.first, ""});
+               mutex.unlock();
+            }
+
+            lua_settop(thread, 0);
+         }
+
+         // The coroutine either finished or raised an error
+         else {
+
+            if (status) {
+               game->err() << "lua coroutine error: " << (
+                  lua_isstring(thread, -1) ? lua_tostring(thread, -1) : "unknown error"
+               ) << std::endl;
+            }
+
+            // The iterator may have been invalidated if the coroutine spawned
+            // another, so we have to look it up again
+            cancel(next.first);
+         }
+      }
+   }
+
+   /***************************************************************************/
+
+   void LuaScheduler::signalEvent(const std::string &event) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      if (auto waiters = waiting.find(event); waiters != waiting.end()) {
+
+         for (const auto &id: waiters->second) {
+            ready.push_back({id, event});
+         }
+
+         waiting.erase(waiters);
+      }
+   }
+}
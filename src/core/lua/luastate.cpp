@@ -1,3 +1,7 @@
+#include <map>
+#include <cctype>
+#include <cstring>
+#include <vector>
 #include <fstream>
 #include <string>
 #include <sstream>
@@ -12,6 +16,22 @@
 namespace trogdor {
 
 
+   const char *LuaState::RegistryKey = "trogdor.LuaState";
+
+   /***************************************************************************/
+
+   LuaState *LuaState::getInstance(lua_State *L) {
+
+      lua_getfield(L, LUA_REGISTRYINDEX, RegistryKey);
+
+      LuaState *instance = static_cast<LuaState *>(lua_touserdata(L, -1));
+      lua_pop(L, 1);
+
+      return instance;
+   }
+
+   /***************************************************************************/
+
    void LuaState::registerGlobalGame() {
 
       LuaGame::registerLuaType(L);
@@ -28,12 +48,15 @@ namespace trogdor {
 
    /***************************************************************************/
 
-   void LuaState::pushLuaValue(LuaValue v, lua_State *L) {
+   void LuaState::pushLuaValue(const LuaValue &v, lua_State *L) {
 
       switch (v.type) {
 
          case LUA_TYPE_STRING:
-            lua_pushstring(L, std::get<std::string>(v.value).c_str());
+            {
+               const std::string &str = std::get<std::string>(v.value);
+               lua_pushlstring(L, str.c_str(), str.length());
+            }
             break;
 
          case LUA_TYPE_NUMBER:
@@ -108,34 +131,27 @@ namespace trogdor {
 
    /***************************************************************************/
 
-   void LuaState::pushArray(lua_State *L, LuaArray &arg) {
+   void LuaState::pushArray(lua_State *L, const LuaArray &arg) {
 
-      lua_newtable(L);
+      lua_createtable(L, static_cast<int>(arg.size()), 0);
 
       for (unsigned int i = 0; i < arg.size(); i++) {
-         LuaValue v = arg[i];
-         pushLuaValue(v, L);
+         pushLuaValue(arg[i], L);
          lua_rawseti(L, -2, i + 1);
       }
    }
 
    /***************************************************************************/
 
-   void LuaState::pushTable(lua_State *L, LuaTable &arg) {
-
-      LuaTable::TableValues values = arg.getValues();
-
-      lua_newtable(L);
+   void LuaState::pushTable(lua_State *L, const LuaTable &arg) {
 
-      for (LuaTable::TableValues::iterator i = values.begin();
-      i != values.end(); ++i) {
+      const LuaTable::TableValues &values = arg.getValues();
 
-         std::string key = i->first;
-         LuaValue v = i->second;
+      lua_createtable(L, 0, static_cast<int>(values.size()));
 
-         pushLuaValue(v, L);
-
-         lua_setfield(L, -2, key.c_str());
+      for (const auto &field: values) {
+         pushLuaValue(field.second, L);
+         lua_setfield(L, -2, field.first.c_str());
       }
    }
 
@@ -248,4 +264,217 @@ namespace trogdor {
       nArgs = 0;
       nReturnValues = nReturnVals;
    }
+
+   /***************************************************************************/
+
+   void LuaState::profilerHook(lua_State *L, lua_Debug *) {
+
+      LuaState *state = getInstance(L);
+
+      if (!state || !state->profiling) {
+         return;
+      }
+
+      lua_Debug frameInfo;
+      std::vector<std::string> frames;
+
+      // Level 0 is the currently running function, so frames are collected
+      // innermost first
+      for (int level = 0; lua_getstack(L, level, &frameInfo); level++) {
+
+         lua_getinfo(L, "Sn", &frameInfo);
+
+         std::string frame;
+
+         if (frameInfo.name) {
+            frame = frameInfo.name;
+         } else if (0 == strcmp(frameInfo.what, "main")) {
+            frame = "main chunk";
+         } else {
+            frame = "(anonymous)";
+         }
+
+         frame += "@";
+         frame += frameInfo.short_src;
+
+         // The line a function was defined on identifies it no matter which
+         // line it happened to be executing or where it was called from
+         if (frameInfo.linedefined > 0) {
+            frame += ":" + std::to_string(frameInfo.linedefined);
+         }
+
+         // Folded stack format uses semicolons to separate frames and a space
+         // to separate the stack from its count
+         for (auto &c: frame) {
+            if (';' == c || std::isspace(static_cast<unsigned char>(c))) {
+               c = '_';
+            }
+         }
+
+         frames.push_back(frame);
+      }
+
+      if (!frames.size()) {
+         return;
+      }
+
+      std::string stack;
+
+      for (auto frame = frames.rbegin(); frame != frames.rend(); frame++) {
+
+         if (stack.length()) {
+            stack += ";";
+         }
+
+         stack += *frame;
+      }
+
+      state->profilerSamples[stack]++;
+   }
+
+   /***************************************************************************/
+
+   void LuaState::startProfiler(int interval) {
+
+      if (interval < 1) {
+         throw LuaException("profiler interval must be greater than 0");
+      }
+
+      profilerInterval = interval;
+      profiling = true;
+
+      // Hooks are set per thread, so coroutines need their own
+      lua_sethook(L, profilerHook, LUA_MASKCOUNT, profilerInterval);
+      scheduler->setHook(profilerHook, LUA_MASKCOUNT, profilerInterval);
+   }
+
+   /***************************************************************************/
+
+   void LuaState::stopProfiler() {
+
+      lua_sethook(L, nullptr, 0, 0);
+      scheduler->setHook(nullptr, 0, 0);
+      profiling = false;
+   }
+
+   /***************************************************************************/
+
+   size_t LuaState::getProfilerSampleCount() const {
+
+      size_t total = 0;
+
+      for (const auto &sample: profilerSamples) {
+         total += sample.second;
+      }
+
+      return total;
+   }
+
+   /***************************************************************************/
+
+   void LuaState::dumpProfile(std::ostream &out) const {
+
+      // Sort the stacks so that dumps of the same data are always identical
+      std::map<std::string, size_t> sorted(profilerSamples.begin(), profilerSamples.end());
+
+      for (const auto &sample: sorted) {
+         out << sample.first << ' ' << sample.second << '\n';
+      }
+   }
+
+   /***************************************************************************/
+
+   void LuaState::validateGCConfig(const LuaGCConfig &config) {
+
+      if (LUA_GC_MODE_GENERATIONAL == config.mode && !supportsGenerationalGC()) {
+         throw LuaException(
+            std::string("generational garbage collection is not supported by ") + getLuaVersion()
+         );
+      }
+
+      if (config.pause < 0) {
+         throw LuaException("garbage collector pause cannot be negative");
+      }
+
+      if (config.stepMultiplier < 0) {
+         throw LuaException("garbage collector step multiplier cannot be negative");
+      }
+
+      if (config.idleStepSize < 0) {
+         throw LuaException("garbage collector idle step size cannot be negative");
+      }
+   }
+
+   /***************************************************************************/
+
+   void LuaState::applyGCConfig() {
+
+      // Lua 5.1 and 5.3 only have an incremental collector, so there's no
+      // mode to switch
+      #ifdef LUA_GCGEN
+         if (LUA_GC_MODE_GENERATIONAL == gcConfig.mode) {
+            lua_gc(L, LUA_GCGEN, 0);
+         } else {
+            lua_gc(L, LUA_GCINC, 0);
+         }
+      #endif
+
+      lua_gc(L, LUA_GCSETPAUSE, gcConfig.pause);
+      lua_gc(L, LUA_GCSETSTEPMUL, gcConfig.stepMultiplier);
+   }
+
+   /***************************************************************************/
+
+   void LuaState::initEntityPool() {
+
+      entityPool = game ? game->getEntityPool() : std::make_shared<entity::EntityPool>();
+   }
+
+   /***************************************************************************/
+
+   void LuaState::configureGC(const LuaGCConfig &config) {
+
+      validateGCConfig(config);
+
+      gcConfig = config;
+      applyGCConfig();
+   }
+
+   /***************************************************************************/
+
+   std::chrono::microseconds LuaState::stepGC(std::chrono::microseconds limit) {
+
+      auto start = std::chrono::steady_clock::now();
+      auto elapsed = std::chrono::microseconds(0);
+
+      // LUA_GCSTEP starts a new cycle even while the collector is pausing
+      // between them, so unless we're in the middle of one, we wait until
+      // enough garbage has accumulated that Lua would be starting one anyway
+      if (!gcCycleInProgress &&
+      static_cast<long>(lua_gc(L, LUA_GCCOUNT, 0)) * 100 < static_cast<long>(gcBaseline) * gcConfig.pause) {
+         return elapsed;
+      }
+
+      gcCycleInProgress = true;
+
+      while (elapsed < limit) {
+
+         // lua_gc returns 1 when the step finishes a cycle. Stepping any
+         // further would just start the next one early.
+         bool finishedCycle = lua_gc(L, LUA_GCSTEP, gcConfig.idleStepSize);
+
+         numGCSteps++;
+         elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start
+         );
+
+         if (finishedCycle) {
+            gcCycleInProgress = false;
+            gcBaseline = lua_gc(L, LUA_GCCOUNT, 0);
+            break;
+         }
+      }
+
+      return elapsed;
+   }
 }
@@ -0,0 +1,147 @@
+#include <trogdor/lua/luastate.h>
+#include <trogdor/lua/luatablebuilder.h>
+
+namespace trogdor {
+
+
+   LuaTableBuilder::LuaTableBuilder(lua_State *L, int nArray, int nRecords):
+   L(L), nextIndex(1), nested(false), parentIndex(0) {
+
+      lua_createtable(L, nArray, nRecords);
+   }
+
+   /***************************************************************************/
+
+   LuaTableBuilder::LuaTableBuilder(
+      lua_State *L,
+      int nArray,
+      int nRecords,
+      std::string key,
+      lua_Integer index
+   ): L(L), nextIndex(1), nested(true), parentKey(key), parentIndex(index) {
+
+      lua_createtable(L, nArray, nRecords);
+   }
+
+   /***************************************************************************/
+
+   void LuaTableBuilder::store(const char *key) {
+
+      if (key) {
+         lua_setfield(L, -2, key);
+      } else {
+         lua_rawseti(L, -2, nextIndex++);
+      }
+   }
+
+   /***************************************************************************/
+
+   void LuaTableBuilder::setField(const char *key, const char *value) {
+
+      lua_pushstring(L, value);
+      store(key);
+   }
+
+   void LuaTableBuilder::setField(const char *key, const std::string &value) {
+
+      lua_pushlstring(L, value.c_str(), value.length());
+      store(key);
+   }
+
+   void LuaTableBuilder::setField(const char *key, double value) {
+
+      lua_pushnumber(L, value);
+      store(key);
+   }
+
+   void LuaTableBuilder::setField(const char *key, int value) {
+
+      // Lua 5.3 introduced an integer type
+      #if LUA_VERSION_NUM > 502
+         lua_pushinteger(L, value);
+      #else
+         lua_pushnumber(L, value);
+      #endif
+
+      store(key);
+   }
+
+   void LuaTableBuilder::setField(const char *key, size_t value) {
+
+      #if LUA_VERSION_NUM > 502
+         lua_pushinteger(L, static_cast<lua_Integer>(value));
+      #else
+         lua_pushnumber(L, static_cast<lua_Number>(value));
+      #endif
+
+      store(key);
+   }
+
+   void LuaTableBuilder::setField(const char *key, bool value) {
+
+      lua_pushboolean(L, value);
+      store(key);
+   }
+
+   void LuaTableBuilder::setField(const char *key, entity::Entity *value) {
+
+      LuaState::pushEntity(L, value);
+      store(key);
+   }
+
+   void LuaTableBuilder::setField(const char *key, const LuaArray &value) {
+
+      LuaState::pushArray(L, value);
+      store(key);
+   }
+
+   void LuaTableBuilder::setField(const char *key, const LuaTable &value) {
+
+      LuaState::pushTable(L, value);
+      store(key);
+   }
+
+   /***************************************************************************/
+
+   void LuaTableBuilder::append(const char *value) {setField(nullptr, value);}
+   void LuaTableBuilder::append(const std::string &value) {setField(nullptr, value);}
+   void LuaTableBuilder::append(double value) {setField(nullptr, value);}
+   void LuaTableBuilder::append(int value) {setField(nullptr, value);}
+   void LuaTableBuilder::append(size_t value) {setField(nullptr, value);}
+   void LuaTableBuilder::append(bool value) {setField(nullptr, value);}
+   void LuaTableBuilder::append(entity::Entity *value) {setField(nullptr, value);}
+   void LuaTableBuilder::append(const LuaArray &value) {setField(nullptr, value);}
+   void LuaTableBuilder::append(const LuaTable &value) {setField(nullptr, value);}
+
+   /***************************************************************************/
+
+   LuaTableBuilder LuaTableBuilder::beginTable(const char *key, int nArray, int nRecords) {
+
+      return LuaTableBuilder(L, nArray, nRecords, key, 0);
+   }
+
+   /***************************************************************************/
+
+   LuaTableBuilder LuaTableBuilder::appendTable(int nArray, int nRecords) {
+
+      return LuaTableBuilder(L, nArray, nRecords, "", nextIndex++);
+   }
+
+   /***************************************************************************/
+
+   void LuaTableBuilder::end() {
+
+      if (!nested) {
+         return;
+      }
+
+      if (parentIndex) {
+         lua_rawseti(L, -2, parentIndex);
+      } else {
+         lua_setfield(L, -2, parentKey.c_str());
+      }
+
+      // Make sure a second call doesn't pop the parent
+      nested = false;
+   }
+}
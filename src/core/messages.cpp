@@ -6,26 +6,28 @@
 namespace trogdor {
 
 
-   std::string Messages::get(const std::string &name) const {
+   std::string_view Messages::get(const std::string &name) const {
 
-      if (messageTable.find(name) == messageTable.end()) {
-         return "";
+      auto message = messageTable.find(name);
+
+      if (message == messageTable.end()) {
+         return {};
       }
 
-      return messageTable.find(name)->second;
+      return message->second.view();
    }
 
 
-   void Messages::set(std::string name, std::string message) {
+   void Messages::set(std::string name, std::string_view message) {
 
-      messageTable[name] = message;
+      messageTable[name] = PooledString(message);
       return;
    }
 
 
    void Messages::display(std::string name, std::ostream &out) const {
 
-      std::string message = get(name);
+      std::string_view message = get(name);
 
       out << message;
       if (message.length() > 0) {
@@ -1389,7 +1389,7 @@ namespace trogdor {
 
       static std::unordered_map<std::string, std::string> tagToProperty({
          {"enabled", "wandering.enabled"}, {"interval", "wandering.interval"},
-         {"wanderlust", "wandering.wanderlust"}
+         {"wanderlust", "wandering.wanderlust"}, {"mode", "wandering.mode"}
       });
 
       while (nextTag() && 4 == getDepth()) {
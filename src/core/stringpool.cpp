@@ -0,0 +1,87 @@
+#include <trogdor/stringpool.h>
+
+namespace trogdor {
+
+
+   PooledString::PooledString(std::string_view text) {
+
+      if (!text.empty()) {
+         *this = StringPool::get().intern(text);
+      }
+   }
+
+   /***************************************************************************/
+
+   StringPool &StringPool::get() {
+
+      static StringPool *pool = new StringPool();
+      return *pool;
+   }
+
+   /***************************************************************************/
+
+   PooledString StringPool::intern(std::string_view text) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      auto entry = strings.find(text);
+
+      if (strings.end() != entry) {
+
+         if (auto existing = entry->second.lock()) {
+            return PooledString(existing);
+         }
+
+         // The last handle is gone, but release() hasn't gotten to it yet.
+         // The key is a view of the dying string, so it has to be replaced
+         // along with the value.
+         strings.erase(entry);
+      }
+
+      std::shared_ptr<const std::string> value(new std::string(text), [this](const std::string *s) {
+         release(s);
+         delete s;
+      });
+
+      strings[*value] = value;
+      return PooledString(value);
+   }
+
+   /***************************************************************************/
+
+   void StringPool::release(const std::string *string) {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      auto entry = strings.find(*string);
+
+      // If the string was interned again after its last handle went away,
+      // the entry belongs to the new copy and has to stay
+      if (strings.end() != entry && entry->second.expired() && entry->first.data() == string->data()) {
+         strings.erase(entry);
+      }
+   }
+
+   /***************************************************************************/
+
+   size_t StringPool::size() const {
+
+      std::lock_guard<std::mutex> lock(mutex);
+      return strings.size();
+   }
+
+   /***************************************************************************/
+
+   size_t StringPool::bytes() const {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      size_t total = 0;
+
+      for (const auto &entry: strings) {
+         total += entry.first.length();
+      }
+
+      return total;
+   }
+}
@@ -0,0 +1,250 @@
+#include <doctest.h>
+
+#include <atomic>
+#include <thread>
+
+#include <trogdor/game.h>
+#include <trogdor/entities/room.h>
+#include <trogdor/entities/object.h>
+#include <trogdor/entities/player.h>
+#include <trogdor/entities/creature.h>
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+#include "../mock/mockroom.h"
+
+
+TEST_SUITE("Creature (entities/creature.cpp)") {
+
+	TEST_CASE("Creature (entities/creature.cpp): Pursuing and fleeing Players") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		auto makeCreature = [&](std::string name, trogdor::entity::Creature::WanderMode mode) {
+
+			auto creature = std::make_shared<trogdor::entity::Creature>(
+				&game, name, std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+			);
+
+			game.insertEntity(name, creature);
+			creature->setProperty(trogdor::entity::PROPERTY_SLOT_WANDER_MODE, static_cast<int>(mode));
+
+			return creature;
+		};
+
+		auto move = [](const std::shared_ptr<trogdor::entity::Thing> &thing, const std::shared_ptr<trogdor::entity::Room> &room) {
+			thing->getLocation().lock()->removeThing(thing);
+			room->insertThing(thing);
+		};
+
+		// start <-> hall <-> den, and a closet that only leads into the den
+		auto start = trogdor::entity::makeMockRoom(game, "start");
+		auto hall = trogdor::entity::makeMockRoom(game, "hall");
+		auto den = trogdor::entity::makeMockRoom(game, "den");
+		auto closet = trogdor::entity::makeMockRoom(game, "closet");
+
+		start->setConnection("east", hall);
+		hall->setConnection("west", start);
+		hall->setConnection("east", den);
+		den->setConnection("west", hall);
+		closet->setConnection("south", den);
+
+		auto troll = makeCreature("troll", trogdor::entity::Creature::WANDER_PURSUE);
+		auto bunny = makeCreature("bunny", trogdor::entity::Creature::WANDER_FLEE);
+		auto rat = makeCreature("rat", trogdor::entity::Creature::WANDER_PURSUE);
+
+		CHECK(trogdor::entity::Creature::WANDER_RANDOM == trogdor::entity::Creature::DEFAULT_WANDER_MODE);
+		CHECK(trogdor::entity::Entity::PROPERTY_VALID != troll->setProperty(trogdor::entity::PROPERTY_SLOT_WANDER_MODE, 7));
+
+		den->insertThing(troll);
+		hall->insertThing(bunny);
+		closet->insertThing(rat);
+
+		// With no Players around, pursuing Creatures wander at random
+		CHECK(den == rat->selectWanderDestination());
+		CHECK(!troll->getWanderTarget());
+
+		auto player = std::make_shared<trogdor::entity::Player>(
+			&game, "player", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		game.insertPlayer(player);
+
+		CHECK(hall == troll->selectWanderDestination());
+		CHECK(player == troll->getWanderTarget());
+		CHECK(den == bunny->selectWanderDestination());
+		CHECK(den == rat->selectWanderDestination());
+
+		move(troll, hall);
+		CHECK(start == troll->selectWanderDestination());
+
+		// Caught up
+		move(troll, start);
+		CHECK(!troll->selectWanderDestination());
+
+		// Cornered
+		move(bunny, den);
+		CHECK(!bunny->selectWanderDestination());
+
+		// Once a Creature has a target, it sticks with it
+		auto other = std::make_shared<trogdor::entity::Player>(
+			&game, "other", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		game.insertPlayer(other);
+		move(other, den);
+		move(troll, hall);
+
+		CHECK(start == troll->selectWanderDestination());
+		CHECK(player == troll->getWanderTarget());
+
+		// Until the target leaves the game
+		game.removePlayer("player");
+
+		CHECK(den == troll->selectWanderDestination());
+		CHECK(other == troll->getWanderTarget());
+
+		// Targets don't have to be Players
+		troll->setWanderTarget(bunny);
+		move(bunny, start);
+
+		CHECK(start == troll->selectWanderDestination());
+		CHECK(bunny == troll->getWanderTarget());
+	}
+
+	TEST_CASE("Creature (entities/creature.cpp): Players and Rooms coming and going while Creatures wander") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		auto start = trogdor::entity::makeMockRoom(game, "start");
+		auto hall = trogdor::entity::makeMockRoom(game, "hall");
+
+		start->setConnection("east", hall);
+		hall->setConnection("west", start);
+
+		std::vector<std::shared_ptr<trogdor::entity::Creature>> creatures;
+
+		for (size_t i = 0; i < 4; i++) {
+
+			auto creature = std::make_shared<trogdor::entity::Creature>(
+				&game, "creature" + std::to_string(i), std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+			);
+
+			game.insertEntity(creature->getName(), creature);
+			creature->setProperty(trogdor::entity::PROPERTY_SLOT_WANDER_MODE, static_cast<int>(
+				i % 2 ? trogdor::entity::Creature::WANDER_FLEE : trogdor::entity::Creature::WANDER_PURSUE
+			));
+
+			hall->insertThing(creature);
+			creatures.push_back(creature);
+		}
+
+		// Stands in for the timer thread
+		std::atomic<bool> done{false};
+
+		std::thread wanderer([&] {
+			while (!done) {
+				for (const auto &creature: creatures) {
+					creature->selectWanderDestination();
+				}
+			}
+		});
+
+		for (size_t i = 0; i < 200; i++) {
+
+			auto player = std::make_shared<trogdor::entity::Player>(
+				&game, "player" + std::to_string(i), std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+			);
+
+			game.insertPlayer(player);
+
+			// New Rooms make the graph rebuild itself on the other thread
+			auto annex = trogdor::entity::makeMockRoom(game, "annex" + std::to_string(i));
+
+			game.removePlayer(player->getName());
+			game.removeEntity(annex->getName());
+		}
+
+		done = true;
+		wanderer.join();
+
+		CHECK(0 == game.getPlayerSnapshot().size());
+		CHECK(2 == game.getRoomSnapshot().size());
+
+		// Nobody's left to chase, so they go back to wandering at random
+		for (const auto &creature: creatures) {
+			CHECK(start == creature->selectWanderDestination());
+			CHECK(!creature->getWanderTarget());
+		}
+	}
+
+	TEST_CASE("Creature (entities/creature.cpp): Inventory weight and aliases") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		auto makeObject = [&](std::string name, int weight) {
+
+			auto object = std::make_shared<trogdor::entity::Object>(
+				&game, name, std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+			);
+
+			object->setProperty(trogdor::entity::PROPERTY_SLOT_WEIGHT, weight);
+			return object;
+		};
+
+		auto troll = std::make_shared<trogdor::entity::Creature>(
+			&game, "troll", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		troll->setProperty(trogdor::entity::PROPERTY_SLOT_INV_MAX_WEIGHT, 10);
+
+		auto sword = makeObject("sword", 4);
+		auto axe = makeObject("axe", 3);
+		auto rock = makeObject("rock", 5);
+
+		sword->addAlias("weapon");
+		axe->addAlias("weapon");
+
+		CHECK(troll->insertIntoInventory(sword));
+		CHECK(troll->insertIntoInventory(axe));
+		CHECK(7 == troll->getInventoryCurWeight());
+
+		// Too heavy, unless weight isn't being considered
+		CHECK(!troll->insertIntoInventory(rock));
+		CHECK(7 == troll->getInventoryCurWeight());
+
+		// Items are kept in alphabetical order
+		REQUIRE(2 == troll->getInventoryObjects().size());
+		CHECK(axe == troll->getInventoryObjects()[0].second.lock());
+		CHECK(sword == troll->getInventoryObjects()[1].second.lock());
+		CHECK(2 == troll->getInventoryObjectsByName("weapon").size());
+
+		// Aliases added after an Object was picked up are indexed too
+		sword->addAlias("blade");
+		REQUIRE(1 == troll->getInventoryObjectsByName("blade").size());
+		CHECK(sword == troll->getInventoryObjectsByName("blade")[0].lock());
+
+		// Changing an Object's weight while it's being carried updates the
+		// total
+		sword->setProperty(trogdor::entity::PROPERTY_SLOT_WEIGHT, 2);
+		CHECK(5 == troll->getInventoryCurWeight());
+		CHECK(troll->insertIntoInventory(rock));
+		CHECK(10 == troll->getInventoryCurWeight());
+
+		troll->removeFromInventory(axe);
+		CHECK(7 == troll->getInventoryCurWeight());
+		CHECK(!axe->getOwner().lock());
+		CHECK(1 == troll->getInventoryObjectsByName("weapon").size());
+		CHECK(0 == troll->getInventoryObjectsByName("axe").size());
+
+		// Once it's been dropped, its weight no longer matters
+		axe->setProperty(trogdor::entity::PROPERTY_SLOT_WEIGHT, 1);
+		CHECK(7 == troll->getInventoryCurWeight());
+
+		// Removing something that isn't there does nothing
+		troll->removeFromInventory(axe);
+		CHECK(7 == troll->getInventoryCurWeight());
+		CHECK(2 == troll->getInventoryObjects().size());
+	}
+}
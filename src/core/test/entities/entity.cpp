@@ -1,8 +1,12 @@
 #include <doctest.h>
 
+#include <regex>
+
 #include <trogdor/iostream/nullout.h>
 #include <trogdor/iostream/nullerr.h>
 
+#include <trogdor/entities/object.h>
+
 #include "../mock/mockentity.h"
 
 
@@ -125,4 +129,133 @@ TEST_SUITE("Entity (entities/entity.cpp)") {
 		CHECK(-1 == status);
 		CHECK(!testEntity.isPropertySet("intValidated"));
 	}
+
+	TEST_CASE("Entity (entities/entity.cpp): Built-in properties are stored in slots") {
+
+		trogdor::Game mockGame(std::make_unique<trogdor::NullErr>());
+		trogdor::entity::MockEntity testEntity(&mockGame, "test");
+
+		// Every built-in property name maps to a slot and back again
+		for (int i = 0; i < trogdor::entity::NUM_PROPERTY_SLOTS; i++) {
+
+			auto slot = static_cast<trogdor::entity::PropertySlot>(i);
+			auto lookup = trogdor::entity::strToPropertySlot(trogdor::entity::propertySlotToStr(slot));
+
+			CHECK(lookup.has_value());
+			CHECK(slot == *lookup);
+		}
+
+		CHECK(!trogdor::entity::strToPropertySlot("custom").has_value());
+
+		// Setting a property by name or by slot refers to the same value
+		testEntity.setProperty(trogdor::entity::Entity::TitleProperty, "A Title");
+
+		CHECK(testEntity.isPropertySet(trogdor::entity::PROPERTY_SLOT_TITLE));
+		CHECK(0 == testEntity.getProperty<std::string>(trogdor::entity::PROPERTY_SLOT_TITLE).compare("A Title"));
+
+		testEntity.setProperty(trogdor::entity::PROPERTY_SLOT_TITLE, "Another Title");
+		CHECK(0 == testEntity.getPropertyRef<std::string>(trogdor::entity::Entity::TitleProperty).compare("Another Title"));
+
+		// getPropertyRef() requires an exact type match
+		testEntity.setProperty(trogdor::entity::PROPERTY_SLOT_WEIGHT, 5);
+		CHECK(5 == testEntity.getPropertyRef<int>(trogdor::entity::PROPERTY_SLOT_WEIGHT));
+		CHECK(5.0 == testEntity.getProperty<double>(trogdor::entity::PROPERTY_SLOT_WEIGHT));
+		CHECK_THROWS_AS(testEntity.getPropertyRef<double>(trogdor::entity::PROPERTY_SLOT_WEIGHT), std::bad_variant_access);
+
+		testEntity.removeProperty(trogdor::entity::Object::WeightProperty);
+		CHECK(!testEntity.isPropertySet(trogdor::entity::PROPERTY_SLOT_WEIGHT));
+		CHECK_THROWS_AS(testEntity.getProperty<int>(trogdor::entity::PROPERTY_SLOT_WEIGHT), std::invalid_argument);
+
+		// Custom properties live alongside the built-in ones
+		testEntity.setProperty("custom", 7);
+
+		size_t count = 0;
+
+		testEntity.forEachProperty([&](const std::string &key, const trogdor::entity::Entity::PropertyValue &value) {
+			count++;
+		});
+
+		CHECK(2 == count);
+		CHECK(2 == testEntity.getPropertyCount());
+
+		auto properties = testEntity.getProperties();
+
+		CHECK(2 == properties.size());
+		CHECK(properties.end() != properties.find(trogdor::entity::Entity::TitleProperty));
+		CHECK(7 == std::get<int>(properties["custom"]));
+	}
+
+	TEST_CASE("Entity (entities/entity.cpp): Copies share prototype data until it's modified") {
+
+		trogdor::Game mockGame(std::make_unique<trogdor::NullErr>());
+
+		trogdor::entity::Object prototype(&mockGame, "prototype", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>());
+
+		prototype.setProperty(trogdor::entity::PROPERTY_SLOT_LONG_DESC, "A shiny thing.");
+		prototype.setTag("shiny");
+		prototype.setMessage("greeting", "Hello.");
+
+		trogdor::entity::Object first(prototype, "first");
+		trogdor::entity::Object second(prototype, "second");
+
+		// Until something changes, all three read the very same value
+		const std::string &desc = prototype.getPropertyRef<std::string>(trogdor::entity::PROPERTY_SLOT_LONG_DESC);
+
+		CHECK(&desc == &first.getPropertyRef<std::string>(trogdor::entity::PROPERTY_SLOT_LONG_DESC));
+		CHECK(&desc == &second.getPropertyRef<std::string>(trogdor::entity::PROPERTY_SLOT_LONG_DESC));
+
+		// Writing to a copy gives it its own data and leaves the rest alone
+		first.setProperty(trogdor::entity::PROPERTY_SLOT_LONG_DESC, "A dull thing.");
+		first.setTag("dull");
+		first.removeTag("shiny");
+		first.setMessage("greeting", "Go away.");
+
+		CHECK(0 == first.getProperty<std::string>(trogdor::entity::PROPERTY_SLOT_LONG_DESC).compare("A dull thing."));
+		CHECK(0 == prototype.getProperty<std::string>(trogdor::entity::PROPERTY_SLOT_LONG_DESC).compare("A shiny thing."));
+		CHECK(0 == second.getProperty<std::string>(trogdor::entity::PROPERTY_SLOT_LONG_DESC).compare("A shiny thing."));
+		CHECK(&desc == &second.getPropertyRef<std::string>(trogdor::entity::PROPERTY_SLOT_LONG_DESC));
+
+		CHECK(first.isTagSet("dull"));
+		CHECK(!first.isTagSet("shiny"));
+		CHECK(prototype.isTagSet("shiny"));
+		CHECK(!prototype.isTagSet("dull"));
+		CHECK(second.isTagSet("shiny"));
+
+		CHECK(0 == first.getMessage("greeting").compare("Go away."));
+		CHECK(0 == prototype.getMessage("greeting").compare("Hello."));
+		CHECK(0 == second.getMessage("greeting").compare("Hello."));
+
+		// Modifying the prototype doesn't leak into copies made from it
+		prototype.setProperty(trogdor::entity::PROPERTY_SLOT_DAMAGE, 10);
+
+		CHECK(10 == prototype.getProperty<int>(trogdor::entity::PROPERTY_SLOT_DAMAGE));
+		CHECK(10 != second.getProperty<int>(trogdor::entity::PROPERTY_SLOT_DAMAGE));
+
+		// Text is pooled, so the prototype's copy of its properties still
+		// shares its description with the copies
+		CHECK(&desc == &prototype.getPropertyRef<std::string>(trogdor::entity::PROPERTY_SLOT_LONG_DESC));
+
+		// Validators are shared too and still apply to copies
+		CHECK(trogdor::entity::Entity::PROPERTY_INVALID_TYPE == second.setProperty(trogdor::entity::PROPERTY_SLOT_DAMAGE, "sharp"));
+	}
+
+	TEST_CASE("Entity (entities/entity.cpp): isNameValid() agrees with validEntityNameRegex") {
+
+		std::regex validName(trogdor::entity::validEntityNameRegex);
+
+		for (int c = 0; c < 256; c++) {
+
+			std::string name(1, static_cast<char>(c));
+			CHECK(std::regex_match(name, validName) == trogdor::entity::Entity::isNameValid(name));
+		}
+
+		CHECK(trogdor::entity::Entity::isNameValid("Trogdor-the_Burninator 2"));
+		CHECK(trogdor::entity::Entity::isNameValid("rusty  sword"));
+		CHECK(!trogdor::entity::Entity::isNameValid(""));
+		CHECK(!trogdor::entity::Entity::isNameValid("sword!"));
+		CHECK(!trogdor::entity::Entity::isNameValid(std::string("nul\0byte", 8)));
+
+		// Reserved names are never valid
+		CHECK(!trogdor::entity::Entity::isNameValid("myself"));
+	}
 }
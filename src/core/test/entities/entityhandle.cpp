@@ -0,0 +1,145 @@
+#include <doctest.h>
+
+#include <trogdor/game.h>
+#include <trogdor/entities/room.h>
+#include <trogdor/entities/object.h>
+#include <trogdor/entities/entityhandle.h>
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+#include "../mock/mockgame.h"
+
+
+TEST_SUITE("EntityHandle (entities/entityhandle.cpp)") {
+
+	TEST_CASE("EntityHandle (entities/entityhandle.cpp): EntityHandleTable") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+		trogdor::entity::EntityHandleTable table;
+
+		trogdor::entity::Object sword(&game, "sword", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>());
+		trogdor::entity::Object shield(&game, "shield", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>());
+
+		// Null handles never resolve
+		CHECK(trogdor::entity::EntityHandle().isNull());
+		CHECK(nullptr == table.resolve({}));
+
+		trogdor::entity::EntityHandle swordHandle = table.insert(&sword);
+
+		CHECK(!swordHandle.isNull());
+		CHECK(&sword == table.resolve(swordHandle));
+		CHECK(1 == table.size());
+
+		// Once removed, the old handle stops resolving, even after its slot
+		// is reused
+		table.remove(swordHandle);
+		CHECK(nullptr == table.resolve(swordHandle));
+		CHECK(0 == table.size());
+
+		trogdor::entity::EntityHandle shieldHandle = table.insert(&shield);
+
+		CHECK(swordHandle.index == shieldHandle.index);
+		CHECK(swordHandle != shieldHandle);
+		CHECK(nullptr == table.resolve(swordHandle));
+		CHECK(&shield == table.resolve(shieldHandle));
+
+		// Restoring a previously issued handle
+		trogdor::entity::EntityHandle restored = {5, 3};
+
+		CHECK(table.insert(restored, &sword));
+		CHECK(&sword == table.resolve(restored));
+		CHECK(!table.insert(restored, &shield));
+		CHECK(2 == table.size());
+
+		// Slots skipped over to restore the handle are reused first
+		trogdor::entity::EntityHandle next = table.insert(&shield);
+		CHECK(next.index < 5);
+	}
+
+	TEST_CASE("EntityHandle (entities/entityhandle.cpp): Restoring handles out of order") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+		trogdor::entity::EntityHandleTable table;
+
+		std::vector<std::unique_ptr<trogdor::entity::Object>> objects;
+
+		for (int i = 0; i < 100; i++) {
+			objects.push_back(std::make_unique<trogdor::entity::Object>(
+				&game, "object" + std::to_string(i), std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+			));
+		}
+
+		// Every even slot, highest first, so that the first restore skips
+		// over everything below it
+		for (int i = 98; i >= 0; i -= 2) {
+			CHECK(table.insert({static_cast<uint32_t>(i), 2}, objects[i].get()));
+		}
+
+		CHECK(50 == table.size());
+
+		for (int i = 0; i < 100; i += 2) {
+			CHECK(objects[i].get() == table.resolve({static_cast<uint32_t>(i), 2}));
+		}
+
+		// The odd slots are all that's left to reuse, each of them once
+		std::vector<bool> reused(100, false);
+
+		for (int i = 1; i < 100; i += 2) {
+
+			trogdor::entity::EntityHandle handle = table.insert(objects[i].get());
+
+			REQUIRE(handle.index < 100);
+			CHECK(1 == handle.index % 2);
+			CHECK(!reused[handle.index]);
+
+			reused[handle.index] = true;
+		}
+
+		CHECK(100 == table.size());
+		CHECK(100 == table.insert(objects[0].get()).index);
+
+		// Restoring into a slot that's been freed again
+		table.remove({10, 2});
+		CHECK(table.insert({10, 7}, objects[10].get()));
+		CHECK(objects[10].get() == table.resolve({10, 7}));
+		CHECK(101 == table.size());
+	}
+
+	TEST_CASE("EntityHandle (entities/entityhandle.cpp): Handles issued by Game") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		std::shared_ptr<trogdor::entity::Room> start = std::make_shared<trogdor::entity::Room>(
+			&game, "start", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		std::shared_ptr<trogdor::entity::Object> sword = std::make_shared<trogdor::entity::Object>(
+			&game, "sword", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		CHECK(sword->getHandle().isNull());
+
+		game.insertEntity("start", start);
+		game.insertEntity("sword", sword);
+
+		trogdor::entity::EntityHandle swordHandle = sword->getHandle();
+
+		CHECK(!swordHandle.isNull());
+		CHECK(sword.get() == game.getEntity(swordHandle));
+		CHECK(start.get() == game.getEntity(start->getHandle()));
+
+		// Handles survive serialization
+		auto restored = trogdor::restoreGame(game);
+
+		REQUIRE(restored->getEntity("sword"));
+		CHECK(swordHandle == restored->getEntity("sword")->getHandle());
+		CHECK(restored->getEntity("sword").get() == restored->getEntity(swordHandle));
+
+		// Removing the Entity invalidates its handle
+		game.removeEntity("sword");
+
+		CHECK(sword->getHandle().isNull());
+		CHECK(nullptr == game.getEntity(swordHandle));
+	}
+}
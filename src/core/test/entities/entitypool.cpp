@@ -0,0 +1,228 @@
+#include <doctest.h>
+
+#include <trogdor/game.h>
+#include <trogdor/lua/luastate.h>
+#include <trogdor/entities/entitypool.h>
+
+#include <trogdor/entities/room.h>
+#include <trogdor/entities/object.h>
+#include <trogdor/entities/creature.h>
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+#include "../mock/mockgame.h"
+
+
+TEST_SUITE("EntityPool (entities/entitypool.cpp)") {
+
+	TEST_CASE("EntityPool (entities/entitypool.cpp): create(), destroy() and block reuse") {
+
+		trogdor::entity::EntityPool pool(2);
+
+		trogdor::entity::Object *first = pool.create<trogdor::entity::Object>(
+			nullptr,
+			"first",
+			std::make_unique<trogdor::NullOut>(),
+			std::make_unique<trogdor::NullErr>()
+		);
+
+		trogdor::entity::Object *second = pool.create<trogdor::entity::Object>(
+			nullptr,
+			"second",
+			std::make_unique<trogdor::NullOut>(),
+			std::make_unique<trogdor::NullErr>()
+		);
+
+		CHECK("first" == first->getName());
+		CHECK("second" == second->getName());
+
+		auto occupancy = pool.getOccupancy(trogdor::entity::ENTITY_OBJECT);
+
+		CHECK(2 == occupancy.inUse);
+		CHECK(2 == occupancy.capacity);
+		CHECK(occupancy.blockSize >= sizeof(trogdor::entity::Object));
+
+		// Types that haven't been allocated yet are empty
+		CHECK(0 == pool.getOccupancy(trogdor::entity::ENTITY_CREATURE).capacity);
+
+		// Freed blocks should be handed out again before the pool grows
+		void *freed = second;
+		pool.destroy(second);
+
+		CHECK(1 == pool.getOccupancy(trogdor::entity::ENTITY_OBJECT).inUse);
+
+		trogdor::entity::Object *third = pool.create<trogdor::entity::Object>(
+			nullptr,
+			"third",
+			std::make_unique<trogdor::NullOut>(),
+			std::make_unique<trogdor::NullErr>()
+		);
+
+		CHECK(freed == static_cast<void *>(third));
+		CHECK(2 == pool.getOccupancy(trogdor::entity::ENTITY_OBJECT).capacity);
+
+		pool.destroy(first);
+		pool.destroy(third);
+
+		CHECK(0 == pool.getOccupancy(trogdor::entity::ENTITY_OBJECT).inUse);
+	}
+
+	TEST_CASE("EntityPool (entities/entitypool.cpp): Failed construction returns the block") {
+
+		trogdor::entity::EntityPool pool;
+
+		// Invalid names cause the Entity's constructor to throw
+		CHECK_THROWS(pool.create<trogdor::entity::Creature>(
+			nullptr,
+			"invalid!name",
+			std::make_unique<trogdor::NullOut>(),
+			std::make_unique<trogdor::NullErr>()
+		));
+
+		CHECK(0 == pool.getOccupancy(trogdor::entity::ENTITY_CREATURE).inUse);
+	}
+
+	TEST_CASE("EntityPool (entities/entitypool.cpp): reserve()") {
+
+		trogdor::entity::EntityPool pool;
+
+		pool.reserve(trogdor::entity::ENTITY_CREATURE, 100);
+		CHECK(100 <= pool.getOccupancy(trogdor::entity::ENTITY_CREATURE).capacity);
+		CHECK(0 == pool.getOccupancy(trogdor::entity::ENTITY_CREATURE).inUse);
+
+		CHECK_THROWS(pool.reserve(trogdor::entity::ENTITY_PLAYER, 1));
+	}
+
+	TEST_CASE("EntityPool (entities/entitypool.cpp): share() outlives the pool's owner") {
+
+		std::shared_ptr<trogdor::entity::Entity> shared;
+
+		{
+			auto pool = std::make_shared<trogdor::entity::EntityPool>();
+
+			trogdor::entity::Object *o = pool->create<trogdor::entity::Object>(
+				nullptr,
+				"sword",
+				std::make_unique<trogdor::NullOut>(),
+				std::make_unique<trogdor::NullErr>()
+			);
+
+			shared = trogdor::entity::EntityPool::share(pool, o);
+			CHECK(1 == pool->getOccupancy(trogdor::entity::ENTITY_OBJECT).inUse);
+		}
+
+		// The deleter keeps the pool alive until the Entity is released
+		CHECK("sword" == shared->getName());
+		CHECK(shared == shared->getShared());
+
+		shared.reset();
+	}
+
+	TEST_CASE("EntityPool (entities/entitypool.cpp): Lua garbage collection and insertion into the game") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+		auto &L = game.getLuaState();
+
+		L->loadScriptFromString(
+			"function makeGarbage()\n"
+			"   for i = 1, 10 do Object.new('junk' .. i) end\n"
+			"   collectgarbage('collect')\n"
+			"   collectgarbage('collect')\n"
+			"   return 0\n"
+			"end\n"
+			"function keep()\n"
+			"   local o = Object.new('keeper')\n"
+			"   if not game:insert(o) then return 1 end\n"
+			"   if game:insert(Object.new('keeper')) then return 2 end\n"
+			"   return 0\n"
+			"end\n"
+			"function collect()\n"
+			"   collectgarbage('collect')\n"
+			"   collectgarbage('collect')\n"
+			"   return 0\n"
+			"end\n"
+		);
+
+		L->call("makeGarbage");
+		L->execute(1);
+
+		auto occupancy = game.getEntityPoolOccupancy()[trogdor::entity::ENTITY_OBJECT];
+
+		CHECK(0 == occupancy.inUse);
+		CHECK(occupancy.capacity > 0);
+
+		L->call("keep");
+		L->execute(1);
+		CHECK(0 == L->getNumber(0));
+
+		L->call("collect");
+		L->execute(1);
+
+		// The inserted Object belongs to the game now, so garbage collection
+		// should only have reclaimed the duplicate
+		REQUIRE(nullptr != game.getObject("keeper"));
+		CHECK("keeper" == game.getObject("keeper")->getName());
+		CHECK(1 == game.getEntityPoolOccupancy()[trogdor::entity::ENTITY_OBJECT].inUse);
+	}
+
+	TEST_CASE("EntityPool (entities/entitypool.cpp): make() and memory usage") {
+
+		auto pool = std::make_shared<trogdor::entity::EntityPool>(4);
+
+		CHECK(0 == pool->getMemoryUsage().bytesInUse);
+		CHECK(0 == pool->getMemoryUsage().bytesReserved);
+
+		std::shared_ptr<trogdor::entity::Object> sword = trogdor::entity::EntityPool::make<trogdor::entity::Object>(
+			pool,
+			nullptr,
+			"sword",
+			std::make_unique<trogdor::NullOut>(),
+			std::make_unique<trogdor::NullErr>()
+		);
+
+		auto occupancy = pool->getOccupancy(trogdor::entity::ENTITY_OBJECT);
+		auto usage = pool->getMemoryUsage();
+
+		CHECK("sword" == sword->getName());
+		CHECK(1 == occupancy.inUse);
+		CHECK(occupancy.blockSize == usage.bytesInUse);
+		CHECK(4 * occupancy.blockSize == usage.bytesReserved);
+
+		sword.reset();
+
+		CHECK(0 == pool->getMemoryUsage().bytesInUse);
+		CHECK(usage.bytesReserved == pool->getMemoryUsage().bytesReserved);
+	}
+
+	TEST_CASE("EntityPool (entities/entitypool.cpp): Entities created by the game come from its pool") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		CHECK(game.getEntityPoolOccupancy().empty());
+
+		game.insertEntity("start", game.makeEntity<trogdor::entity::Room>(
+			&game, "start", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		));
+
+		game.insertEntity("sword", game.makeEntity<trogdor::entity::Object>(
+			&game, "sword", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		));
+
+		CHECK(1 == game.getEntityPoolOccupancy()[trogdor::entity::ENTITY_ROOM].inUse);
+		CHECK(1 == game.getEntityPoolOccupancy()[trogdor::entity::ENTITY_OBJECT].inUse);
+		CHECK(game.getEntityMemoryUsage().bytesInUse >= sizeof(trogdor::entity::Room) + sizeof(trogdor::entity::Object));
+
+		// Lua scripts allocate from the same pool
+		CHECK(game.getLuaState()->getEntityPool() == game.getEntityPool());
+
+		// Deserialized Entities are pooled too
+		auto restored = trogdor::restoreGame(game);
+
+		CHECK(1 == restored->getEntityPoolOccupancy()[trogdor::entity::ENTITY_ROOM].inUse);
+		CHECK(1 == restored->getEntityPoolOccupancy()[trogdor::entity::ENTITY_OBJECT].inUse);
+
+		game.removeEntity("sword");
+		CHECK(0 == game.getEntityPoolOccupancy()[trogdor::entity::ENTITY_OBJECT].inUse);
+	}
+}
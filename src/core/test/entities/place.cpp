@@ -0,0 +1,163 @@
+#include <doctest.h>
+
+#include <algorithm>
+
+#include <trogdor/entities/room.h>
+#include <trogdor/entities/object.h>
+#include <trogdor/entities/creature.h>
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+
+TEST_SUITE("Place (entities/place.cpp)") {
+
+	TEST_CASE("Place (entities/place.cpp): Inserting and removing Things") {
+
+		trogdor::Game mockGame(std::make_unique<trogdor::NullErr>());
+
+		auto room = std::make_shared<trogdor::entity::Room>(
+			&mockGame, "square", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		std::vector<std::shared_ptr<trogdor::entity::Creature>> townsfolk;
+		std::vector<std::shared_ptr<trogdor::entity::Object>> carts;
+
+		for (int i = 0; i < 10; i++) {
+
+			townsfolk.push_back(std::make_shared<trogdor::entity::Creature>(
+				&mockGame, "peasant" + std::to_string(i), std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+			));
+
+			carts.push_back(std::make_shared<trogdor::entity::Object>(
+				&mockGame, "cart" + std::to_string(i), std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+			));
+
+			townsfolk.back()->addAlias("peasant");
+			carts.back()->addAlias("cart");
+
+			room->insertCreature(townsfolk.back());
+			room->insertObject(carts.back());
+		}
+
+		CHECK(20 == room->getThings().size());
+		CHECK(10 == room->getBeings().size());
+		CHECK(10 == room->getCreatures().size());
+		CHECK(10 == room->getObjects().size());
+		CHECK(10 == room->getThingsByName("peasant").size());
+		CHECK(10 == room->getBeingsByName("peasant").size());
+		CHECK(10 == room->getThingsByName("cart").size());
+		CHECK(room->getBeingsByName("cart").empty());
+
+		// Remove from the front, the middle, and the back
+		for (int i: {0, 5, 9}) {
+
+			room->removeCreature(townsfolk[i]);
+			room->removeObject(carts[i]);
+
+			CHECK(!townsfolk[i]->getLocation().lock());
+			CHECK(!carts[i]->getLocation().lock());
+		}
+
+		CHECK(14 == room->getThings().size());
+		CHECK(7 == room->getBeings().size());
+		CHECK(7 == room->getCreatures().size());
+		CHECK(7 == room->getObjects().size());
+		CHECK(7 == room->getThingsByName("peasant").size());
+		CHECK(7 == room->getThingsByName("cart").size());
+		CHECK(room->getThingsByName("peasant0").empty());
+		CHECK(1 == room->getThingsByName("peasant1").size());
+
+		// Everything that's left is still where the Place thinks it is
+		for (int i = 0; i < 10; i++) {
+
+			bool removed = 0 == i || 5 == i || 9 == i;
+			const auto &creatures = room->getCreatures();
+			const auto &things = room->getThings();
+
+			CHECK(removed == (creatures.end() == std::find(creatures.begin(), creatures.end(), townsfolk[i])));
+			CHECK(removed == (things.end() == std::find(things.begin(), things.end(), carts[i])));
+		}
+
+		// Removing something that isn't there does nothing
+		room->removeObject(carts[0]);
+		CHECK(14 == room->getThings().size());
+
+		// Things can be removed and inserted again
+		room->removeThing(townsfolk[1]);
+		room->insertThing(townsfolk[1]);
+
+		CHECK(14 == room->getThings().size());
+		CHECK(7 == room->getBeingsByName("peasant").size());
+		CHECK(room.get() == townsfolk[1]->getLocation().lock().get());
+
+		// Every alias list still holds exactly what's left in the Place
+		for (int i = 0; i < 10; i++) {
+
+			bool removed = 0 == i || 5 == i || 9 == i;
+			const auto &peasants = room->getThingsByName("peasant");
+			const auto &beings = room->getBeingsByName("peasant");
+			const auto &cartList = room->getThingsByName("cart");
+
+			CHECK(removed == (peasants.end() == std::find(peasants.begin(), peasants.end(), townsfolk[i].get())));
+			CHECK(removed == (beings.end() == std::find(beings.begin(), beings.end(), townsfolk[i].get())));
+			CHECK(removed == (cartList.end() == std::find(cartList.begin(), cartList.end(), carts[i].get())));
+		}
+
+		// A Thing given a new alias after it was inserted can still be removed
+		carts[2]->addAlias("wagon");
+		room->removeObject(carts[2]);
+
+		CHECK(6 == room->getThingsByName("cart").size());
+		CHECK(room->getThingsByName("wagon").empty());
+	}
+
+	TEST_CASE("Place (entities/place.cpp): Preserving insertion order") {
+
+		trogdor::Game mockGame(std::make_unique<trogdor::NullErr>());
+
+		auto room = std::make_shared<trogdor::entity::Room>(
+			&mockGame, "square", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		CHECK(!room->getPreserveOrder());
+		room->setPreserveOrder(true);
+		CHECK(room->getPreserveOrder());
+
+		std::vector<std::shared_ptr<trogdor::entity::Object>> carts;
+
+		for (int i = 0; i < 6; i++) {
+
+			carts.push_back(std::make_shared<trogdor::entity::Object>(
+				&mockGame, "cart" + std::to_string(i), std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+			));
+
+			carts.back()->addAlias("cart");
+			room->insertObject(carts.back());
+		}
+
+		room->removeObject(carts[0]);
+		room->removeObject(carts[3]);
+
+		std::vector<std::shared_ptr<trogdor::entity::Object>> expected = {carts[1], carts[2], carts[4], carts[5]};
+
+		CHECK(expected == room->getObjects());
+		CHECK(4 == room->getThings().size());
+
+		for (size_t i = 0; i < expected.size(); i++) {
+			CHECK(expected[i].get() == room->getThings()[i].get());
+			CHECK(expected[i].get() == room->getThingsByName("cart")[i]);
+		}
+
+		// Positions are still right after the shift
+		room->removeObject(carts[5]);
+		room->removeObject(carts[1]);
+
+		expected = {carts[2], carts[4]};
+		CHECK(expected == room->getObjects());
+
+		// The setting is copied along with the Place
+		trogdor::entity::Room copy(*room, "copy");
+		CHECK(copy.getPreserveOrder());
+	}
+}
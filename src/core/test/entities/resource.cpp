@@ -6,6 +6,8 @@
 #include <trogdor/iostream/nullout.h>
 #include <trogdor/iostream/nullerr.h>
 
+#include "../mock/mockroom.h"
+
 
 // TODO: make sure to verify a test case where allocations have been made, and
 // then we copy and verify that those allocations/depositors don't exist in the
@@ -654,4 +656,95 @@ TEST_SUITE("Resource (entities/resource.cpp)") {
 			CHECK(trogdor::entity::Resource::ALLOCATE_OR_FREE_SUCCESS == allocStatus);
 		}
 	}
+
+	TEST_CASE("Resource (entities/resource.cpp): transfer() and transferMany()") {
+
+		trogdor::Game mockGame(std::make_unique<trogdor::NullErr>());
+
+		// 10 gold available, nobody can hold more than 6, and only whole coins
+		std::shared_ptr<trogdor::entity::Resource> testResource =
+		std::make_shared<trogdor::entity::Resource>(&mockGame, "gold", 10.0, 6.0, true);
+
+		std::shared_ptr<trogdor::entity::Room> bank = trogdor::entity::makeMockRoom(mockGame, "bank", false);
+		std::shared_ptr<trogdor::entity::Room> market = trogdor::entity::makeMockRoom(mockGame, "market", false);
+		std::shared_ptr<trogdor::entity::Room> tavern = trogdor::entity::makeMockRoom(mockGame, "tavern", false);
+
+		CHECK(trogdor::entity::Resource::ALLOCATE_OR_FREE_SUCCESS == testResource->allocate(bank, 6));
+		CHECK(trogdor::entity::Resource::ALLOCATE_OR_FREE_SUCCESS == testResource->allocate(market, 4));
+
+		// A failed transfer leaves both balances alone
+		CHECK(trogdor::entity::Resource::ALLOCATE_MAX_PER_DEPOSITOR_EXCEEDED == testResource->transfer(market, bank, 1));
+		CHECK(trogdor::entity::Resource::FREE_EXCEEDS_ALLOCATION == testResource->transfer(tavern, bank, 1));
+		CHECK(trogdor::entity::Resource::FREE_EXCEEDS_ALLOCATION == testResource->transfer(market, tavern, 5));
+		CHECK(trogdor::entity::Resource::FREE_INT_REQUIRED == testResource->transfer(market, tavern, 0.5));
+		CHECK(trogdor::entity::Resource::FREE_NEGATIVE_VALUE == testResource->transfer(market, tavern, -1));
+		CHECK(6 == testResource->getAllocation(bank));
+		CHECK(4 == testResource->getAllocation(market));
+		CHECK(0 == testResource->getAllocation(tavern));
+
+		// Moving an allocation doesn't count against the total available even
+		// though all of it is already handed out
+		CHECK(trogdor::entity::Resource::ALLOCATE_OR_FREE_SUCCESS == testResource->transfer(bank, tavern, 2));
+		CHECK(4 == testResource->getAllocation(bank));
+		CHECK(2 == *tavern->getResourceAllocation(testResource));
+		CHECK(3 == testResource->getDepositors().size());
+		CHECK(10 == testResource->getTotalAmountAllocated());
+
+		// An amount of 0 hands over everything
+		CHECK(trogdor::entity::Resource::ALLOCATE_OR_FREE_SUCCESS == testResource->transfer(tavern, market, 0));
+		CHECK(6 == testResource->getAllocation(market));
+		CHECK(0 == testResource->getAllocation(tavern));
+		CHECK(!tavern->getResourceAllocation(testResource));
+		CHECK(0 == tavern->getResources().size());
+		CHECK(2 == testResource->getDepositors().size());
+
+		// The bank would end up with 7 if these were made one at a time, but
+		// only its net change counts
+		CHECK(trogdor::entity::Resource::ALLOCATE_OR_FREE_SUCCESS == testResource->transferMany({
+			{market, bank, 3},
+			{bank, tavern, 5},
+			{market, tavern, 0}
+		}));
+
+		CHECK(2 == testResource->getAllocation(bank));
+		CHECK(3 == testResource->getAllocation(market));
+		CHECK(5 == testResource->getAllocation(tavern));
+		CHECK(10 == testResource->getTotalAmountAllocated());
+
+		// If any part of a batch fails, none of it goes through
+		CHECK(trogdor::entity::Resource::FREE_EXCEEDS_ALLOCATION == testResource->transferMany({
+			{tavern, bank, 1},
+			{bank, market, 4}
+		}));
+
+		CHECK(trogdor::entity::Resource::ALLOCATE_MAX_PER_DEPOSITOR_EXCEEDED == testResource->transferMany({
+			{tavern, market, 2},
+			{bank, market, 2}
+		}));
+
+		CHECK(trogdor::entity::Resource::FREE_INT_REQUIRED == testResource->transferMany({
+			{tavern, market, 1},
+			{bank, market, 1.5}
+		}));
+
+		CHECK(2 == testResource->getAllocation(bank));
+		CHECK(3 == testResource->getAllocation(market));
+		CHECK(5 == testResource->getAllocation(tavern));
+
+		// Emptying a depositor in the middle of the table moves the last one
+		// into its place
+		CHECK(trogdor::entity::Resource::ALLOCATE_OR_FREE_SUCCESS == testResource->transferMany({
+			{bank, tavern, 1},
+			{bank, market, 1}
+		}));
+
+		CHECK(0 == testResource->getAllocation(bank));
+		CHECK(2 == testResource->getDepositors().size());
+		CHECK(4 == testResource->getAllocation(market));
+		CHECK(6 == testResource->getAllocation(tavern));
+
+		for (const auto &depositor: testResource->getDepositors()) {
+			CHECK(depositor.second == *depositor.first.lock()->getResourceAllocation(testResource));
+		}
+	}
 }
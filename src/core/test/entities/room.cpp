@@ -0,0 +1,83 @@
+#include <doctest.h>
+
+#include <set>
+
+#include <trogdor/entities/room.h>
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+#include "../mock/mockroom.h"
+
+
+TEST_SUITE("Room (entities/room.cpp)") {
+
+	TEST_CASE("Room (entities/room.cpp): Connections") {
+
+		trogdor::Game mockGame(std::make_unique<trogdor::NullErr>());
+		const trogdor::Vocabulary &vocabulary = mockGame.getVocabulary();
+
+		auto start = trogdor::entity::makeMockRoom(mockGame, "start", false);
+		auto cave = trogdor::entity::makeMockRoom(mockGame, "cave", false);
+		auto field = trogdor::entity::makeMockRoom(mockGame, "field", false);
+		auto attic = trogdor::entity::makeMockRoom(mockGame, "attic", false);
+
+		CHECK(0 == start->getNumConnections());
+		CHECK(!start->getConnectionByIndex(0));
+
+		start->setConnection("north", cave);
+		start->setConnection(*vocabulary.getDirectionId("east"), field);
+		start->setConnection("up", attic, "A ladder leads up.");
+
+		CHECK(3 == start->getNumConnections());
+		CHECK(cave == start->getConnection("north"));
+		CHECK(cave == start->getConnection(*vocabulary.getDirectionId("north")));
+		CHECK(field == start->getConnection("east"));
+		CHECK(!start->getConnection("west"));
+		CHECK(!start->getConnection("nonexistentDirection"));
+
+		// Synonyms resolve to the direction they refer to
+		CHECK(cave == start->getConnection("n"));
+
+		// Only real directions (not synonyms) can be used to connect rooms
+		CHECK_THROWS_AS(start->setConnection("sideways", cave), trogdor::ValidationException);
+		CHECK_THROWS_AS(start->setConnection("s", cave), trogdor::ValidationException);
+		CHECK_THROWS_AS(start->setConnection(vocabulary.getNumDirections(), cave), trogdor::ValidationException);
+
+		// Every connection can be reached by index
+		std::set<std::shared_ptr<trogdor::entity::Room>> reachable;
+
+		for (size_t i = 0; i < start->getNumConnections(); i++) {
+			reachable.insert(start->getConnectionByIndex(i));
+		}
+
+		CHECK(std::set<std::shared_ptr<trogdor::entity::Room>>({cave, field, attic}) == reachable);
+		CHECK(start->getConnectionByIndex(start->getNumConnections()));
+
+		// Replacing a connection doesn't add another one
+		start->setConnection("north", field);
+		CHECK(3 == start->getNumConnections());
+		CHECK(field == start->getConnection("north"));
+
+		// Connections to Rooms that no longer exist are removed
+		start->setConnection("south", trogdor::entity::makeMockRoom(mockGame, "temporary", false));
+
+		CHECK(4 == start->getNumConnections());
+		CHECK(!start->getConnection("south"));
+		CHECK(3 == start->getNumConnections());
+
+		for (size_t i = 0; i < start->getNumConnections(); i++) {
+			CHECK(start->getConnectionByIndex(i));
+		}
+
+		// Connections survive serialization
+		auto data = start->serialize();
+		auto connections = std::get<std::shared_ptr<trogdor::serial::Serializable>>(*data->get("connections"));
+		auto descriptions = std::get<std::shared_ptr<trogdor::serial::Serializable>>(*data->get("connectionDescriptions"));
+
+		CHECK(3 == connections->size());
+		CHECK(0 == std::get<std::string>(*connections->get("up")).compare("attic"));
+		CHECK(1 == descriptions->size());
+		CHECK(0 == std::get<std::string>(*descriptions->get("up")).compare("A ladder leads up."));
+	}
+}
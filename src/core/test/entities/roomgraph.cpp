@@ -0,0 +1,189 @@
+#include <doctest.h>
+
+#include <unordered_map>
+
+#include <trogdor/game.h>
+#include <trogdor/entities/room.h>
+#include <trogdor/entities/object.h>
+#include <trogdor/entities/roomgraph.h>
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+#include "../mock/mockroom.h"
+
+
+TEST_SUITE("RoomGraph (entities/roomgraph.cpp)") {
+
+	TEST_CASE("RoomGraph (entities/roomgraph.cpp): Distances, paths and components") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+		trogdor::entity::RoomGraph &graph = game.getRoomGraph();
+		const trogdor::Vocabulary &vocabulary = game.getVocabulary();
+
+		// a <-> b <-> c -> d, and e <-> f off on their own
+		auto a = trogdor::entity::makeMockRoom(game, "a");
+		auto b = trogdor::entity::makeMockRoom(game, "b");
+		auto c = trogdor::entity::makeMockRoom(game, "c");
+		auto d = trogdor::entity::makeMockRoom(game, "d");
+		auto e = trogdor::entity::makeMockRoom(game, "e");
+		auto f = trogdor::entity::makeMockRoom(game, "f");
+
+		a->setConnection("east", b);
+		b->setConnection("west", a);
+		b->setConnection("east", c);
+		c->setConnection("west", b);
+		c->setConnection("down", d);
+		e->setConnection("north", f);
+		f->setConnection("south", e);
+
+		CHECK(0 == *graph.getDistance(a.get(), a.get()));
+		CHECK(1 == *graph.getDistance(a.get(), b.get()));
+		CHECK(3 == *graph.getDistance(a.get(), d.get()));
+		CHECK(!graph.getDistance(d.get(), a.get()));
+		CHECK(!graph.getDistance(a.get(), e.get()));
+
+		auto step = graph.getNextStep(a.get(), d.get());
+
+		REQUIRE(step.has_value());
+		CHECK(*vocabulary.getDirectionId("east") == step->direction);
+		CHECK(b == step->room);
+		CHECK(!graph.getNextStep(a.get(), a.get()));
+		CHECK(!graph.getNextStep(d.get(), a.get()));
+
+		auto path = graph.getPath(a.get(), d.get());
+
+		REQUIRE(3 == path.size());
+		CHECK(b == path[0].room);
+		CHECK(c == path[1].room);
+		CHECK(d == path[2].room);
+		CHECK(*vocabulary.getDirectionId("down") == path[2].direction);
+		CHECK(graph.getPath(d.get(), a.get()).empty());
+
+		// Components are computed ignoring the direction of each connection
+		CHECK(2 == graph.getNumComponents());
+		CHECK(*graph.getComponent(a.get()) == *graph.getComponent(d.get()));
+		CHECK(*graph.getComponent(a.get()) != *graph.getComponent(e.get()));
+
+		// Visit every Room that can reach d
+		std::unordered_map<trogdor::entity::Room *, size_t> distances;
+
+		graph.forEachDistanceTo(d.get(), [&](const std::shared_ptr<trogdor::entity::Room> &room, size_t distance, auto step) {
+			CHECK(step.has_value() == (room != d));
+			distances[room.get()] = distance;
+		});
+
+		CHECK(4 == distances.size());
+		CHECK(3 == distances[a.get()]);
+		CHECK(2 == distances[b.get()]);
+		CHECK(1 == distances[c.get()]);
+		CHECK(0 == distances[d.get()]);
+
+		// Rows are cached until the graph changes
+		CHECK(graph.getNumCachedRows() > 0);
+
+		// Adding a connection only updates the Room it's on
+		d->setConnection("up", c);
+		d->setConnection("east", e);
+
+		CHECK(0 == graph.getNumCachedRows());
+		CHECK(3 == *graph.getDistance(d.get(), a.get()));
+		CHECK(5 == *graph.getDistance(a.get(), f.get()));
+		CHECK(1 == graph.getNumComponents());
+
+		// Replacing a connection takes the old one out of the graph
+		c->setConnection("west", d);
+		CHECK(!graph.getDistance(c.get(), a.get()));
+		CHECK(!graph.getDistance(d.get(), a.get()));
+
+		// Rooms that aren't part of the game aren't part of the graph
+		auto outside = std::make_shared<trogdor::entity::Room>(
+			&game, "outside", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		outside->setConnection("north", a);
+		CHECK(!graph.getDistance(outside.get(), a.get()));
+		CHECK(!graph.getComponent(outside.get()));
+
+		// Inserting and removing Rooms rebuilds the graph
+		game.insertEntity("outside", outside);
+		CHECK(1 == *graph.getDistance(outside.get(), a.get()));
+
+		game.removeEntity("b");
+		CHECK(!graph.getDistance(a.get(), c.get()));
+		CHECK(!graph.getDistance(outside.get(), c.get()));
+		CHECK(2 == graph.getNumComponents());
+
+		// The cache never grows past its limit
+		graph.setMaxCachedRows(2);
+
+		for (const auto &room: {a, c, d, e, f}) {
+			graph.getDistance(a.get(), room.get());
+		}
+
+		CHECK(2 == graph.getNumCachedRows());
+	}
+
+	TEST_CASE("RoomGraph (entities/roomgraph.cpp): Following targets that move") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+		trogdor::entity::RoomGraph &graph = game.getRoomGraph();
+
+		// a <-> b <-> c <-> d, plus a one-way exit from a to e
+		auto a = trogdor::entity::makeMockRoom(game, "a");
+		auto b = trogdor::entity::makeMockRoom(game, "b");
+		auto c = trogdor::entity::makeMockRoom(game, "c");
+		auto d = trogdor::entity::makeMockRoom(game, "d");
+		auto e = trogdor::entity::makeMockRoom(game, "e");
+
+		a->setConnection("east", b);
+		b->setConnection("west", a);
+		b->setConnection("east", c);
+		c->setConnection("west", b);
+		c->setConnection("east", d);
+		d->setConnection("west", c);
+		a->setConnection("down", e);
+
+		auto beacon = std::make_shared<trogdor::entity::Object>(
+			&game, "beacon", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		game.insertEntity("beacon", beacon);
+		d->insertThing(beacon);
+
+		CHECK(3 == *graph.getDistanceTo(a.get(), beacon.get()));
+		CHECK(b == graph.getStepToward(a.get(), beacon.get())->room);
+		CHECK(c == graph.getStepToward(b.get(), beacon.get())->room);
+		CHECK(!graph.getStepToward(d.get(), beacon.get()));
+		CHECK(!graph.getDistanceTo(e.get(), beacon.get()));
+
+		// Running away prefers Rooms the target can't reach at all
+		CHECK(b == graph.getStepAwayFrom(c.get(), beacon.get())->room);
+		CHECK(e == graph.getStepAwayFrom(a.get(), beacon.get())->room);
+		CHECK(!graph.getStepAwayFrom(e.get(), beacon.get()));
+
+		// The target's row is only computed again after it moves
+		size_t searches = graph.getNumSearches();
+
+		graph.getStepToward(b.get(), beacon.get());
+		graph.getStepAwayFrom(b.get(), beacon.get());
+		CHECK(searches == graph.getNumSearches());
+
+		d->removeThing(beacon);
+		b->insertThing(beacon);
+
+		CHECK(1 == *graph.getDistanceTo(a.get(), beacon.get()));
+		CHECK(2 == *graph.getDistanceTo(d.get(), beacon.get()));
+		CHECK(searches + 1 == graph.getNumSearches());
+
+		// Cornered with nowhere farther to go
+		CHECK(!graph.getStepAwayFrom(d.get(), beacon.get()));
+
+		// Targets that aren't in a Room can't be followed
+		b->removeThing(beacon);
+
+		CHECK(!graph.getDistanceTo(a.get(), beacon.get()));
+		CHECK(!graph.getStepToward(a.get(), beacon.get()));
+		CHECK(!graph.getStepAwayFrom(a.get(), beacon.get()));
+	}
+}
@@ -58,6 +58,47 @@ TEST_SUITE("Tangible (entities/tangible.cpp)") {
 		CHECK(0 == testPlayer.getResources().size());
 	}
 
+	TEST_CASE("Tangible (entities/tangible.cpp): Type masks and serialized type hierarchy") {
+
+		trogdor::Game mockGame(std::make_unique<trogdor::NullErr>());
+
+		trogdor::entity::Room testRoom(
+			&mockGame,
+			"start",
+			std::make_unique<trogdor::NullOut>(),
+			std::make_unique<trogdor::NullErr>()
+		);
+
+		trogdor::entity::Creature testCreature(
+			&mockGame,
+			"trogdor",
+			std::make_unique<trogdor::NullOut>(),
+			std::make_unique<trogdor::NullErr>()
+		);
+
+		CHECK(trogdor::entity::ENTITY_ROOM == testRoom.getType());
+		CHECK(testRoom.isType(trogdor::entity::ENTITY_PLACE));
+		CHECK(!testRoom.isType(trogdor::entity::ENTITY_THING));
+		CHECK(!testRoom.isType(trogdor::entity::ENTITY_RESOURCE));
+
+		CHECK(trogdor::entity::ENTITY_CREATURE == testCreature.getType());
+		CHECK(testCreature.isType(trogdor::entity::ENTITY_ENTITY));
+		CHECK(testCreature.isType(trogdor::entity::ENTITY_BEING));
+		CHECK(!testCreature.isType(trogdor::entity::ENTITY_PLAYER));
+		CHECK(!testCreature.isType(trogdor::entity::ENTITY_OBJECT));
+
+		// Copies keep their type
+		trogdor::entity::Creature copiedCreature(testCreature, "copy");
+		CHECK(testCreature.getTypeMask() == copiedCreature.getTypeMask());
+
+		// Types are serialized from the root of the hierarchy down
+		std::vector<std::string> types = std::get<std::vector<std::string>>(
+			*testCreature.serialize()->get("types")
+		);
+
+		CHECK(std::vector<std::string>({"entity", "tangible", "thing", "being", "creature"}) == types);
+	}
+
 	TEST_CASE("Tangible (entities/tangible.cpp): getResources() and getResourceByName()") {
 
 		trogdor::Game mockGame(std::make_unique<trogdor::NullErr>());
@@ -105,4 +146,115 @@ TEST_SUITE("Tangible (entities/tangible.cpp)") {
 		CHECK(allocation.first.expired());
 		CHECK(0 == allocation.second);
 	}
+
+	TEST_CASE("Tangible (entities/tangible.cpp): Observations are forgotten when Beings leave") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		auto rock = std::make_shared<trogdor::entity::Object>(
+			&game, "rock", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		game.insertEntity("rock", rock);
+
+		auto makeCreature = [&](std::string name, bool insert = true) {
+
+			auto creature = std::make_shared<trogdor::entity::Creature>(
+				&game, name, std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+			);
+
+			if (insert) {
+				game.insertEntity(name, creature);
+			}
+
+			return creature;
+		};
+
+		auto goblin = makeCreature("goblin");
+		auto orc = makeCreature("orc");
+
+		rock->glance(goblin, false);
+		CHECK(rock->glancedBy(goblin));
+		CHECK(!rock->observedBy(goblin));
+
+		rock->observe(orc, false);
+		CHECK(rock->glancedBy(orc));
+		CHECK(rock->observedBy(orc));
+
+		// Observing after glancing upgrades the record, but not the other way
+		// around, and each Being is only recorded once
+		rock->observe(goblin, false);
+		rock->glance(orc, false);
+
+		CHECK(rock->observedBy(goblin));
+		CHECK(rock->observedBy(orc));
+		CHECK(2 == rock->getNumObservers());
+		CHECK(rock->getObserverMemoryUsage() > 0);
+
+		// Beings that aren't in the game can't be remembered
+		auto stray = makeCreature("stray", false);
+
+		rock->observe(stray, false);
+		CHECK(!rock->glancedBy(stray));
+		CHECK(2 == rock->getNumObservers());
+
+		auto data = rock->serialize();
+		auto observedBy = std::get<std::vector<std::string>>(*data->get("observedBy"));
+
+		CHECK(2 == observedBy.size());
+		CHECK(0 == std::get<std::vector<std::string>>(*data->get("glancedBy")).size());
+
+		game.removeEntity("goblin");
+
+		CHECK(1 == rock->getNumObservers());
+		CHECK(!rock->glancedBy(goblin));
+
+		// A new Being that reuses the departed Being's handle slot starts out
+		// never having seen anything
+		auto troll = makeCreature("troll");
+
+		CHECK(!rock->glancedBy(troll));
+		CHECK(rock->observedBy(orc));
+
+		// Each Being keeps track of the Tangibles that remember it, once per
+		// Tangible, and those are the ones that forget it when it leaves
+		auto stone = std::make_shared<trogdor::entity::Object>(
+			&game, "stone", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		game.insertEntity("stone", stone);
+		stone->glance(orc, false);
+		stone->observe(orc, false);
+
+		CHECK(2 == orc->getNumObservedTangibles());
+		CHECK(0 == troll->getNumObservedTangibles());
+
+		// A Tangible that leaves first is skipped
+		game.removeEntity("stone");
+		game.removeEntity("orc");
+
+		CHECK(0 == rock->getNumObservers());
+		CHECK(0 == orc->getNumObservedTangibles());
+
+		// Tangibles that aren't in the game don't remember anyone either
+		auto pebble = std::make_shared<trogdor::entity::Object>(
+			&game, "pebble", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		pebble->observe(troll, false);
+
+		CHECK(0 == pebble->getNumObservers());
+		CHECK(0 == troll->getNumObservedTangibles());
+
+		// A Tangible that leaves forgets everyone who looked at it, since it
+		// gets a new handle when it comes back
+		rock->observe(troll, false);
+		CHECK(1 == rock->getNumObservers());
+
+		game.removeEntity("rock");
+		CHECK(0 == rock->getNumObservers());
+
+		game.insertEntity("rock", rock);
+		CHECK(!rock->glancedBy(troll));
+	}
 }
@@ -0,0 +1,317 @@
+#include <doctest.h>
+
+#include <set>
+#include <thread>
+#include <algorithm>
+
+#include <trogdor/game.h>
+
+#include <trogdor/entities/room.h>
+#include <trogdor/entities/object.h>
+#include <trogdor/entities/creature.h>
+#include <trogdor/entities/resource.h>
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+#include "mock/mockgame.h"
+
+
+TEST_SUITE("Game (game.cpp)") {
+
+	TEST_CASE("Game (game.cpp): Entity registry and type-filtered views") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		game.insertEntity("start", std::make_shared<trogdor::entity::Room>(
+			&game, "start", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		));
+
+		game.insertEntity("sword", std::make_shared<trogdor::entity::Object>(
+			&game, "sword", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		));
+
+		game.insertEntity("trogdor", std::make_shared<trogdor::entity::Creature>(
+			&game, "trogdor", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		));
+
+		game.insertEntity("gold", std::make_shared<trogdor::entity::Resource>(&game, "gold"));
+
+		CHECK(4 == game.getEntities().size());
+		CHECK(1 == game.getRooms().size());
+		CHECK(1 == game.getPlaces().size());
+		CHECK(3 == game.getTangibles().size());
+		CHECK(2 == game.getThings().size());
+		CHECK(1 == game.getBeings().size());
+		CHECK(1 == game.getCreatures().size());
+		CHECK(1 == game.getObjects().size());
+		CHECK(1 == game.getResources().size());
+		CHECK(game.getPlayers().empty());
+
+		// Iterating a view only visits Entities of its type
+		size_t nThings = 0;
+
+		for (const auto &thing: game.getThings()) {
+			CHECK(thing.second->isType(trogdor::entity::ENTITY_THING));
+			CHECK(thing.first == thing.second->getName());
+			nThings++;
+		}
+
+		CHECK(2 == nThings);
+
+		// Lookups by name respect the type
+		CHECK(game.getCreature("trogdor"));
+		CHECK(game.getBeing("trogdor"));
+		CHECK(!game.getObject("trogdor"));
+		CHECK(!game.getCreature("doesNotExist"));
+		CHECK(game.getRooms().end() == game.getRooms().find("sword"));
+		CHECK(game.getObjects().end() != game.getObjects().find("sword"));
+		CHECK(0 == game.getObjects().find("sword")->first.compare("sword"));
+
+		game.removeEntity("trogdor");
+
+		CHECK(3 == game.getEntities().size());
+		CHECK(1 == game.getThings().size());
+		CHECK(game.getBeings().empty());
+		CHECK(game.getCreatures().begin() == game.getCreatures().end());
+		CHECK(!game.getCreature("trogdor"));
+
+		// Removing an Entity from the middle of a type's index moves another
+		// into its place, and both iteration and find() keep up
+		for (size_t i = 0; i < 5; i++) {
+			game.insertEntity("goblin" + std::to_string(i), std::make_shared<trogdor::entity::Creature>(
+				&game, "goblin" + std::to_string(i), std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+			));
+		}
+
+		game.removeEntity("goblin1");
+		game.removeEntity("goblin4");
+
+		std::set<std::string> goblins;
+
+		for (auto creature = game.getCreatures().begin(); creature != game.getCreatures().end(); creature++) {
+			CHECK(creature.get() == game.getCreatures().find(creature->first)->second.get());
+			goblins.insert(creature->first);
+		}
+
+		CHECK(std::set<std::string>({"goblin0", "goblin2", "goblin3"}) == goblins);
+		CHECK(3 == game.getBeings().size());
+		CHECK(4 == game.getThings().size());
+
+		game.clearEntities();
+
+		CHECK(game.getTangibles().empty());
+		CHECK(game.getResources().empty());
+	}
+
+	TEST_CASE("Game (game.cpp): Tag index") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		auto sword = std::make_shared<trogdor::entity::Object>(
+			&game, "sword", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		auto rock = std::make_shared<trogdor::entity::Object>(
+			&game, "rock", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		// Built-in tags are stored in slots and can be checked by slot or name
+		sword->setTag(trogdor::entity::Object::WeaponTag);
+		sword->setTag("shiny");
+
+		CHECK(sword->isTagSet(trogdor::entity::TAG_SLOT_WEAPON));
+		CHECK(sword->isTagSet(trogdor::entity::Object::WeaponTag));
+		CHECK(sword->isTagSet("shiny"));
+		CHECK(!rock->isTagSet(trogdor::entity::TAG_SLOT_WEAPON));
+
+		for (int i = 0; i < trogdor::entity::NUM_TAG_SLOTS; i++) {
+
+			auto slot = static_cast<trogdor::entity::TagSlot>(i);
+			auto lookup = trogdor::entity::strToTagSlot(trogdor::entity::tagSlotToStr(slot));
+
+			CHECK(lookup.has_value());
+			CHECK(slot == *lookup);
+		}
+
+		CHECK(!trogdor::entity::strToTagSlot("shiny").has_value());
+
+		// Tags set before insertion are indexed when the Entity is inserted
+		CHECK(0 == game.countEntitiesWithTag("shiny"));
+
+		game.insertEntity("sword", sword);
+		game.insertEntity("rock", rock);
+
+		CHECK(1 == game.countEntitiesWithTag("shiny"));
+		CHECK(1 == game.countEntitiesWithTag(trogdor::entity::Object::WeaponTag));
+
+		// Tags set and removed afterward keep the index up to date
+		rock->setTag("shiny");
+		rock->setTag(trogdor::entity::TAG_SLOT_UNTAKEABLE);
+
+		CHECK(2 == game.countEntitiesWithTag("shiny"));
+		CHECK(1 == game.countEntitiesWithTag(trogdor::entity::Object::UntakeableTag));
+
+		auto shiny = game.getEntitiesWithTag("shiny");
+
+		CHECK(2 == shiny.size());
+		CHECK(shiny.end() != std::find(shiny.begin(), shiny.end(), sword));
+		CHECK(shiny.end() != std::find(shiny.begin(), shiny.end(), rock));
+
+		sword->removeTag("shiny");
+		CHECK(1 == game.countEntitiesWithTag("shiny"));
+		CHECK(rock == game.getEntitiesWithTag("shiny")[0]);
+
+		// Removed Entities drop out of the index, and changes to their tags
+		// no longer affect it
+		game.removeEntity("rock");
+		CHECK(0 == game.countEntitiesWithTag("shiny"));
+		CHECK(game.getEntitiesWithTag(trogdor::entity::Object::UntakeableTag).empty());
+
+		rock->setTag("dull");
+		CHECK(0 == game.countEntitiesWithTag("dull"));
+
+		game.clearEntities();
+		CHECK(0 == game.countEntitiesWithTag(trogdor::entity::Object::WeaponTag));
+	}
+
+	TEST_CASE("Game (game.cpp): Tags set and removed from several threads at once") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		auto lamp = std::make_shared<trogdor::entity::Object>(
+			&game, "lamp", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		game.insertEntity("lamp", lamp);
+
+		// Whichever thread goes last, the index has to agree with the tag
+		for (int round = 0; round < 200; round++) {
+
+			std::thread setter([&] {
+				for (int i = 0; i < 50; i++) {
+					lamp->setTag("lit");
+				}
+			});
+
+			std::thread remover([&] {
+				for (int i = 0; i < 50; i++) {
+					lamp->removeTag("lit");
+				}
+			});
+
+			setter.join();
+			remover.join();
+
+			CHECK((lamp->isTagSet("lit") ? 1 : 0) == game.countEntitiesWithTag("lit"));
+		}
+	}
+
+	TEST_CASE("Game (game.cpp): Tags changing while an Entity is inserted and removed") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		auto lamp = std::make_shared<trogdor::entity::Object>(
+			&game, "lamp", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		std::thread tagger([&] {
+			for (int i = 0; i < 5000; i++) {
+				lamp->setTag("tag" + std::to_string(i % 20));
+				lamp->removeTag("tag" + std::to_string((i + 10) % 20));
+			}
+		});
+
+		for (int i = 0; i < 200; i++) {
+			game.insertEntity("lamp", lamp);
+			game.removeEntity("lamp");
+		}
+
+		tagger.join();
+
+		// Nothing is left behind for an Entity that isn't in the game, and
+		// once it's back, the index agrees with its tags
+		for (int i = 0; i < 20; i++) {
+			CHECK(0 == game.countEntitiesWithTag("tag" + std::to_string(i)));
+		}
+
+		game.insertEntity("lamp", lamp);
+
+		for (int i = 0; i < 20; i++) {
+			std::string tag = "tag" + std::to_string(i);
+			CHECK((lamp->isTagSet(tag) ? 1 : 0) == game.countEntitiesWithTag(tag));
+		}
+	}
+
+	TEST_CASE("Game (game.cpp): spawnMany()") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		auto cave = std::make_shared<trogdor::entity::Room>(
+			&game, "cave", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		auto goblin = std::make_shared<trogdor::entity::Creature>(
+			&game, "goblin", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		auto dungeon = std::make_shared<trogdor::entity::Room>(
+			&game, "dungeon", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		goblin->setClass("goblin");
+		goblin->setTag("hostile");
+		dungeon->setClass("dungeon");
+
+		game.insertEntity("cave", cave);
+		game.insertEntityClass("goblin", goblin);
+		game.insertEntityClass("dungeon", dungeon);
+
+		// Names that are already taken get skipped
+		game.insertEntity("goblin2", std::make_shared<trogdor::entity::Object>(
+			&game, "goblin2", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		));
+
+		auto spawned = game.spawnMany("goblin", 3, cave);
+
+		CHECK(3 == spawned.size());
+		CHECK(3 == game.getCreatures().size());
+		CHECK(3 == cave->getCreatures().size());
+		CHECK(3 == game.countEntitiesWithTag("hostile"));
+		CHECK(!game.getEntity("goblin"));
+
+		for (const auto &name: {"goblin1", "goblin3", "goblin4"}) {
+
+			auto creature = game.getCreature(name);
+
+			REQUIRE(creature);
+			CHECK(0 == creature->getClass().compare("goblin"));
+			CHECK(creature->isTagSet("hostile"));
+			CHECK(cave == creature->getLocation().lock());
+			CHECK(!creature->getHandle().isNull());
+		}
+
+		// Patterns with a placeholder, and no Place
+		auto wave = game.spawnMany("goblin", 2, nullptr, "wave {} goblin");
+
+		CHECK(2 == wave.size());
+		CHECK(game.getCreature("wave 1 goblin"));
+		CHECK(game.getCreature("wave 2 goblin"));
+		CHECK(!wave[0]->getLocation().lock());
+		CHECK(3 == cave->getCreatures().size());
+
+		// Nothing gets inserted if something goes wrong
+		CHECK_THROWS(game.spawnMany("dragon", 1));
+		CHECK_THROWS(game.spawnMany("dungeon", 1));
+		CHECK_THROWS(game.spawnMany("goblin", 2, nullptr, "bad!goblin"));
+		CHECK(5 == game.getCreatures().size());
+
+		// Classes survive serialization
+		auto restored = trogdor::restoreGame(game);
+
+		REQUIRE(restored->getEntityClass("goblin"));
+		CHECK(restored->getEntityClass("goblin")->isTagSet("hostile"));
+		CHECK(1 == restored->spawnMany("goblin", 1).size());
+		CHECK(restored->getCreature("goblin5"));
+	}
+}
@@ -0,0 +1,92 @@
+#include <doctest.h>
+
+#include <trogdor/game.h>
+#include <trogdor/lua/luastate.h>
+#include <trogdor/lua/api/luaffi.h>
+
+#include <trogdor/entities/object.h>
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+
+TEST_SUITE("LuaFFI (lua/api/luaffi.cpp)") {
+
+	TEST_CASE("LuaFFI (lua/api/luaffi.cpp): C accessors") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		trogdor::entity::Object sword(
+			&game,
+			"sword",
+			std::make_unique<trogdor::NullOut>(),
+			std::make_unique<trogdor::NullErr>()
+		);
+
+		double value = -1.0;
+
+		sword.setTag("sharp");
+		sword.setProperty("damage", 7);
+		sword.setProperty("cursed", true);
+
+		CHECK(std::string("sword") == trogdor_entity_get_name(&sword));
+		CHECK(trogdor::entity::ENTITY_OBJECT == trogdor_entity_get_type(&sword));
+
+		CHECK(1 == trogdor_entity_is_type(&sword, trogdor::entity::ENTITY_THING));
+		CHECK(1 == trogdor_entity_is_type(&sword, trogdor::entity::ENTITY_OBJECT));
+		CHECK(0 == trogdor_entity_is_type(&sword, trogdor::entity::ENTITY_ROOM));
+		CHECK(0 == trogdor_entity_is_type(&sword, -1));
+		CHECK(0 == trogdor_entity_is_type(&sword, 1000));
+
+		CHECK(1 == trogdor_entity_is_tag_set(&sword, "sharp"));
+		CHECK(0 == trogdor_entity_is_tag_set(&sword, "blunt"));
+
+		CHECK(1 == trogdor_entity_get_number(&sword, "damage", &value));
+		CHECK(7.0 == value);
+
+		// Non-numeric and undefined properties shouldn't touch the value
+		value = -1.0;
+		CHECK(0 == trogdor_entity_get_number(&sword, "cursed", &value));
+		CHECK(0 == trogdor_entity_get_number(&sword, "undefined", &value));
+		CHECK(-1.0 == value);
+	}
+
+	#ifdef ENABLE_LUAJIT_FFI
+
+		TEST_CASE("LuaFFI (lua/api/luaffi.cpp): EntityFFI") {
+
+			trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+			std::shared_ptr<trogdor::entity::Object> sword = std::make_shared<trogdor::entity::Object>(
+				&game,
+				"sword",
+				std::make_unique<trogdor::NullOut>(),
+				std::make_unique<trogdor::NullErr>()
+			);
+
+			sword->setTag("sharp");
+			sword->setProperty("damage", 7);
+			game.insertEntity("sword", sword);
+
+			game.getLuaState()->loadScriptFromString(
+				"function checkFFI()\n"
+				"   local e = Entity.get('sword')\n"
+				"   if EntityFFI.getName(e) ~= 'sword' then return 1 end\n"
+				"   if EntityFFI.getType(e) ~= 'object' then return 2 end\n"
+				"   if not EntityFFI.isType(e, 'thing') then return 3 end\n"
+				"   if EntityFFI.isType(e, 'room') then return 4 end\n"
+				"   if not EntityFFI.isTagSet(e, 'sharp') then return 5 end\n"
+				"   if EntityFFI.getNumber(e, 'damage') ~= 7 then return 6 end\n"
+				"   if EntityFFI.getNumber(e, 'undefined') ~= nil then return 7 end\n"
+				"   return 0\n"
+				"end\n"
+			);
+
+			game.getLuaState()->call("checkFFI");
+			game.getLuaState()->execute(1);
+
+			CHECK(0 == game.getLuaState()->getNumber(0));
+		}
+
+	#endif
+}
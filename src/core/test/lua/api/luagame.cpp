@@ -0,0 +1,243 @@
+#include <doctest.h>
+
+#include <trogdor/game.h>
+#include <trogdor/lua/luastate.h>
+
+#include <trogdor/entities/room.h>
+#include <trogdor/entities/object.h>
+#include <trogdor/entities/creature.h>
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+
+// Populates a game with two rooms, three creatures and two objects. Only the
+// creatures in the cave are tagged "hostile".
+static void populateGame(trogdor::Game &game) {
+
+	std::shared_ptr<trogdor::entity::Room> start = std::make_shared<trogdor::entity::Room>(
+		&game, "start", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+	);
+
+	std::shared_ptr<trogdor::entity::Room> cave = std::make_shared<trogdor::entity::Room>(
+		&game, "cave", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+	);
+
+	game.insertEntity("start", start);
+	game.insertEntity("cave", cave);
+
+	for (const auto &name: {"goblin", "orc", "bunny"}) {
+
+		std::shared_ptr<trogdor::entity::Creature> creature = std::make_shared<trogdor::entity::Creature>(
+			&game, name, std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		game.insertEntity(name, creature);
+
+		if (std::string("bunny") == name) {
+			start->insertThing(creature);
+		} else {
+			creature->setTag("hostile");
+			cave->insertThing(creature);
+		}
+	}
+
+	for (const auto &name: {"rock", "sword"}) {
+
+		std::shared_ptr<trogdor::entity::Object> object = std::make_shared<trogdor::entity::Object>(
+			&game, name, std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		game.insertEntity(name, object);
+		cave->insertThing(object);
+	}
+}
+
+// Calls a global Lua function that takes no arguments and returns a number
+static double callNumeric(trogdor::Game &game, const char *function) {
+
+	game.getLuaState()->call(function);
+	game.getLuaState()->execute(1);
+
+	return game.getLuaState()->getNumber(0);
+}
+
+TEST_SUITE("LuaGame (lua/api/luagame.cpp)") {
+
+	TEST_CASE("LuaGame (lua/api/luagame.cpp): query()") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+		populateGame(game);
+
+		game.getLuaState()->loadScriptFromString(
+			"function countAll() return #game:query() end\n"
+			"function countEmptyFilter() return #game:query{} end\n"
+			"function countCreatures() return #game:query{type = 'creature'} end\n"
+			"function countBeings() return #game:query{type = 'being'} end\n"
+			"function countHostile() return #game:query{tag = 'hostile'} end\n"
+			"function countCaveThings() return #game:query{place = 'cave'} end\n"
+			"function countCaveObjects() return #game:query{type = 'object', place = Place.get('cave')} end\n"
+			"function countStartHostile() return #game:query{tag = 'hostile', place = 'start'} end\n"
+			"function countMissingPlace() return #game:query{place = 'nowhere'} end\n"
+			"function countHostileCreaturesInCave()\n"
+			"   local n = 0\n"
+			"   for _, c in ipairs(game:query{type = 'creature', tag = 'hostile', place = 'cave'}) do\n"
+			"      if c:isTagSet('hostile') and c:isType('creature') then n = n + 1 end\n"
+			"   end\n"
+			"   return n\n"
+			"end\n"
+		);
+
+		CHECK(7 == callNumeric(game, "countAll"));
+		CHECK(7 == callNumeric(game, "countEmptyFilter"));
+		CHECK(3 == callNumeric(game, "countCreatures"));
+		CHECK(3 == callNumeric(game, "countBeings"));
+		CHECK(2 == callNumeric(game, "countHostile"));
+		CHECK(4 == callNumeric(game, "countCaveThings"));
+		CHECK(2 == callNumeric(game, "countCaveObjects"));
+		CHECK(0 == callNumeric(game, "countStartHostile"));
+		CHECK(0 == callNumeric(game, "countMissingPlace"));
+		CHECK(2 == callNumeric(game, "countHostileCreaturesInCave"));
+
+		game.getLuaState()->loadScriptFromString(
+			"function badType() return game:query{type = 'dragon'} end\n"
+		);
+
+		game.getLuaState()->call("badType");
+		CHECK_THROWS(game.getLuaState()->execute(1));
+	}
+
+	TEST_CASE("LuaGame (lua/api/luagame.cpp): spawnMany()") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+		populateGame(game);
+
+		auto rat = std::make_shared<trogdor::entity::Creature>(
+			&game, "rat", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		rat->setClass("rat");
+		rat->setTag("vermin");
+		game.insertEntityClass("rat", rat);
+
+		game.getLuaState()->loadScriptFromString(
+			"function spawnRats() return #game:spawnMany('rat', 4, 'cave') end\n"
+			"function spawnNamedRats() return #game:spawnMany('rat', 2, Place.get('start'), 'sewer rat {}') end\n"
+			"function spawnLooseRats() return #game:spawnMany('rat', 1) end\n"
+			"function countCaveRats()\n"
+			"   local n = 0\n"
+			"   for _, c in ipairs(game:query{type = 'creature', place = 'cave'}) do\n"
+			"      if c:isTagSet('vermin') then n = n + 1 end\n"
+			"   end\n"
+			"   return n\n"
+			"end\n"
+			"function spawnDragons() return game:spawnMany('dragon', 1) end\n"
+		);
+
+		CHECK(4 == callNumeric(game, "spawnRats"));
+		CHECK(4 == callNumeric(game, "countCaveRats"));
+		CHECK(2 == callNumeric(game, "spawnNamedRats"));
+		CHECK(game.getCreature("sewer rat 2"));
+		CHECK(1 == callNumeric(game, "spawnLooseRats"));
+		CHECK(game.getCreature("rat5"));
+		CHECK(10 == game.getCreatures().size());
+
+		game.getLuaState()->call("spawnDragons");
+		CHECK_THROWS(game.getLuaState()->execute(1));
+	}
+
+	TEST_CASE("LuaGame (lua/api/luagame.cpp): Room graph queries") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+		populateGame(game);
+
+		std::shared_ptr<trogdor::entity::Room> tunnel = std::make_shared<trogdor::entity::Room>(
+			&game, "tunnel", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		std::shared_ptr<trogdor::entity::Room> island = std::make_shared<trogdor::entity::Room>(
+			&game, "island", std::make_unique<trogdor::NullOut>(), std::make_unique<trogdor::NullErr>()
+		);
+
+		game.insertEntity("tunnel", tunnel);
+		game.insertEntity("island", island);
+
+		// start -> tunnel -> cave
+		game.getRoom("start")->setConnection("north", tunnel);
+		tunnel->setConnection("down", game.getRoom("cave"));
+
+		game.getLuaState()->loadScriptFromString(
+			"function distanceToCave() return game:getDistance('start', Room.get('cave')) end\n"
+			"function distanceToStart() return game:getDistance('cave', 'start') == nil and -1 or 0 end\n"
+			"function nextStepIsTunnel()\n"
+			"   local room, direction = game:getNextStep('start', 'cave')\n"
+			"   return (room:getName() == 'tunnel' and direction == 'north') and 1 or 0\n"
+			"end\n"
+			"function pathIsCorrect()\n"
+			"   local rooms, directions = game:getPath('start', 'cave')\n"
+			"   return (#rooms == 2 and rooms[2]:getName() == 'cave' and directions[2] == 'down') and 1 or 0\n"
+			"end\n"
+			"function countComponents() return game:getNumRoomComponents() end\n"
+			"function sameComponent() return game:getRoomComponent('start') == game:getRoomComponent('cave') and 1 or 0 end\n"
+			"function islandIsAlone() return game:getRoomComponent('island') ~= game:getRoomComponent('cave') and 1 or 0 end\n"
+			"function badRoom() return game:getDistance('start', 'nowhere') end\n"
+		);
+
+		CHECK(2 == callNumeric(game, "distanceToCave"));
+		CHECK(-1 == callNumeric(game, "distanceToStart"));
+		CHECK(1 == callNumeric(game, "nextStepIsTunnel"));
+		CHECK(1 == callNumeric(game, "pathIsCorrect"));
+		CHECK(2 == callNumeric(game, "countComponents"));
+		CHECK(1 == callNumeric(game, "sameComponent"));
+		CHECK(1 == callNumeric(game, "islandIsAlone"));
+
+		game.getLuaState()->call("badRoom");
+		CHECK_THROWS(game.getLuaState()->execute(1));
+	}
+
+	TEST_CASE("LuaGame (lua/api/luagame.cpp): Place:getThings(), getBeings() and getObjects()") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+		populateGame(game);
+
+		game.getLuaState()->loadScriptFromString(
+			"function countThings() return #Place.get('cave'):getThings() end\n"
+			"function countBeings() return #Place.get('cave'):getBeings() end\n"
+			"function countObjects() return #Place.get('cave'):getObjects() end\n"
+			"function countStartObjects() return #Place.get('start'):getObjects() end\n"
+		);
+
+		CHECK(4 == callNumeric(game, "countThings"));
+		CHECK(2 == callNumeric(game, "countBeings"));
+		CHECK(2 == callNumeric(game, "countObjects"));
+		CHECK(0 == callNumeric(game, "countStartObjects"));
+	}
+
+	TEST_CASE("LuaGame (lua/api/luagame.cpp): Entity:getProperties()") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+		populateGame(game);
+
+		game.getEntity("sword")->setProperty("damage", 7);
+		game.getEntity("sword")->setProperty("cursed", true);
+
+		game.getLuaState()->loadScriptFromString(
+			"function checkSelected()\n"
+			"   local p = Entity.get('sword'):getProperties{'title', 'damage', 'cursed', 'undefined'}\n"
+			"   if p.title ~= 'sword' then return 1 end\n"
+			"   if p.damage ~= 7 then return 2 end\n"
+			"   if p.cursed ~= true then return 3 end\n"
+			"   if p.undefined ~= nil then return 4 end\n"
+			"   return 0\n"
+			"end\n"
+			"function checkAll()\n"
+			"   local p = Entity.get('sword'):getProperties()\n"
+			"   if p.damage ~= 7 or p.title ~= 'sword' then return 1 end\n"
+			"   return 0\n"
+			"end\n"
+		);
+
+		CHECK(0 == callNumeric(game, "checkSelected"));
+		CHECK(0 == callNumeric(game, "checkAll"));
+	}
+}
@@ -0,0 +1,191 @@
+#include <chrono>
+#include <doctest.h>
+
+#include <trogdor/game.h>
+#include <trogdor/lua/luastate.h>
+#include <trogdor/lua/luascheduler.h>
+
+#include <trogdor/iostream/nullerr.h>
+
+
+// Calls a global Lua function that takes no arguments and returns a number
+static double callNumeric(trogdor::Game &game, const char *function) {
+
+	game.getLuaState()->call(function);
+	game.getLuaState()->execute(1);
+
+	return game.getLuaState()->getNumber(0);
+}
+
+TEST_SUITE("LuaScheduler (luascheduler.cpp)") {
+
+	TEST_CASE("LuaScheduler (luascheduler.cpp): spawn() and wait()") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		game.getLuaState()->loadScriptFromString(
+			"steps = 0\n"
+			"function walk(stride)\n"
+			"   for i = 1, 3 do\n"
+			"      steps = steps + stride\n"
+			"      wait(2)\n"
+			"   end\n"
+			"end\n"
+			"function getSteps() return steps end\n"
+			"function spawnFromLua() return spawn(walk, 10) end\n"
+		);
+
+		trogdor::LuaScheduler *scheduler = game.getLuaState()->getScheduler();
+
+		scheduler->spawn("walk");
+		CHECK(1 == scheduler->size());
+
+		// Calling walk() from C++ passes no arguments, so stride is nil
+		// and the first resume raises an error, ending the coroutine
+		scheduler->resume(1);
+		CHECK(0 == scheduler->size());
+
+		CHECK(0 != callNumeric(game, "spawnFromLua"));
+		CHECK(1 == scheduler->size());
+
+		// Spawned coroutines don't run until the next tick
+		CHECK(0 == callNumeric(game, "getSteps"));
+
+		scheduler->resume(1);
+		CHECK(10 == callNumeric(game, "getSteps"));
+
+		// Still waiting
+		scheduler->resume(2);
+		CHECK(10 == callNumeric(game, "getSteps"));
+
+		scheduler->resume(3);
+		CHECK(20 == callNumeric(game, "getSteps"));
+
+		scheduler->resume(5);
+		CHECK(30 == callNumeric(game, "getSteps"));
+		CHECK(1 == scheduler->size());
+
+		// Final wait() returns and the function ends
+		scheduler->resume(7);
+		CHECK(30 == callNumeric(game, "getSteps"));
+		CHECK(0 == scheduler->size());
+
+		CHECK_THROWS(scheduler->spawn("doesNotExist"));
+	}
+
+	TEST_CASE("LuaScheduler (luascheduler.cpp): waitEvent()") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		game.getLuaState()->loadScriptFromString(
+			"heard = ''\n"
+			"function listen()\n"
+			"   heard = waitEvent('afterDie')\n"
+			"end\n"
+			"function getHeard() return #heard end\n"
+			"function waitOutsideCoroutine() wait(1) end\n"
+		);
+
+		trogdor::LuaScheduler *scheduler = game.getLuaState()->getScheduler();
+
+		scheduler->spawn("listen");
+		scheduler->resume(1);
+
+		// Unrelated events and ticks don't wake it up
+		scheduler->signalEvent("afterGotoLocation");
+		scheduler->resume(2);
+		CHECK(0 == callNumeric(game, "getHeard"));
+		CHECK(1 == scheduler->size());
+
+		// Firing the event through the game wakes it on the next tick
+		game.event({"afterDie", {}, {}});
+		CHECK(0 == callNumeric(game, "getHeard"));
+
+		scheduler->resume(3);
+		CHECK(8 == callNumeric(game, "getHeard"));
+		CHECK(0 == scheduler->size());
+
+		// Yielding from the main thread is an error
+		game.getLuaState()->call("waitOutsideCoroutine");
+		CHECK_THROWS(game.getLuaState()->execute(0));
+	}
+
+	TEST_CASE("LuaScheduler (luascheduler.cpp): coroutine.yield() with arguments") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		game.getLuaState()->loadScriptFromString(
+			"count = 0\n"
+			"function yieldNumber()\n"
+			"   for i = 1, 3 do\n"
+			"      count = count + 1\n"
+			"      coroutine.yield(5)\n"
+			"   end\n"
+			"end\n"
+			"function yieldString()\n"
+			"   coroutine.yield('afterDie')\n"
+			"   count = count + 100\n"
+			"end\n"
+			"function getCount() return count end\n"
+		);
+
+		trogdor::LuaScheduler *scheduler = game.getLuaState()->getScheduler();
+
+		// A yielded number isn't mistaken for wait(5)
+		scheduler->spawn("yieldNumber");
+
+		for (size_t tick = 1; tick <= 3; tick++) {
+			scheduler->resume(tick);
+			CHECK(tick == callNumeric(game, "getCount"));
+		}
+
+		scheduler->resume(4);
+		CHECK(0 == scheduler->size());
+
+		// And a yielded string isn't mistaken for waitEvent()
+		scheduler->spawn("yieldString");
+		scheduler->resume(5);
+		scheduler->resume(6);
+		CHECK(103 == callNumeric(game, "getCount"));
+		CHECK(0 == scheduler->size());
+	}
+
+	TEST_CASE("LuaScheduler (luascheduler.cpp): Per-tick budget and cancel()") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		game.getLuaState()->loadScriptFromString(
+			"runs = 0\n"
+			"function busy()\n"
+			"   local deadline = os.clock() + 0.01\n"
+			"   while os.clock() < deadline do end\n"
+			"   runs = runs + 1\n"
+			"end\n"
+			"function getRuns() return runs end\n"
+		);
+
+		trogdor::LuaScheduler *scheduler = game.getLuaState()->getScheduler();
+
+		scheduler->setBudget(std::chrono::microseconds(1));
+
+		for (int i = 0; i < 3; i++) {
+			scheduler->spawn("busy");
+		}
+
+		size_t cancelled = scheduler->spawn("busy");
+		scheduler->cancel(cancelled);
+		CHECK(3 == scheduler->size());
+
+		// Once the budget is spent, the rest wait for the next tick
+		scheduler->resume(1);
+		CHECK(1 == callNumeric(game, "getRuns"));
+
+		scheduler->resume(2);
+		CHECK(2 == callNumeric(game, "getRuns"));
+
+		scheduler->setBudget(std::chrono::microseconds(0));
+		scheduler->resume(3);
+		CHECK(3 == callNumeric(game, "getRuns"));
+		CHECK(0 == scheduler->size());
+	}
+}
@@ -1,5 +1,8 @@
 #include <doctest.h>
 
+#include <set>
+#include <sstream>
+
 #include <trogdor/game.h>
 #include <trogdor/filesystem.h>
 #include <trogdor/lua/luastate.h>
@@ -15,6 +18,7 @@
 
 #include "luafuncs.h"
 #include "testluastate.h"
+#include "../mock/mockgame.h"
 
 
 // Runs basic sanity checks on new instances of LuaState
@@ -573,4 +577,310 @@ TEST_SUITE("LuaState (luastate.cpp)") {
 
 		// TODO: test both defined and undefined functions and with and without arguments and return values
 	}
+
+	TEST_CASE("LuaState (luastate.cpp): Sampling profiler") {
+
+		std::unique_ptr<trogdor::Game> game = std::make_unique<trogdor::Game>(
+			std::make_unique<trogdor::NullErr>()
+		);
+
+		trogdor::LuaState L(game.get());
+
+		L.loadScriptFromString(
+			"function spin(n)\n"
+			"   local total = 0\n"
+			"   for i = 1, n do total = total + i end\n"
+			"   return total\n"
+			"end\n"
+		);
+
+		CHECK(!L.isProfiling());
+		CHECK(0 == L.getProfilerSampleCount());
+
+		// Nothing should be recorded while the profiler is off
+		L.call("spin");
+		L.pushArgument(100000.0);
+		L.execute(1);
+
+		CHECK(0 == L.getProfilerSampleCount());
+
+		L.startProfiler(100);
+		CHECK(L.isProfiling());
+
+		L.call("spin");
+		L.pushArgument(100000.0);
+		L.execute(1);
+
+		L.stopProfiler();
+		CHECK(!L.isProfiling());
+
+		size_t nSamples = L.getProfilerSampleCount();
+		CHECK(nSamples > 0);
+
+		// Samples collected before the profiler was stopped should survive,
+		// and no new samples should be taken
+		L.call("spin");
+		L.pushArgument(100000.0);
+		L.execute(1);
+
+		CHECK(nSamples == L.getProfilerSampleCount());
+
+		std::ostringstream profile;
+		L.dumpProfile(profile);
+
+		// Every line should be in folded stack format: frames separated by
+		// semicolons, then a single space, then the sample count
+		size_t total = 0;
+		bool sawSpin = false;
+		std::istringstream lines(profile.str());
+
+		for (std::string line; std::getline(lines, line); ) {
+
+			size_t space = line.rfind(' ');
+
+			REQUIRE(space != std::string::npos);
+			CHECK(std::string::npos == line.substr(0, space).find(' '));
+
+			if (std::string::npos != line.find("spin@")) {
+				sawSpin = true;
+			}
+
+			total += std::stoul(line.substr(space + 1));
+		}
+
+		CHECK(sawSpin);
+		CHECK(nSamples == total);
+
+		L.resetProfiler();
+		CHECK(0 == L.getProfilerSampleCount());
+
+		CHECK_THROWS(L.startProfiler(0));
+	}
+
+	TEST_CASE("LuaState (luastate.cpp): Profiler samples scheduled coroutines") {
+
+		std::unique_ptr<trogdor::Game> game = std::make_unique<trogdor::Game>(
+			std::make_unique<trogdor::NullErr>()
+		);
+
+		trogdor::LuaState L(game.get());
+
+		L.loadScriptFromString(
+			"function spin(n)\n"
+			"   local total = 0\n"
+			"   for i = 1, n do\n"
+			"      total = total + i\n"
+			"   end\n"
+			"   return total\n"
+			"end\n"
+			"function worker()\n"
+			"   while true do\n"
+			"      spin(100000)\n"
+			"      coroutine.yield()\n"
+			"   end\n"
+			"end\n"
+		);
+
+		// Spawned before the profiler starts
+		L.getScheduler()->spawn("worker");
+		L.getScheduler()->resume(1);
+		CHECK(0 == L.getProfilerSampleCount());
+
+		L.startProfiler(100);
+		L.getScheduler()->resume(2);
+		L.stopProfiler();
+
+		size_t nSamples = L.getProfilerSampleCount();
+		CHECK(nSamples > 0);
+
+		// The coroutine's hook is removed along with the main thread's
+		L.getScheduler()->resume(3);
+		CHECK(nSamples == L.getProfilerSampleCount());
+
+		// Every sample taken inside spin() is attributed to the same frame,
+		// whichever line it landed on
+		std::set<std::string> spinFrames;
+		std::ostringstream profile;
+
+		L.dumpProfile(profile);
+		std::istringstream lines(profile.str());
+
+		for (std::string line; std::getline(lines, line); ) {
+
+			std::istringstream frames(line.substr(0, line.rfind(' ')));
+
+			for (std::string frame; std::getline(frames, frame, ';'); ) {
+				if (0 == frame.find("spin@")) {
+					spinFrames.insert(frame);
+				}
+			}
+		}
+
+		CHECK(1 == spinFrames.size());
+	}
+
+	TEST_CASE("LuaState (luastate.cpp): Game profiler wrappers only affect one game") {
+
+		std::unique_ptr<trogdor::Game> game1 = std::make_unique<trogdor::Game>(
+			std::make_unique<trogdor::NullErr>()
+		);
+
+		std::unique_ptr<trogdor::Game> game2 = std::make_unique<trogdor::Game>(
+			std::make_unique<trogdor::NullErr>()
+		);
+
+		const char *script =
+			"function spin(n)\n"
+			"   local total = 0\n"
+			"   for i = 1, n do total = total + i end\n"
+			"   return total\n"
+			"end\n";
+
+		game1->getLuaState()->loadScriptFromString(script);
+		game2->getLuaState()->loadScriptFromString(script);
+
+		game1->startLuaProfiler(100);
+
+		for (const auto &game: {game1.get(), game2.get()}) {
+			game->getLuaState()->call("spin");
+			game->getLuaState()->pushArgument(100000.0);
+			game->getLuaState()->execute(1);
+		}
+
+		game1->stopLuaProfiler();
+
+		CHECK(game1->getLuaState()->getProfilerSampleCount() > 0);
+		CHECK(0 == game2->getLuaState()->getProfilerSampleCount());
+
+		CHECK(game1->dumpLuaProfile().length() > 0);
+		CHECK(0 == game2->dumpLuaProfile().length());
+
+		game1->resetLuaProfiler();
+		CHECK(0 == game1->dumpLuaProfile().length());
+	}
+
+	TEST_CASE("LuaState (luastate.cpp): Game creates its Lua state lazily") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		CHECK(!game.hasLuaState());
+
+		// Inspecting the profiler or the entity pool shouldn't create the state
+		CHECK(0 == game.dumpLuaProfile().length());
+		CHECK(game.getEntityPoolOccupancy().empty());
+		game.stopLuaProfiler();
+		CHECK(!game.hasLuaState());
+
+		// A game that never used Lua serializes just like one with no scripts
+		auto data = game.serialize();
+		auto serializedLua = std::get<std::shared_ptr<trogdor::serial::Serializable>>(*data->get("lua"));
+
+		CHECK(0 == std::get<std::string>(*serializedLua->get("scripts")).length());
+		CHECK(!game.hasLuaState());
+
+		auto restored = trogdor::restoreGame(data);
+		CHECK(!restored->hasLuaState());
+
+		// First use creates the state, and loaded scripts survive serialization
+		game.getLuaState()->loadScriptFromString("function answer() return 42 end\n");
+		CHECK(game.hasLuaState());
+
+		auto restoredWithScripts = trogdor::restoreGame(game);
+		REQUIRE(restoredWithScripts->hasLuaState());
+
+		restoredWithScripts->getLuaState()->call("answer");
+		restoredWithScripts->getLuaState()->execute(1);
+		CHECK(42 == restoredWithScripts->getLuaState()->getNumber(0));
+	}
+
+	TEST_CASE("LuaState (luastate.cpp): Garbage collector configuration") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+
+		trogdor::LuaGCConfig config;
+
+		config.pause = 150;
+		config.stepMultiplier = 400;
+		config.idleStepping = true;
+
+		// Settings made before the state exists are applied when it's created
+		game.configureLuaGC(config);
+		CHECK(!game.hasLuaState());
+
+		CHECK(150 == game.getLuaState()->getGCConfig().pause);
+		CHECK(400 == game.getLuaState()->getGCConfig().stepMultiplier);
+		CHECK(game.getLuaState()->getGCConfig().idleStepping);
+
+		// Settings made afterward are applied immediately
+		config.pause = 100;
+		game.configureLuaGC(config);
+		CHECK(100 == game.getLuaState()->getGCConfig().pause);
+
+		trogdor::LuaGCConfig invalid;
+
+		invalid.pause = -1;
+		CHECK_THROWS(game.configureLuaGC(invalid));
+
+		invalid.pause = 200;
+		invalid.mode = trogdor::LUA_GC_MODE_GENERATIONAL;
+
+		if (trogdor::LuaState::supportsGenerationalGC()) {
+			CHECK_NOTHROW(game.configureLuaGC(invalid));
+			CHECK(trogdor::LUA_GC_MODE_GENERATIONAL == game.getLuaGCConfig().mode);
+		} else {
+			CHECK_THROWS(game.configureLuaGC(invalid));
+			CHECK(trogdor::LUA_GC_MODE_INCREMENTAL == game.getLuaGCConfig().mode);
+		}
+
+		// Idle stepping only happens when it's enabled
+		game.getLuaState()->loadScriptFromString(
+			"function makeGarbage()\n"
+			"   for i = 1, 10000 do local t = {i} end\n"
+			"end\n"
+		);
+
+		game.getLuaState()->call("makeGarbage");
+		game.getLuaState()->execute(0);
+
+		config.idleStepping = false;
+		game.configureLuaGC(config);
+		CHECK(0 == game.collectLuaGarbage(std::chrono::microseconds(100000)).count());
+
+		config.idleStepping = true;
+		game.configureLuaGC(config);
+		CHECK(game.collectLuaGarbage(std::chrono::microseconds(100000)) < std::chrono::microseconds(100000));
+	}
+
+	TEST_CASE("LuaState (luastate.cpp): Idle garbage collection waits for garbage") {
+
+		trogdor::Game game(std::make_unique<trogdor::NullErr>());
+		std::shared_ptr<trogdor::LuaState> L = game.getLuaState();
+
+		L->loadScriptFromString(
+			"kept = {}\n"
+			"function makeGarbage()\n"
+			"   for i = 1, 100000 do kept[i] = {i} end\n"
+			"end\n"
+		);
+
+		// The first call runs a whole cycle
+		CHECK(L->stepGC(std::chrono::seconds(10)) < std::chrono::seconds(10));
+
+		size_t nSteps = L->getNumGCSteps();
+		CHECK(nSteps > 0);
+
+		// After that, an idle state isn't collected again
+		for (int i = 0; i < 10; i++) {
+			CHECK(0 == L->stepGC(std::chrono::seconds(10)).count());
+		}
+
+		CHECK(nSteps == L->getNumGCSteps());
+
+		// Until its memory use grows past the pause
+		L->call("makeGarbage");
+		L->execute(0);
+
+		L->stepGC(std::chrono::seconds(10));
+		CHECK(L->getNumGCSteps() > nSteps);
+	}
 }
@@ -0,0 +1,87 @@
+#include <doctest.h>
+
+#include <trogdor/game.h>
+#include <trogdor/lua/luastate.h>
+#include <trogdor/lua/luatablebuilder.h>
+
+#include <trogdor/entities/object.h>
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+
+TEST_SUITE("LuaTableBuilder (luatablebuilder.cpp)") {
+
+	TEST_CASE("LuaTableBuilder (luatablebuilder.cpp): Fields, arrays and nested tables") {
+
+		std::unique_ptr<trogdor::Game> game = std::make_unique<trogdor::Game>(
+			std::make_unique<trogdor::NullErr>()
+		);
+
+		trogdor::entity::Object rock(
+			game.get(),
+			"rock",
+			std::make_unique<trogdor::NullOut>(),
+			std::make_unique<trogdor::NullErr>()
+		);
+
+		trogdor::LuaState L(game.get());
+
+		L.loadScriptFromString(
+			"function checkTable(t)\n"
+			"   if t.name ~= 'inventory' then return 1 end\n"
+			"   if t.weight ~= 12.5 or t.count ~= 3 or t.size ~= 4 then return 2 end\n"
+			"   if t.full ~= false then return 3 end\n"
+			"   if t.item:getName() ~= 'rock' then return 4 end\n"
+			"   if #t.items ~= 3 or t.items[1] ~= 'rock' or t.items[3] ~= 'sword' then return 5 end\n"
+			"   if #t.nested ~= 2 or t.nested[1].id ~= 1 or t.nested[2].id ~= 2 then return 6 end\n"
+			"   if t.afterNested ~= true then return 7 end\n"
+			"   if #t.legacy ~= 1 or t.legacy[1] ~= 'old' then return 8 end\n"
+			"   return 0\n"
+			"end\n"
+		);
+
+		L.call("checkTable");
+
+		trogdor::LuaTableBuilder t = L.pushTableArgument(0, 8);
+
+		t.setField("name", "inventory");
+		t.setField("weight", 12.5);
+		t.setField("count", 3);
+		t.setField("size", static_cast<size_t>(4));
+		t.setField("full", false);
+		t.setField("item", &rock);
+
+		trogdor::LuaTableBuilder items = t.beginTable("items", 3);
+
+		items.append(std::string("rock"));
+		items.append("stick");
+		items.append("sword");
+		items.end();
+
+		trogdor::LuaTableBuilder nested = t.beginTable("nested", 2);
+
+		for (int i = 1; i <= 2; i++) {
+			trogdor::LuaTableBuilder element = nested.appendTable(0, 1);
+			element.setField("id", i);
+			element.end();
+		}
+
+		nested.end();
+
+		// Calling end() twice shouldn't pop the parent table
+		nested.end();
+
+		t.setField("afterNested", true);
+
+		trogdor::LuaArray legacy;
+		legacy.push_back({trogdor::LUA_TYPE_STRING, std::string("old")});
+		t.setField("legacy", legacy);
+
+		// Ending a top-level table does nothing
+		t.end();
+
+		L.execute(1);
+		CHECK(0 == L.getNumber(0));
+	}
+}
@@ -0,0 +1,25 @@
+#include "mockgame.h"
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+namespace trogdor {
+
+
+	std::unique_ptr<Game> restoreGame(std::shared_ptr<serial::Serializable> data) {
+
+		return std::make_unique<Game>(
+			data,
+			std::make_unique<NullErr>(),
+			[] (Game *) {return std::make_unique<NullOut>();},
+			[] (Game *) {return std::make_unique<NullErr>();}
+		);
+	}
+
+	/************************************************************************/
+
+	std::unique_ptr<Game> restoreGame(Game &game) {
+
+		return restoreGame(game.serialize());
+	}
+}
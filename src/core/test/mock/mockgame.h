@@ -0,0 +1,28 @@
+#ifndef MOCK_GAME_H
+#define MOCK_GAME_H
+
+
+#include <memory>
+
+#include <trogdor/game.h>
+
+namespace trogdor {
+
+
+	/*
+		Deserializes a new Game whose streams are all nullout and nullerr.
+		The second version serializes the given Game first.
+
+		Input:
+			Serialized game (std::shared_ptr<serial::Serializable>) or Game
+			to copy (Game &)
+
+		Output:
+			The restored Game (std::unique_ptr<Game>)
+	*/
+	std::unique_ptr<Game> restoreGame(std::shared_ptr<serial::Serializable> data);
+	std::unique_ptr<Game> restoreGame(Game &game);
+}
+
+
+#endif // MOCK_GAME_H
@@ -0,0 +1,21 @@
+#include "mockroom.h"
+
+#include <trogdor/iostream/nullout.h>
+#include <trogdor/iostream/nullerr.h>
+
+namespace trogdor::entity {
+
+
+	std::shared_ptr<Room> makeMockRoom(Game &game, std::string name, bool insert) {
+
+		auto room = std::make_shared<Room>(
+			&game, name, std::make_unique<NullOut>(), std::make_unique<NullErr>()
+		);
+
+		if (insert) {
+			game.insertEntity(name, room);
+		}
+
+		return room;
+	}
+}
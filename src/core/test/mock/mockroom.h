@@ -0,0 +1,30 @@
+#ifndef MOCK_ROOM_H
+#define MOCK_ROOM_H
+
+
+#include <memory>
+#include <string>
+
+#include <trogdor/game.h>
+#include <trogdor/entities/room.h>
+
+namespace trogdor::entity {
+
+
+	/*
+		Creates a Room with nullout and nullerr streams and, unless told not
+		to, inserts it into the game under its own name.
+
+		Input:
+			Game the Room belongs to (Game &)
+			Room's name (std::string)
+			Whether to insert the Room into the game (bool, default true)
+
+		Output:
+			The new Room (std::shared_ptr<Room>)
+	*/
+	std::shared_ptr<Room> makeMockRoom(Game &game, std::string name, bool insert = true);
+}
+
+
+#endif // MOCK_ROOM_H
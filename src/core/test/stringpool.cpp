@@ -0,0 +1,65 @@
+#include <doctest.h>
+#include <trogdor/stringpool.h>
+#include <trogdor/messages.h>
+
+TEST_SUITE("StringPool (stringpool.cpp)") {
+
+	TEST_CASE("StringPool (stringpool.cpp): Equal strings are stored once") {
+
+		trogdor::StringPool &pool = trogdor::StringPool::get();
+		size_t initialSize = pool.size();
+
+		trogdor::PooledString a("A long description that many Entities share.");
+		trogdor::PooledString b(std::string("A long description that many Entities share."));
+		trogdor::PooledString c("Something else entirely.");
+
+		CHECK(initialSize + 2 == pool.size());
+		CHECK(a == b);
+		CHECK(a != c);
+		CHECK(a.view().data() == b.view().data());
+		CHECK(0 == a.str().compare("A long description that many Entities share."));
+
+		// Copies share the same string too
+		trogdor::PooledString d = c;
+		CHECK(c.view().data() == d.view().data());
+
+		// Strings are dropped from the pool once nothing refers to them
+		c = trogdor::PooledString();
+		CHECK(initialSize + 2 == pool.size());
+
+		d = trogdor::PooledString();
+		CHECK(initialSize + 1 == pool.size());
+
+		// And can be interned again afterward
+		trogdor::PooledString e("Something else entirely.");
+		CHECK(initialSize + 2 == pool.size());
+		CHECK(0 == e.view().compare("Something else entirely."));
+	}
+
+	TEST_CASE("StringPool (stringpool.cpp): Empty strings") {
+
+		trogdor::PooledString empty;
+		trogdor::PooledString alsoEmpty("");
+
+		CHECK(empty.empty());
+		CHECK(0 == empty.length());
+		CHECK(empty == alsoEmpty);
+		CHECK(0 == empty.str().compare(""));
+		CHECK(0 == empty.view().length());
+	}
+
+	TEST_CASE("StringPool (stringpool.cpp): Messages share pooled strings") {
+
+		trogdor::Messages msgs1;
+		trogdor::Messages msgs2;
+
+		msgs1.set("take", "You pick up the shiny thing.");
+		msgs2.set("take", "You pick up the shiny thing.");
+
+		CHECK(msgs1.get("take").data() == msgs2.get("take").data());
+
+		msgs2.set("take", "It's heavier than it looks.");
+		CHECK(0 == msgs1.get("take").compare("You pick up the shiny thing."));
+		CHECK(0 == msgs2.get("take").compare("It's heavier than it looks."));
+	}
+}
@@ -80,6 +80,41 @@ TEST_SUITE("Vocabulary (vocabulary.cpp)") {
 		CHECK(0 == vocabulary.getDirection("nonexistentDirection").compare(""));
 	}
 
+	TEST_CASE("Vocabulary (vocabulary.cpp): getDirectionId() and getDirectionName()") {
+
+		trogdor::Vocabulary vocabulary;
+
+		size_t nBuiltinDirections = vocabulary.getNumDirections();
+
+		CHECK(nBuiltinDirections == vocabulary.getDirections().size());
+
+		// Every direction has a unique ID that maps back to its name
+		for (size_t id = 0; id < nBuiltinDirections; id++) {
+
+			const std::string &direction = vocabulary.getDirectionName(id);
+
+			CHECK(vocabulary.isDirection(direction));
+			CHECK(vocabulary.getDirectionId(direction).has_value());
+			CHECK(id == *vocabulary.getDirectionId(direction));
+		}
+
+		// New directions get the next ID, and synonyms share their direction's
+		vocabulary.insertDirection("direction");
+		vocabulary.insertDirectionSynonym("synonym", "direction");
+
+		CHECK(nBuiltinDirections + 1 == vocabulary.getNumDirections());
+		CHECK(nBuiltinDirections == *vocabulary.getDirectionId("direction"));
+		CHECK(nBuiltinDirections == *vocabulary.getDirectionId("synonym"));
+		CHECK(*vocabulary.getDirectionId("n") == *vocabulary.getDirectionId("north"));
+
+		// Inserting a direction twice doesn't assign it a second ID
+		vocabulary.insertDirection("direction");
+		CHECK(nBuiltinDirections + 1 == vocabulary.getNumDirections());
+
+		CHECK(!vocabulary.getDirectionId("nonexistentDirection").has_value());
+		CHECK_THROWS(vocabulary.getDirectionName(vocabulary.getNumDirections()));
+	}
+
 	TEST_CASE("Vocabulary (vocabulary.cpp): insertFillerWord() and isFillerWord()") {
 
 		trogdor::Vocabulary vocabulary;
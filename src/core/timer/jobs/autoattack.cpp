@@ -49,7 +49,7 @@ namespace trogdor {
          return;
       }
 
-      else if (!defender->isTagSet(entity::Being::AttackableTag)) {
+      else if (!defender->isTagSet(entity::TAG_SLOT_ATTACKABLE)) {
          setExecutions(0);
          return;
       }
@@ -46,7 +46,7 @@ namespace trogdor {
 
    void WanderTimerJob::execute() {
 
-      if (!wanderer->getProperty<bool>(Creature::WanderEnabledProperty)) {
+      if (!wanderer->getProperty<bool>(PROPERTY_SLOT_WANDER_ENABLED)) {
          setExecutions(0);
          return;
       }
@@ -56,7 +56,7 @@ namespace trogdor {
       }
 
       // if wander interval ever changes, we should make sure it's updated
-      setInterval(wanderer->getProperty<int>(Creature::WanderIntervalProperty));
+      setInterval(wanderer->getProperty<int>(PROPERTY_SLOT_WANDER_INTERVAL));
    }
 
    /**************************************************************************/
@@ -156,6 +156,9 @@ namespace trogdor {
             mutex.unlock();
          }
       }
+
+      // Lua coroutines waiting on the clock are resumed after the jobs
+      game->resumeLuaCoroutines(time);
    }
 
 /******************************************************************************/
@@ -184,7 +187,16 @@ namespace trogdor {
                   lastTickTime = curTime;
                }
 
-               std::this_thread::sleep_for(jobThreadSleepTime);
+               // Give up to half of the idle time to Lua's garbage collector
+               // (if enabled), leaving the rest as a margin so the next tick
+               // isn't late
+               std::chrono::microseconds gcTime = game->collectLuaGarbage(
+                  std::chrono::duration_cast<std::chrono::microseconds>(jobThreadSleepTime) / 2
+               );
+
+               if (gcTime < jobThreadSleepTime) {
+                  std::this_thread::sleep_for(jobThreadSleepTime - gcTime);
+               }
             }
          });
 
@@ -1,3 +1,5 @@
+#include <cctype>
+
 #include <trogdor/utility.h>
 #include <trogdor/tokenizer.h>
 
@@ -8,15 +10,19 @@ namespace trogdor {
 
       trim(s);
 
-      if (s.length()) {
+      // Split on runs of whitespace. Since the string's already been trimmed,
+      // there are no empty tokens to worry about.
+      for (size_t i = 0; i < s.length(); ) {
 
-         std::regex re("\\s+");
-         std::sregex_token_iterator curToken(s.begin(), s.end(), re, -1);
-         std::sregex_token_iterator endOfTokens;
+         size_t tokenEnd = i;
 
-         for (; curToken != endOfTokens; ++curToken) {
-            tokens.push_back(curToken->str());
+         while (tokenEnd < s.length() && !std::isspace(static_cast<unsigned char>(s[tokenEnd]))) {
+            tokenEnd++;
          }
+
+         tokens.push_back(s.substr(i, tokenEnd - i));
+
+         for (i = tokenEnd; i < s.length() && std::isspace(static_cast<unsigned char>(s[i])); i++);
       }
 
       rewind();
@@ -68,20 +68,30 @@ namespace trogdor {
 
    /**************************************************************************/
 
+   void Vocabulary::addDirection(std::string dir) {
+
+      if (directions.insert(dir).second) {
+         directionIds[dir] = directionNames.size();
+         directionNames.push_back(std::move(dir));
+      }
+   }
+
+   /**************************************************************************/
+
    void Vocabulary::initBuiltinDirections() {
 
-      directions.insert("north");
-      directions.insert("south");
-      directions.insert("east");
-      directions.insert("west");
-      directions.insert("northeast");
-      directions.insert("northwest");
-      directions.insert("southeast");
-      directions.insert("southwest");
-      directions.insert("up");
-      directions.insert("down");
-      directions.insert("inside");
-      directions.insert("outside");
+      addDirection("north");
+      addDirection("south");
+      addDirection("east");
+      addDirection("west");
+      addDirection("northeast");
+      addDirection("northwest");
+      addDirection("southeast");
+      addDirection("southwest");
+      addDirection("up");
+      addDirection("down");
+      addDirection("inside");
+      addDirection("outside");
 
       directionSynonyms["n"]   = "north";
       directionSynonyms["s"]   = "south";